@@ -33,27 +33,34 @@
  *	assigned to the label, FALSE otherwise.
  */
 boolean set_label_here( id_record *label, segment_record *seg ) {
+	constant_value	value;
+
 	if( seg == NIL( segment_record )) {
 		log_error_s( "No segment set for label", label->id );
 		return( FALSE );
 	}
+	listing_label( label->id );
 	switch( label->type ) {
 		case class_unknown: {
 			label->type = class_label;
-			label->var.value.segment = seg;
-			label->var.value.value = seg->posn;
-			label->var.value.scope = scope_address;
+			value.segment = seg;
+			value.value = seg->posn;
+			value.scope = scope_address;
+			set_label_value( label, &value );
 			this_jiggle++;
 			return( TRUE );
 		}
 		case class_label: {
+			get_label_value( label, &value );
 
-			ASSERT( label->var.value.scope == scope_address );
+			ASSERT( value.scope == scope_address );
 
-			if( label->var.value.segment != seg ) break;
-			if( label->var.value.value != seg->posn ) {
-				if( BOOL( command_flags & more_verbose )) printf( "%s:%s %04x -> %04x\n", seg->name, label->id, label->var.value.value, seg->posn );
-				label->var.value.value = seg->posn;
+			if( value.segment != seg ) break;
+			if( value.value != seg->posn ) {
+				if( BOOL( command_flags & more_verbose )) fprintf( report_stream(), "%s:%s %04x -> %04x\n", seg->name, label->id, value.value, seg->posn );
+				if( BOOL( command_flags & report_convergence )) note_label_moved( label, value.value, seg->posn );
+				value.value = seg->posn;
+				set_label_value( label, &value );
 				this_jiggle++;
 			}
 			return( TRUE );
@@ -171,9 +178,9 @@ static boolean encode_ea( instruction *mc, ea_breakdown *reg, byte op_code, ea_b
 		 *	First format of the EA byte.
 		 */
 		DPRINT(( "Encode EA: reg =" ));
-		DCODE( show_ea_bitmap( reg->ea ));
+		DCODE( show_ea_bitmap( stdout, reg->ea ));
 		DPRINT(( ", EAdrs =" ));
-		DCODE( show_ea_bitmap( eadrs->ea ));
+		DCODE( show_ea_bitmap( stdout, eadrs->ea ));
 		DPRINT(( "\n" ));
 
 		ASSERT( BOOL( reg->ea & ea_all_reg ));
@@ -187,7 +194,7 @@ static boolean encode_ea( instruction *mc, ea_breakdown *reg, byte op_code, ea_b
 		 */
 		DPRINT(( "Encode EA: opcode = %d", op_code ));
 		DPRINT(( ", EAdrs =" ));
-		DCODE( show_ea_bitmap( eadrs->ea ));
+		DCODE( show_ea_bitmap( stdout, eadrs->ea ));
 		DPRINT(( "\n" ));
 
 		ASSERT( op_code <= B111 );
@@ -356,7 +363,7 @@ static boolean encode_ids( instruction *mc, ea_breakdown *arg ) {
 	ASSERT( arg != NIL( ea_breakdown ));
 
 	DPRINT(( "Encode IDS for EA" ));
-	DCODE( show_ea_bitmap( arg->ea ));
+	DCODE( show_ea_bitmap( stdout, arg->ea ));
 	DPRINT(( "\n" ));
 
 	if( BOOL( arg->ea & ea_all_reg )) {
@@ -364,7 +371,7 @@ static boolean encode_ids( instruction *mc, ea_breakdown *arg ) {
 		ASSERT( arg->registers == 1 );
 
 		DPRINT(( "Register components" ));
-		DCODE( show_ac_bitmap( arg->reg[ 0 ]->ac ));
+		DCODE( show_ac_bitmap( stdout, arg->reg[ 0 ]->ac ));
 		DPRINT(( "\n" ));
 
 		if( arg->mod != no_modifier ) {
@@ -390,6 +397,82 @@ static boolean encode_ids( instruction *mc, ea_breakdown *arg ) {
  *	Handle the conversion from label based addresses to
  *	relative (to IP) based distances.
  */
+/*
+ *	The only instructions limited to a signed byte displacement
+ *	are the conditional jumps and the loop and jcxz family.  With
+ *	"--expand-branches" one which cannot reach its target is
+ *	rewritten around a near jump:
+ *
+ *		jz	far_away	->	jnz	$+5
+ *						jmp	near far_away
+ *
+ *		loop	far_away	->	loop	$+4
+ *						jmp	short $+5
+ *						jmp	near far_away
+ *
+ *	The conditional jumps are inverted by flipping the low bit
+ *	of the opcode (index i in the code), the rest have no inverse
+ *	so branch onto the near jump with a short jump skipping it.
+ *
+ *	As every branch starts short (the label gathering pass), and
+ *	only grows as the distances grow, the value confirmation
+ *	passes settle on the smallest code which reaches.
+ */
+static boolean expand_branch( instruction *mc, constant_value *v, byte i ) {
+	integer	d;
+
+	ASSERT( i < mc->coded );
+
+	if(( mc->code[ i ] & 0xF0 ) == 0x70 ) {
+		ASSERT( mc->coded <= MAX_CODE_BYTES - 4 );
+
+		mc->code[ i ] ^= 1;
+		mc->code[ mc->coded++ ] = 3;
+	}
+	else {
+		ASSERT( mc->coded <= MAX_CODE_BYTES - 6 );
+
+		mc->code[ mc->coded++ ] = 2;
+		mc->code[ mc->coded++ ] = 0xEB;
+		mc->code[ mc->coded++ ] = 3;
+	}
+	mc->code[ mc->coded++ ] = 0xE9;
+
+	d = v->value - ( this_segment->posn + mc->coded + sizeof( word ));
+
+	DPRINT(( "Expanded word displacement is %d.\n", (int)d ));
+
+	if( !BOOL( get_scope( d ) & scope_sword )) {
+		log_error_i( "Displacement out of range (signed word)", d );
+		return( FALSE );
+	}
+	mc->code[ mc->coded++ ] = L( d );
+	mc->code[ mc->coded++ ] = H( d );
+	mc->expanded = TRUE;
+	this_expanded++;
+	return( TRUE );
+}
+
+/*
+ *	Describe an expanded branch in the listing.  The conditional
+ *	jumps are named by the (inverted) opcode used.
+ */
+static void note_expansion( component op, instruction *mc, integer target ) {
+	static const char *condition[ 16 ] = {
+		"jo", "jno", "jb", "jnb", "jz", "jnz", "jbe", "ja",
+		"js", "jns", "jp", "jnp", "jl", "jge", "jle", "jg"
+	};
+	char	note[ LISTING_NOTE_SIZE ];
+
+	if(( mc->code[ 0 ] & 0xF0 ) == 0x70 ) {
+		snprintf( note, LISTING_NOTE_SIZE, "%s expanded: %s $+5, jmp near 0x%04X", component_text( op ), condition[ mc->code[ 0 ] & 0x0F ], (unsigned int)( target & 0xFFFF ));
+	}
+	else {
+		snprintf( note, LISTING_NOTE_SIZE, "%s expanded: %s $+4, jmp short $+5, jmp near 0x%04X", component_text( op ), component_text( op ), (unsigned int)( target & 0xFFFF ));
+	}
+	listing_note( note );
+}
+
 static boolean encode_rel( instruction *mc, constant_value *v, byte w, byte i, byte b ) {
 	integer	d;
 	
@@ -483,6 +566,7 @@ static boolean encode_rel( instruction *mc, constant_value *v, byte w, byte i, b
 			 *	signed byte or signed word will fall through to
 			 *	the work encoding.
 			 */
+			if( BOOL( command_flags & expand_branches )) return( expand_branch( mc, v, i ));
 			log_error_i( "Displacement out of range (signed byte)", d );
 			return( FALSE );
 		}
@@ -727,6 +811,33 @@ static boolean encode_imm( instruction *mc, constant_value *v ) {
 	return( TRUE );
 }
 
+/*
+ *	Encode a word immediate as the single byte the CPU will
+ *	sign extend back to it.  Returns FALSE, without an error,
+ *	where this is not possible so that the full width form can
+ *	be used instead.
+ */
+static boolean encode_sxi( instruction *mc, constant_value *v ) {
+	ASSERT( mc != NIL( instruction ));
+	ASSERT( v != NIL( constant_value ));
+
+	if( !mc->word_data ) return( FALSE );
+	/*
+	 *	An address may yet move, so is left at full width.  The
+	 *	same test is applied when verifying the tables, so only
+	 *	the values which fit are shown in this form.
+	 */
+	if( BOOL( v->scope & scope_address )) return( FALSE );
+	if( !BOOL( v->scope & scope_sbyte )&&(( v->value < 0xFF80 )||( v->value > 0xFFFF ))) return( FALSE );
+
+	ASSERT(( mc->coded + sizeof( byte )) <= MAX_CODE_BYTES );
+
+	DPRINT(( "Sign extended immediate byte = %02x\n", v->value & 0xFF ));
+
+	mc->code[ mc->coded++ ] = v->value;
+	return( TRUE );
+}
+
 /*
  *	Confirm that the size of the argument provided is compatible
  *	with the size data already gathered in the instruction data.
@@ -787,7 +898,7 @@ static boolean perform_vds( instruction *mc, ea_breakdown *arg ) {
 		}
 		default: {
 			DPRINT(( "Unrecognised EA" ));
-			DCODE( show_ea_bitmap( arg->ea ));
+			DCODE( show_ea_bitmap( stdout, arg->ea ));
 			DPRINT(( "\n" ));
 			ABORT( "Programmer error" );
 			break;
@@ -819,7 +930,7 @@ boolean assemble_inst( opcode *inst, opcode_prefix prefs, ea_breakdown *arg, ins
 	ASSERT( arg != NIL( ea_breakdown ));
 	
 	DPRINT(( "Assemble op '%s (%d args)", component_text( inst->op ), inst->args ));
-	DCODE( for( int a = 0; a < inst->args; a++ ) show_ea_bitmap( inst->arg[ a ] ));
+	DCODE( for( int a = 0; a < inst->args; a++ ) show_ea_bitmap( stdout, inst->arg[ a ] ));
 	DPRINT(( "'\n" ));
 
 	/*
@@ -842,6 +953,7 @@ boolean assemble_inst( opcode *inst, opcode_prefix prefs, ea_breakdown *arg, ins
 	mc->unsigned_data = FALSE;
 	mc->signed_data = FALSE;
 	mc->reg_is_dest = TRUE;
+	mc->expanded = FALSE;
 	/*
 	 *	Step through the encoding instructions.
 	 */
@@ -879,7 +991,6 @@ boolean assemble_inst( opcode *inst, opcode_prefix prefs, ea_breakdown *arg, ins
 			}
 			case EAO_ACT: {
 				ASSERT( EAO_EADRS( e ) < inst->args );
-				ASSERT( EAO_EADRS( e ) != EA_REG( e ));
 				
 				DPRINT(( "Effective Address Opcode (OP:%d, EAdrs @ %d).\n", EAO_OPCODE( e ), EAO_EADRS( e )));
 
@@ -895,6 +1006,15 @@ boolean assemble_inst( opcode *inst, opcode_prefix prefs, ea_breakdown *arg, ins
 				if( !encode_imm( mc, &( arg[ IMM_ARG( e )].immediate_arg ))) return( FALSE );
 				break;
 			}
+			case SXI_ACT: {
+				ASSERT( SXI_ARG( e ) < inst->args );
+				ASSERT( BOOL( arg[ SXI_ARG( e )].ea & ea_immediate ));
+
+				DPRINT(( "Sign extended immediate value (arg %d).\n", SXI_ARG( e )+1 ));
+
+				if( !encode_sxi( mc, &( arg[ SXI_ARG( e )].immediate_arg ))) return( FALSE );
+				break;
+			}
 			case IDS_ACT: {
 				/*
 				 *	Identify Data Size.
@@ -1153,22 +1273,79 @@ static effective_address convert_ac( arg_component ac, boolean has_far ) {
 	ac_conversion	*look;
 
 	DPRINT(( "Convert AC" ));
-	DCODE( show_ac_bitmap( ac ));
+	DCODE( show_ac_bitmap( stdout, ac ));
 	DPRINT(( "\n" ));
 
 	for( look = convert_ac_to_ea; look->ac != ac_empty; look++ ) if(( ac & look->ac ) == look->ac ) break;
 
 	DPRINT(( "To EA" ));
-	DCODE( show_ea_bitmap( look->ea ));
+	DCODE( show_ea_bitmap( stdout, look->ea ));
 	DPRINT(( "\n" ));
 
 	return( has_far? look->far_ea: look->ea );
 }
 
+/*
+ *	Return the bytes an assembled instruction will occupy,
+ *	including its prefixes.
+ */
+static int encoded_size( instruction *mc ) {
+	byte	prefix[ MAX_PREFIX_BYTES ];
+	int	p;
+
+	if(( p = encode_prefix_bytes( mc->prefixes, prefix, MAX_PREFIX_BYTES )) == ERROR ) p = 0;
+	return( p + mc->coded );
+}
+
+/*
+ *	Try each of the remaining definitions which match the
+ *	arguments, replacing the instruction given (assembled from
+ *	the first match) with any encoding which is shorter.  The
+ *	first of the shortest is kept so, as with the sizes of
+ *	displacements, the choice only changes between passes if
+ *	the values do.
+ */
+static opcode *shortest_form( opcode *first, opcode_prefix prefs, modifier mods, component op, int args, ea_breakdown *format, instruction *mc ) {
+	opcode		*best,
+			*look;
+	instruction	trial;
+	boolean		was;
+	int		size,
+			found;
+
+	best = first;
+	size = found = encoded_size( mc );
+	was = quiet_errors( TRUE );
+	for( look = next_opcode( first, mods, op, args, format ); look; look = next_opcode( look, mods, op, args, format )) {
+		if( assemble_inst( look, prefs, format, &trial )&&( encoded_size( &trial ) < size )) {
+			best = look;
+			*mc = trial;
+			size = encoded_size( mc );
+		}
+	}
+	(void)quiet_errors( was );
+	if( best != first ) {
+		pass_stats.shortened++;
+		pass_stats.saved += found - size;
+	}
+	return( best );
+}
+
 /*
  *	Conversion of an opcode and a series of arguments into
  *	a recognised assembly instruction.
  */
+#ifdef VERIFICATION
+/*
+ *	The routine shown each instruction identified.
+ */
+static THREAD_LOCAL opcode_observer observer = NIL( void );
+
+void observe_opcodes( opcode_observer watch ) {
+	observer = watch;
+}
+#endif
+
 boolean process_opcode( opcode_prefix prefs, modifier mods, component op, int args, token_record **arg, int *len ) {
 	ea_breakdown	*format,
 			*fill;
@@ -1291,7 +1468,7 @@ boolean process_opcode( opcode_prefix prefs, modifier mods, component op, int ar
 
 					DPRINT(( "Recognised register '%s'\n", component_text( look->id )));
 					DPRINT(( "Register components" ));
-					DCODE( show_ac_bitmap( rd->ac ));
+					DCODE( show_ac_bitmap( stdout, rd->ac ));
 					DPRINT(( "\n" ));
 
 					/*
@@ -1336,7 +1513,7 @@ boolean process_opcode( opcode_prefix prefs, modifier mods, component op, int ar
 						return( FALSE );
 					}
 					ac |= ac_seg_override;
-					fill->segment_override = look->var.label->var.segment->seg_reg;
+					fill->segment_override = label_segment( look->var.label )->seg_reg;
 					left--;
 					look = look->next;
 					if( look->id != tok_colon ) {
@@ -1375,7 +1552,7 @@ boolean process_opcode( opcode_prefix prefs, modifier mods, component op, int ar
 		}
 
 		DPRINT(( "Arg %d =", a ));
-		DCODE( show_ac_bitmap( ac ));
+		DCODE( show_ac_bitmap( stdout, ac ));
 		DPRINT(( "\n" ));
 
 		/*
@@ -1401,8 +1578,40 @@ boolean process_opcode( opcode_prefix prefs, modifier mods, component op, int ar
 	 */
 	if(( search = find_opcode( mods, op, args, format ))) {
 		instruction mc;
+
+#ifdef VERIFICATION
+		if( observer ) (*observer)( search, prefs, mods, op, args, format );
+#endif
 				
 		if( !assemble_inst( search, prefs, format, &mc )) return( FALSE );
+		/*
+		 *	Other forms may encode the same instruction in
+		 *	fewer bytes, once the values are known.
+		 */
+		if( BOOL( command_flags & optimize_size )&&( this_pass != pass_label_gathering )) {
+			search = shortest_form( search, prefs, mods, op, args, format, &mc );
+		}
+		/*
+		 *	Branches expanded to reach their targets are
+		 *	counted and noted in the listing.
+		 */
+		if( mc.expanded &&( this_pass == pass_code_generation )&&( this_segment == codegen_segment )) {
+			pass_stats.expanded++;
+			note_expansion( op, &mc, format[ 0 ].immediate_arg.value );
+		}
+		/*
+		 *	The listing shows the clocks the instruction is
+		 *	expected to take.
+		 */
+		if( BOOL( command_flags & list_clocks )&&( this_pass == pass_code_generation )) {
+			clock_estimate	est;
+			char		text[ LISTING_CLOCK_COLS ];
+
+			if( estimate_clocks( search, format, &mc, &est )) {
+				(void)format_clocks( &est, text, LISTING_CLOCK_COLS );
+				listing_clocks( text, est.clocks, est.per_count );
+			}
+		}
 		return( generate_inst( &mc ));
 	}
 	/*
@@ -42,7 +42,8 @@ typedef struct {
 			far_data,			/* addresses in the CODE stack are implied */
 			signed_data,
 			unsigned_data,
-			reg_is_dest;
+			reg_is_dest,
+			expanded;			/* Short branch rewritten to reach its target */
 } instruction;
 
 
@@ -72,6 +73,20 @@ extern boolean assemble_inst( opcode *inst, opcode_prefix prefs, ea_breakdown *a
  */
 extern boolean process_opcode( opcode_prefix prefs, modifier mods, component op, int args, token_record **arg, int *len );
 
+#ifdef VERIFICATION
+
+/*
+ *	A routine to be shown each instruction identified by
+ *	process_opcode() (on the current thread) before it is
+ *	assembled; used to capture realistic input for the
+ *	micro-benchmarks.  Set to NIL to stop.
+ */
+typedef void FUNC( opcode_observer )( opcode *inst, opcode_prefix prefs, modifier mods, component op, int args, ea_breakdown *format );
+
+extern void observe_opcodes( opcode_observer watch );
+
+#endif
+
 #endif
 
 /*
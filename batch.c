@@ -0,0 +1,258 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	batch
+ *	=====
+ *
+ *	Assembly of many source files on a pool of worker threads.
+ *
+ *	The workers take the next file from the list, assemble it in
+ *	a new context (with the errors and the report output, that is
+ *	--stats, --verbose and --run, captured in memory) and mark it
+ *	done.  The main thread waits for each file in turn and writes
+ *	out its report and diagnostics so the output is the same as
+ *	assembling the files one after the other.
+ *
+ *	The opcode, keyword and symbol tables are static read only
+ *	data and are shared by all of the workers as they stand.
+ */
+ 
+#define MEMORY_TAG	memory_source
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The details of one file.
+ */
+typedef struct {
+	char		*name;
+	int		status;
+	boolean		done;
+	char		*diagnostics,
+			*output;
+	size_t		size,
+			output_size;
+} batch_job;
+
+/*
+ *	The details of the batch, shared by all workers.
+ */
+typedef struct {
+	pthread_mutex_t		lock;
+	pthread_cond_t		finished;
+	batch_job		*job;
+	int			files,
+				next;
+	command_flag		flags;
+	mnemonic_flags		parameters;
+	batch_assembler		assemble;
+} batch_state;
+
+/*
+ *	Add a name to a growing list of names.
+ */
+static char **add_source( char **list, int *files, int *size, char *name ) {
+	if( *files == *size ) {
+		*size = *size? *size*2: 64;
+		list = RESIZE_ARRAY( list, char *, *size );
+	}
+	list[ (*files)++ ] = name;
+	return( list );
+}
+
+/*
+ *	Expand the list of source file arguments.
+ */
+char **gather_sources( int count, char *arg[], int *files ) {
+	char	**list,
+		word[ MAX_LINE_SIZE+1 ],
+		format[ MAX_CONST_SIZE ];
+	FILE	*from;
+	int	i, c, size;
+
+	sprintf( format, "%%%ds", MAX_LINE_SIZE );
+	list = NIL( char * );
+	*files = size = 0;
+	for( i = 0; i < count; i++ ) {
+		if( arg[ i ][ 0 ] != AT ) {
+			list = add_source( list, files, &size, arg[ i ]);
+			continue;
+		}
+		if(( from = fopen( arg[ i ]+1, "r" )) == NIL( FILE )) {
+			log_error_s( "Unable to read response file", arg[ i ]+1 );
+			release_sources( list, *files, count, arg );
+			return( NIL( char * ));
+		}
+		while( fscanf( from, format, word ) == 1 ) {
+			/*
+			 *	A name filling the buffer which is not followed
+			 *	by white space was longer than the buffer.
+			 */
+			if(( strlen( word ) == MAX_LINE_SIZE )&&(( c = fgetc( from )) != EOF )) {
+				if( !isspace( c )) {
+					log_error_s( "Source name too long in response file", arg[ i ]+1 );
+					fclose( from );
+					release_sources( list, *files, count, arg );
+					return( NIL( char * ));
+				}
+				ungetc( c, from );
+			}
+			list = add_source( list, files, &size, NEW_STRING( word ));
+		}
+		fclose( from );
+	}
+	return( list );
+}
+
+/*
+ *	Release the list, and those names not taken directly from
+ *	the arguments.
+ */
+void release_sources( char **list, int files, int count, char *arg[] ) {
+	int	i, j;
+
+	if( list == NIL( char * )) return;
+	for( i = 0; i < files; i++ ) {
+		for( j = 0; ( j < count )&&( arg[ j ] != list[ i ]); j++ );
+		if( j == count ) FREE( list[ i ]);
+	}
+	FREE( list );
+}
+
+/*
+ *	A worker thread.
+ */
+static void *batch_worker( void *data ) {
+	batch_state		*batch = (batch_state *)data;
+	assembler_context	*context;
+	batch_job		*job;
+	FILE			*errors,
+				*output;
+	int			i;
+
+	while( TRUE ) {
+		pthread_mutex_lock( &( batch->lock ));
+		i = batch->next++;
+		pthread_mutex_unlock( &( batch->lock ));
+		if( i >= batch->files ) break;
+
+		job = &( batch->job[ i ]);
+		context = new_context();
+		(void)select_context( context );
+		command_flags = batch->flags;
+		assembler_parameters = batch->parameters;
+		if(( errors = open_memstream( &( job->diagnostics ), &( job->size )))) set_error_stream( errors );
+		if(( output = open_memstream( &( job->output ), &( job->output_size )))) set_report_stream( output );
+		job->status = FUNC( batch->assemble )( job->name );
+		delete_context( context );
+		if( errors ) fclose( errors );
+		if( output ) fclose( output );
+
+		pthread_mutex_lock( &( batch->lock ));
+		job->done = TRUE;
+		pthread_cond_broadcast( &( batch->finished ));
+		pthread_mutex_unlock( &( batch->lock ));
+	}
+	return( NIL( void ));
+}
+
+/*
+ *	Assemble each of the source files.
+ */
+int assemble_batch( int files, char *name[], int workers, batch_assembler assemble ) {
+	batch_state	batch;
+	pthread_t	*thread;
+	int		i, status;
+
+	ASSERT( files > 0 );
+
+	if( workers < 1 ) workers = 1;
+	if( workers > files ) workers = files;
+
+	pthread_mutex_init( &( batch.lock ), NULL );
+	pthread_cond_init( &( batch.finished ), NULL );
+	batch.job = NEW_ARRAY( batch_job, files );
+	for( i = 0; i < files; i++ ) {
+		batch.job[ i ].name = name[ i ];
+		batch.job[ i ].status = 0;
+		batch.job[ i ].done = FALSE;
+		batch.job[ i ].diagnostics = NIL( char );
+		batch.job[ i ].size = 0;
+		batch.job[ i ].output = NIL( char );
+		batch.job[ i ].output_size = 0;
+	}
+	batch.files = files;
+	batch.next = 0;
+	batch.flags = command_flags;
+	batch.parameters = assembler_parameters;
+	batch.assemble = assemble;
+
+	thread = NEW_ARRAY( pthread_t, workers );
+	for( i = 0; i < workers; i++ ) {
+		if( pthread_create( &( thread[ i ]), NULL, batch_worker, &batch ) != 0 ) {
+			log_error_i( "Unable to start worker thread", i );
+			break;
+		}
+	}
+	if(( workers = i ) == 0 ) {
+		/*
+		 *	No threads at all; do the work ourselves.
+		 */
+		assembler_context	*previous = this_context;
+
+		(void)batch_worker( &batch );
+		(void)select_context( previous );
+	}
+	/*
+	 *	Report the results in order.
+	 */
+	status = 0;
+	for( i = 0; i < files; i++ ) {
+		batch_job	*job = &( batch.job[ i ]);
+
+		pthread_mutex_lock( &( batch.lock ));
+		while( !job->done ) pthread_cond_wait( &( batch.finished ), &( batch.lock ));
+		pthread_mutex_unlock( &( batch.lock ));
+		if( job->output ) {
+			fwrite( job->output, 1, job->output_size, report_stream());
+			fflush( report_stream());
+			free( job->output );		/* From open_memstream() */
+		}
+		if( job->diagnostics ) {
+			if( job->size ) {
+				fprintf( error_stream(), "%s:\n", job->name );
+				log_text( job->diagnostics, job->size );
+			}
+			free( job->diagnostics );	/* From open_memstream() */
+		}
+		if( job->status > status ) status = job->status;
+	}
+	for( i = 0; i < workers; i++ ) pthread_join( thread[ i ], NULL );
+	FREE( thread );
+	FREE( batch.job );
+	pthread_cond_destroy( &( batch.finished ));
+	pthread_mutex_destroy( &( batch.lock ));
+	return( status );
+}
+
+
+/*
+ *	EOF
+ */
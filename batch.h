@@ -0,0 +1,65 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	batch
+ *	=====
+ *
+ *	Assembly of many source files on a pool of worker threads.
+ */
+ 
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+/*
+ *	The routine which assembles a single source file in the
+ *	current context, returning the exit status for the file.
+ */
+typedef int FUNC( batch_assembler )( char *name );
+
+/*
+ *	Expand the list of source file arguments; any argument
+ *	starting '@' names a response file listing further source
+ *	files (separated by white space, each no longer than
+ *	MAX_LINE_SIZE).  Returns NIL on error.
+ */
+extern char **gather_sources( int count, char *arg[], int *files );
+
+/*
+ *	Release a list returned by gather_sources() (given the same
+ *	arguments) along with the names read from response files.
+ */
+extern void release_sources( char **list, int files, int count, char *arg[] );
+
+/*
+ *	Assemble each of the source files using the number of
+ *	worker threads given.  Each file is assembled in its own
+ *	context using the flags of the current context, and the
+ *	report output and diagnostics for each file are written
+ *	together, in the order the files were given.  Returns the highest exit
+ *	status of all the files.
+ */
+extern int assemble_batch( int files, char *name[], int workers, batch_assembler assemble );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,474 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	benchmark
+ *	=========
+ *
+ *	Routines associated with the extended verification mode to
+ *	generate synthetic assembly language source files and to
+ *	measure the assembler's performance on them.
+ *
+ *	The generated source is entirely determined by the scenario
+ *	(including its random number seed) so results from separate
+ *	runs, or separate versions of the assembler, are comparable.
+ *	Each assembly is run in a child process so that the peak
+ *	memory use reported belongs to that assembly alone.
+ *
+ *	The results are written one scenario per line:
+ *
+ *		scenario lines passes usec lines/second peak-rss-kb result
+ *
+ *	with the best (shortest) time of the repeated runs.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+#ifdef VERIFICATION
+
+/*
+ *	The built in scenarios.
+ */
+static bench_scenario scenarios[] = {
+	/*	name		lines	labels	locals	forward	segs	depth	tables	seed */
+	{ "small",		2000,	10,	30,	10,	1,	0,	256,	1 },
+	{ "medium",		10000,	10,	30,	10,	2,	1,	4096,	2 },
+	{ "labels",		10000,	40,	20,	10,	2,	1,	0,	3 },
+	{ "locals",		10000,	25,	80,	10,	2,	1,	0,	4 },
+	{ "branches",		10000,	10,	30,	40,	2,	1,	0,	5 },
+	{ "segments",		10000,	10,	30,	10,	16,	1,	1024,	6 },
+	{ "includes",		10000,	10,	30,	10,	2,	6,	1024,	7 },
+	{ "tables",		4000,	5,	30,	5,	1,	1,	32768,	8 },
+	{ NIL( char ) }
+};
+
+/*
+ *	The number of constants defined in each included file,
+ *	and the number of values on each line of a DB table.
+ */
+#define BENCH_CONSTANTS		32
+#define BENCH_TABLE_WIDTH	16
+
+/*
+ *	The furthest (in lines) a branch may go forward, and the
+ *	furthest a short (conditional) branch or a local label
+ *	reference may reach.
+ */
+#define BENCH_FORWARD		40
+#define BENCH_SHORT		10
+
+/*
+ *	A simple, portable, random number generator so the same
+ *	scenario always generates the same source.
+ */
+static unsigned int bench_random( unsigned int *seed ) {
+	*seed = *seed * 1103515245 + 12345;
+	return(( *seed >> 8 ) & 0xffffff );
+}
+
+/*
+ *	Find a scenario.
+ */
+boolean find_scenario( char *text, bench_scenario *scenario ) {
+	static char	*keys[] = { "lines", "labels", "locals", "forward", "segments", "depth", "tables", "seed", NIL( char ) };
+	char		*copy,
+			*item,
+			*value,
+			*save;
+	int		i;
+
+	for( i = 0; scenarios[ i ].name != NIL( char ); i++ ) {
+		if( strcmp( scenarios[ i ].name, text ) == 0 ) {
+			*scenario = scenarios[ i ];
+			return( TRUE );
+		}
+	}
+	*scenario = scenarios[ 1 ];
+	scenario->name = "custom";
+	copy = NEW_STRING( text );
+	for( item = strtok_r( copy, ",", &save ); item; item = strtok_r( NIL( char ), ",", &save )) {
+		if(( value = strchr( item, '=' )) == NIL( char )) {
+			log_error_s( "Unrecognised benchmark scenario", item );
+			FREE( copy );
+			return( FALSE );
+		}
+		*value++ = EOS;
+		for( i = 0; keys[ i ] != NIL( char ); i++ ) if( strcmp( keys[ i ], item ) == 0 ) break;
+		switch( i ) {
+			case 0: scenario->lines = atoi( value );		break;
+			case 1: scenario->labels = atoi( value );		break;
+			case 2: scenario->locals = atoi( value );		break;
+			case 3: scenario->forward = atoi( value );		break;
+			case 4: scenario->segments = atoi( value );		break;
+			case 5: scenario->depth = atoi( value );		break;
+			case 6: scenario->tables = atoi( value );		break;
+			case 7: scenario->seed = (unsigned int)atol( value );	break;
+			default: {
+				log_error_s( "Unrecognised benchmark setting", item );
+				FREE( copy );
+				return( FALSE );
+			}
+		}
+	}
+	FREE( copy );
+	if( scenario->segments < 1 ) scenario->segments = 1;
+	if( scenario->depth < 0 ) scenario->depth = 0;
+	return( TRUE );
+}
+
+/*
+ *	Form the name of the n'th included file.
+ */
+static char *include_name( char *buffer, char *name, int n ) {
+	char	*t;
+
+	strcpy( buffer, name );
+	if(( t = strrchr( buffer, PERIOD ))) *t = EOS;
+	sprintf( buffer + strlen( buffer ), "_%d.inc", n );
+	return( buffer );
+}
+
+/*
+ *	Write the chain of included files, returning the lines
+ *	written or ERROR.
+ */
+static int generate_includes( char *name, bench_scenario *scenario ) {
+	char	*file,
+		*next;
+	FILE	*to;
+	int	d, i, lines;
+
+	file = STACK_ARRAY( char, strlen( name ) + MAX_CONST_SIZE );
+	next = STACK_ARRAY( char, strlen( name ) + MAX_CONST_SIZE );
+	lines = 0;
+	for( d = 1; d <= scenario->depth; d++ ) {
+		if(( to = fopen( include_name( file, name, d ), "w" )) == NIL( FILE )) {
+			log_error_s( "Unable to create file", file );
+			return( ERROR );
+		}
+		fprintf( to, "; Synthetic include file %d of %d\n", d, scenario->depth );
+		for( i = 0; i < BENCH_CONSTANTS; i++ ) fprintf( to, "K%d_%d\tequ\t%d\n", d, i, ( d * 1000 + i * 7 ) & 0x7fff );
+		lines += BENCH_CONSTANTS + 1;
+		if( d < scenario->depth ) {
+			/*
+			 *	Only the base name is used, the files are
+			 *	all in the same directory.
+			 */
+			char	*base;
+
+			(void)include_name( next, name, d+1 );
+			base = (( base = strrchr( next, '/' )))? base+1: next;
+			fprintf( to, "\tinclude\t\"%s\"\n", base );
+			lines++;
+		}
+		fclose( to );
+	}
+	return( lines );
+}
+
+/*
+ *	Write the code of a single segment, returning the lines
+ *	written.
+ */
+static int generate_segment( FILE *to, bench_scenario *scenario, int seg, int count, unsigned int *seed, int tables ) {
+	static char	*simple[] = {
+				"inc\tax", "dec\tcx", "add\tax,bx", "sub\tdx,ax", "push\tax", "pop\tbx",
+				"mov\tsi,di", "xor\tax,ax", "cmp\tax,10", "nop", "shl\tax,1", "or\tdx,4"
+			};
+	int		*pending,		/* Line each forward label is due on */
+			pendings,
+			global,			/* Number of the last global label */
+			local,			/* Line of the last local label in scope */
+			lines, n, i, r;
+
+	pending = NEW_ARRAY( int, BENCH_FORWARD * 2 + count );
+	pendings = 0;
+	global = ERROR;
+	local = ERROR;
+	lines = 0;
+	fprintf( to, "\n\tsegment\tc%d\n", seg );
+	lines += 2;
+	if( seg == 0 ) {
+		fprintf( to, "\torg\t100h\nstart:\tnop\n" );
+		lines += 2;
+	}
+	for( n = 0; n < count; n++ ) {
+		/*
+		 *	Forward labels which are now due.
+		 */
+		for( i = 0; i < pendings; i++ ) {
+			if( pending[ i ] <= n ) {
+				fprintf( to, "f%d_%d:\n", seg, i );
+				pending[ i ] = count + BENCH_FORWARD * 2;
+				local = ERROR;
+				lines++;
+			}
+		}
+		/*
+		 *	The label, if any, for this line.
+		 */
+		if(( int )( bench_random( seed ) % 100 ) < scenario->labels ) {
+			if(( global != ERROR )&&(( int )( bench_random( seed ) % 100 ) < scenario->locals )) {
+				fprintf( to, ".l%d:", n );
+				local = n;
+			}
+			else {
+				fprintf( to, "g%d_%d:", seg, n );
+				global = n;
+				local = ERROR;
+			}
+		}
+		/*
+		 *	The instruction.
+		 */
+		r = bench_random( seed ) % 100;
+		if(( r < scenario->forward )&&( n + 1 < count )) {
+			int	d = 1 + bench_random( seed ) % BENCH_FORWARD;
+
+			if( n + d >= count ) d = count - n - 1;
+			pending[ pendings ] = n + d;
+			fprintf( to, "\t%s\tf%d_%d\n", ( d <= BENCH_SHORT )? "jnz": "jmp", seg, pendings );
+			pendings++;
+		}
+		else if(( local != ERROR )&&( n - local <= BENCH_SHORT )&&( r < scenario->forward + 10 )) {
+			fprintf( to, "\t%s\t.l%d\n", ( r & 1 )? "loop": "jnz", local );
+		}
+		else if(( global != ERROR )&&( r >= 95 )) {
+			fprintf( to, "\tcall\tg%d_%d\n", seg, global );
+		}
+		else if(( scenario->depth > 0 )&&( r >= 90 )) {
+			fprintf( to, "\tmov\tbx,K%d_%d\n", 1 + bench_random( seed ) % scenario->depth, bench_random( seed ) % BENCH_CONSTANTS );
+		}
+		else if(( tables > 0 )&&( r >= 85 )) {
+			fprintf( to, "\tmov\tsi,t%d\n", bench_random( seed ) % tables );
+		}
+		else {
+			fprintf( to, "\t%s\n", simple[ bench_random( seed ) % ( sizeof( simple ) / sizeof( char * ))]);
+		}
+		lines++;
+	}
+	/*
+	 *	Any forward labels still outstanding.
+	 */
+	for( i = 0; i < pendings; i++ ) {
+		if( pending[ i ] < count + BENCH_FORWARD * 2 ) {
+			fprintf( to, "f%d_%d:\n", seg, i );
+			lines++;
+		}
+	}
+	fprintf( to, "\tret\n" );
+	lines++;
+	FREE( pending );
+	return( lines );
+}
+
+/*
+ *	Write a synthetic source file.
+ */
+int generate_source( char *name, bench_scenario *scenario ) {
+	unsigned int	seed;
+	FILE		*to;
+	char		*file;
+	int		lines, tables, s, i, j, l;
+
+	if(( lines = generate_includes( name, scenario )) == ERROR ) return( ERROR );
+	if(( to = fopen( name, "w" )) == NIL( FILE )) {
+		log_error_s( "Unable to create file", name );
+		return( ERROR );
+	}
+	seed = scenario->seed;
+	tables = ( scenario->tables + BENCH_TABLE_WIDTH - 1 ) / BENCH_TABLE_WIDTH;
+	fprintf( to, "; Synthetic source, scenario %s\n", scenario->name );
+	fprintf( to, "; lines=%d labels=%d locals=%d forward=%d segments=%d depth=%d tables=%d seed=%u\n",
+			scenario->lines, scenario->labels, scenario->locals, scenario->forward,
+			scenario->segments, scenario->depth, scenario->tables, scenario->seed );
+	lines += 2;
+	if( scenario->depth > 0 ) {
+		char	*base;
+
+		file = include_name( STACK_ARRAY( char, strlen( name ) + MAX_CONST_SIZE ), name, 1 );
+		base = (( base = strrchr( file, '/' )))? base+1: file;
+		fprintf( to, "\tinclude\t\"%s\"\n", base );
+		lines++;
+	}
+	/*
+	 *	Each code segment is grouped with a data segment of
+	 *	its own.  Branches never leave the segment they are
+	 *	in.
+	 */
+	for( s = 0; s < scenario->segments; s++ ) fprintf( to, "c%d\tsegment\tcs,\"code\"\nd%d\tsegment\tds,\"data\"\np%d\tgroup\tc%d,d%d\n", s, s, s, s, s );
+	lines += scenario->segments * 3;
+	for( s = 0; s < scenario->segments; s++ ) {
+		lines += generate_segment( to, scenario, s, scenario->lines / scenario->segments, &seed, ( s == 0 )? tables: 0 );
+	}
+	/*
+	 *	The DB tables all go in the first data segment,
+	 *	the rest get a single byte each.
+	 */
+	for( s = 0; s < scenario->segments; s++ ) {
+		fprintf( to, "\n\tsegment\td%d\n", s );
+		lines += 2;
+		if( s == 0 ) {
+			for( i = 0, l = scenario->tables; i < tables; i++ ) {
+				fprintf( to, "t%d:\tdb\t", i );
+				for( j = 0; ( j < BENCH_TABLE_WIDTH )&&( l > 0 ); j++, l-- ) fprintf( to, "%s%d", ( j? ",": "" ), bench_random( &seed ) & 0xff );
+				fprintf( to, "\n" );
+				lines++;
+			}
+		}
+		fprintf( to, "d%d_end:\tdb\t0\n", s );
+		lines++;
+	}
+	fclose( to );
+	return( lines );
+}
+
+/*
+ *	Assemble a source file (in the directory given) in a
+ *	child process, returning the
+ *	time taken (in microseconds) and number of passes through
+ *	the pipe supplied.
+ */
+static void bench_child( int pipe_out, char *directory, char *name ) {
+	struct timespec	start,
+			end;
+	boolean		ok;
+	char		result[ MAX_LINE_SIZE ];
+	long long	usec;
+	int		passes;
+
+	/*
+	 *	Included files are found relative to the current
+	 *	directory.
+	 */
+	if( chdir( directory ) != 0 ) _exit( 1 );
+	(void)select_context( new_context());
+	command_flags = intel_8086;
+	assembler_parameters = flag_086;
+	initialise_output( &memory_output_api, FALSE );
+	clock_gettime( CLOCK_MONOTONIC, &start );
+	if(( ok = open_file( name ))) {
+		ok = assemble_file( name );
+		if( !close_file()) ok = FALSE;
+	}
+	clock_gettime( CLOCK_MONOTONIC, &end );
+	usec = ( end.tv_sec - start.tv_sec ) * 1000000LL + ( end.tv_nsec - start.tv_nsec ) / 1000;
+	passes = total_passes();
+	sprintf( result, "%d %lld %d\n", ok, usec, passes );
+	if( write( pipe_out, result, strlen( result )) < 0 ) _exit( 1 );
+	_exit( 0 );
+}
+
+/*
+ *	Run a single scenario, writing its results.
+ */
+static boolean run_scenario( char *directory, bench_scenario *scenario, int repeat ) {
+	char		*name,
+			*base,
+			*file,
+			result[ MAX_LINE_SIZE ];
+	struct rusage	usage;
+	long long	usec, best;
+	long		peak;
+	int		lines, passes, ok, fd[ 2 ], status, len, r, d;
+	pid_t		child;
+
+	name = STACK_ARRAY( char, strlen( directory ) + strlen( scenario->name ) + 8 );
+	sprintf( name, "%s/%s.asm", directory, scenario->name );
+	base = name + strlen( directory ) + 1;
+	if(( lines = generate_source( name, scenario )) == ERROR ) return( FALSE );
+	best = 0;
+	peak = 0;
+	passes = 0;
+	ok = TRUE;
+	for( r = 0; r < repeat; r++ ) {
+		if( pipe( fd ) != 0 ) {
+			log_error( "Unable to create pipe" );
+			return( FALSE );
+		}
+		fflush( stdout );
+		if(( child = fork()) < 0 ) {
+			log_error( "Unable to create process" );
+			return( FALSE );
+		}
+		if( child == 0 ) {
+			close( fd[ 0 ]);
+			bench_child( fd[ 1 ], directory, base );
+		}
+		close( fd[ 1 ]);
+		len = read( fd[ 0 ], result, sizeof( result )-1 );
+		close( fd[ 0 ]);
+		if(( wait4( child, &status, 0, &usage ) != child )||( len <= 0 )) {
+			ok = FALSE;
+			break;
+		}
+		result[ len ] = EOS;
+		if( sscanf( result, "%d %lld %d", &status, &usec, &passes ) != 3 ) {
+			ok = FALSE;
+			break;
+		}
+		if( !status ) ok = FALSE;
+		if(( r == 0 )||( usec < best )) best = usec;
+		if( usage.ru_maxrss > peak ) peak = usage.ru_maxrss;
+	}
+	printf( "%s\t%d\t%d\t%lld\t%.0f\t%ld\t%s\n", scenario->name, lines, passes, best,
+			( best > 0 )? (double)lines * 1000000.0 / (double)best: 0.0, peak, ok? "ok": "failed" );
+	fflush( stdout );
+	/*
+	 *	Tidy up.
+	 */
+	file = STACK_ARRAY( char, strlen( name ) + MAX_CONST_SIZE );
+	(void)unlink( name );
+	for( d = 1; d <= scenario->depth; d++ ) (void)unlink( include_name( file, name, d ));
+	return( ok );
+}
+
+/*
+ *	Run the benchmarks.
+ */
+boolean run_benchmarks( char *scenario, int repeat ) {
+	char		directory[] = "/tmp/i8086-bench-XXXXXX";
+	bench_scenario	custom;
+	boolean		ok;
+	int		i;
+
+	if( repeat < 1 ) repeat = 1;
+	if(( scenario != NIL( char ))&& !find_scenario( scenario, &custom )) return( FALSE );
+	if( mkdtemp( directory ) == NIL( char )) {
+		log_error( "Unable to create benchmark directory" );
+		return( FALSE );
+	}
+	printf( "# i8086 " PROGRAM_VERSION_NUMBER " benchmark, best of %d\n", repeat );
+	printf( "# scenario\tlines\tpasses\tusec\tlines_per_second\tpeak_rss_kb\tresult\n" );
+	ok = TRUE;
+	if( scenario != NIL( char )) {
+		ok = run_scenario( directory, &custom, repeat );
+	}
+	else {
+		for( i = 0; scenarios[ i ].name != NIL( char ); i++ ) if( !run_scenario( directory, &( scenarios[ i ]), repeat )) ok = FALSE;
+	}
+	(void)rmdir( directory );
+	return( ok );
+}
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,78 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	benchmark
+ *	=========
+ *
+ *	Routines associated with the extended verification mode to
+ *	generate synthetic assembly language source files and to
+ *	measure the assembler's performance on them.
+ */
+ 
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#ifdef VERIFICATION
+
+/*
+ *	The shape of a synthetic source file.
+ */
+typedef struct {
+	char		*name;
+	int		lines,		/* Approximate number of source lines */
+			labels,		/* Percentage of lines with a label */
+			locals,		/* Percentage of those labels which are local */
+			forward,	/* Percentage of lines which branch forward */
+			segments,	/* Number of code segments (each grouped with a data segment) */
+			depth,		/* Depth of nested INCLUDE files */
+			tables;		/* Bytes of DB table data */
+	unsigned int	seed;		/* Random number seed */
+} bench_scenario;
+
+/*
+ *	Find the scenario described by the text supplied, either
+ *	the name of a built in scenario or a comma separated list
+ *	of "key=value" settings (lines, labels, locals, forward,
+ *	segments, depth, tables or seed) applied to the
+ *	"medium" scenario.  Returns FALSE if the text is invalid.
+ */
+extern boolean find_scenario( char *text, bench_scenario *scenario );
+
+/*
+ *	Write a synthetic source file (and the files it includes,
+ *	named after it) for the scenario supplied, returning the
+ *	total number of lines written (or ERROR).
+ */
+extern int generate_source( char *name, bench_scenario *scenario );
+
+/*
+ *	Assemble each of the built in scenarios (or the scenario
+ *	given) the number of times requested, each in a process of
+ *	its own, and write the results to stdout as tab separated
+ *	columns.  Returns FALSE if any scenario failed.
+ */
+extern boolean run_benchmarks( char *scenario, int repeat );
+
+#endif
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,368 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	cache
+ *	=====
+ *
+ *	An optional on disk cache of assembly results.
+ *
+ *	Each entry in the cache directory is named after a hash of
+ *	the primary source file's name and content, the assembler
+ *	version and those command line flags which affect the output.
+ *	An entry holds the name and content hash of every file opened
+ *	during the assembly (the source "closure") followed by copies
+ *	of all the output files created:
+ *
+ *		i8086-cache <version>
+ *		dep <hash> <file name>
+ *		...
+ *		out <extension> <length>
+ *		<length bytes of data>
+ *		...
+ *		end
+ *
+ *	An entry is only used if every file it names still has the
+ *	same content hash.  Entries are written to a temporary file
+ *	and renamed into place so concurrent assemblies will only ever
+ *	see complete entries.  Entries have their modification time
+ *	updated when used, and the least recently used are deleted
+ *	when the directory exceeds its size limit.
+ */
+ 
+#define MEMORY_TAG	memory_output
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	Set from the command line.
+ */
+char *cache_directory = NIL( char );
+char *cache_size = NIL( char );
+
+/*
+ *	The hashing used is 64 bit FNV-1a.
+ */
+typedef uint64_t hash_value;
+
+#define HASH_BASIS		((hash_value)0xcbf29ce484222325ULL)
+#define HASH_PRIME		((hash_value)0x00000100000001b3ULL)
+#define HASH_DIGITS		16
+
+/*
+ *	The command flags which do not alter the output.
+ */
+#define IGNORED_FLAGS		( be_verbose | more_verbose | show_version | show_help )
+
+static hash_value hash_data( hash_value h, byte *data, int len ) {
+	while( len-- ) {
+		h ^= *data++;
+		h *= HASH_PRIME;
+	}
+	return( h );
+}
+
+static hash_value hash_string( hash_value h, char *s ) {
+	return( hash_data( h, (byte *)s, strlen( s )+1 ));
+}
+
+/*
+ *	Hash the content of a file, returning FALSE if the file
+ *	cannot be read.
+ */
+static boolean hash_file( char *name, hash_value *h ) {
+	byte	buffer[ CACHE_BUFFER_SIZE ];
+	FILE	*f;
+	size_t	l;
+
+	if(( f = fopen( name, "rb" )) == NIL( FILE )) return( FALSE );
+	while(( l = fread( buffer, 1, CACHE_BUFFER_SIZE, f )) > 0 ) *h = hash_data( *h, buffer, l );
+	l = ferror( f );
+	fclose( f );
+	return( l == 0 );
+}
+
+/*
+ *	Return, in a STACK_ARRAY, the name of a file in the cache
+ *	or an output file.
+ */
+#define CACHE_PATH(k)	cache_path(STACK_ARRAY(char,strlen(cache_directory)+HASH_DIGITS+MAX_CONST_SIZE+8),(k))
+#define OUTPUT_PATH(n,e) output_path(STACK_ARRAY(char,strlen(n)+strlen(e)+1),(n),(e))
+
+static char *cache_path( char *buffer, char *key ) {
+	sprintf( buffer, "%s/%s", cache_directory, key );
+	return( buffer );
+}
+
+static char *output_path( char *buffer, char *name, char *ext ) {
+	char	*t;
+
+	strcpy( buffer, name );
+	if(( t = strrchr( buffer, PERIOD ))) *t = EOS;
+	strcat( buffer, ext );
+	return( buffer );
+}
+
+/*
+ *	Generate the key for this assembly into the buffer
+ *	supplied (at least HASH_DIGITS+1 characters).
+ */
+static boolean cache_key( char *name, char *key ) {
+	hash_value	h;
+	char		flags[ MAX_CONST_SIZE*2 ];
+
+	h = hash_string( HASH_BASIS, PROGRAM_VERSION_NUMBER );
+	h = hash_string( h, name );
+	sprintf( flags, "%llo:%lo", (unsigned long long)( command_flags & ~IGNORED_FLAGS ), (unsigned long)assembler_parameters );
+	h = hash_string( h, flags );
+	if( !hash_file( name, &h )) return( FALSE );
+	sprintf( key, "%0*llx", HASH_DIGITS, (unsigned long long)h );
+	return( TRUE );
+}
+
+/*
+ *	Return the list of output file extensions created by the
+ *	current command line, NIL terminated.
+ */
+#define MAX_OUTPUT_EXTENSIONS	6
+
+static int output_extensions( char **list ) {
+	int	n;
+
+	n = 0;
+	if(( list[ n ] = output_extension())) n++;
+	if( BOOL( command_flags & generate_listing )) list[ n++ ] = ".lst";
+	if( BOOL( command_flags & generate_map )) {
+		list[ n++ ] = ".map";
+		list[ n++ ] = ".xrf";
+	}
+	if( BOOL( command_flags & generate_depend )) list[ n++ ] = ".d";
+	list[ n ] = NIL( char );
+	return( n );
+}
+
+/*
+ *	Copy len bytes between files.
+ */
+static boolean copy_data( FILE *from, FILE *to, long len ) {
+	byte	buffer[ CACHE_BUFFER_SIZE ];
+	size_t	l;
+
+	while( len > 0 ) {
+		l = ( len > CACHE_BUFFER_SIZE )? CACHE_BUFFER_SIZE: len;
+		if( fread( buffer, 1, l, from ) != l ) return( FALSE );
+		if( fwrite( buffer, 1, l, to ) != l ) return( FALSE );
+		len -= l;
+	}
+	return( TRUE );
+}
+
+/*
+ *	Attempt to restore the outputs of assembling the named
+ *	source file from the cache.
+ */
+boolean cache_restore( char *name ) {
+	char		key[ HASH_DIGITS+1 ],
+			line[ MAX_LINE_SIZE+HASH_DIGITS+16 ],
+			ext[ MAX_LINE_SIZE ],
+			*path, *s;
+	unsigned long long	want;
+	hash_value	have;
+	long		len;
+	FILE		*from, *to;
+	int		l;
+	boolean		ok;
+
+	if( cache_directory == NIL( char )) return( FALSE );
+	if( !cache_key( name, key )) return( FALSE );
+	path = CACHE_PATH( key );
+	if(( from = fopen( path, "rb" )) == NIL( FILE )) return( FALSE );
+	/*
+	 *	Confirm the header and the content of every
+	 *	file the entry depends upon.
+	 */
+	ok = ( fgets( line, sizeof( line ), from ) != NIL( char ))&&( strcmp( line, "i8086-cache " PROGRAM_VERSION_NUMBER "\n" ) == 0 );
+	while( ok && ( fgets( line, sizeof( line ), from ) != NIL( char ))&&( strncmp( line, "dep ", 4 ) == 0 )) {
+		if(( l = strlen( line )) > 0 ) line[ l-1 ] = EOS;
+		if(( sscanf( line+4, "%llx", &want ) != 1 )||(( s = strchr( line+4, SPACE )) == NIL( char ))) {
+			ok = FALSE;
+			break;
+		}
+		have = HASH_BASIS;
+		ok = hash_file( s+1, &have ) && ( have == (hash_value)want );
+	}
+	/*
+	 *	Restore each of the output files.
+	 */
+	while( ok && ( strncmp( line, "out ", 4 ) == 0 )) {
+		if(( sscanf( line+4, "%s %ld", ext, &len ) != 2 )||( len < 0 )) {
+			ok = FALSE;
+			break;
+		}
+		if(( to = fopen( OUTPUT_PATH( name, ext ), "wb" )) == NIL( FILE )) {
+			ok = FALSE;
+			break;
+		}
+		ok = copy_data( from, to, len );
+		if( fclose( to )) ok = FALSE;
+		if( ok && ( fgets( line, sizeof( line ), from ) == NIL( char ))) ok = FALSE;
+	}
+	ok = ok && ( strcmp( line, "end\n" ) == 0 );
+	fclose( from );
+	if( ok ) {
+		/*
+		 *	Mark the entry as recently used.
+		 */
+		(void)utime( path, NIL( struct utimbuf ));
+		if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Restored from cache entry %s.\n", key );
+	}
+	return( ok );
+}
+
+/*
+ *	Routine used to sort the cache directory into least
+ *	recently used order.
+ */
+typedef struct {
+	char	name[ HASH_DIGITS+1 ];
+	time_t	used;
+	off_t	size;
+} cache_entry;
+
+static int compare_entries( const void *a, const void *b ) {
+	time_t	l = ((cache_entry *)a )->used,
+		r = ((cache_entry *)b )->used;
+
+	return(( l < r )? -1: (( l > r )? 1: 0 ));
+}
+
+/*
+ *	Remove the least recently used entries from the cache until
+ *	it fits within its size limit.  Only files with names of the
+ *	form used for keys are considered.
+ */
+static void cache_evict( void ) {
+	DIR		*dir;
+	struct dirent	*ent;
+	struct stat	st;
+	cache_entry	*list;
+	int		count, size, i;
+	off_t		total, limit;
+	char		path[ PATH_MAX ];
+
+	/*
+	 *	The one buffer holds the name of each entry in turn.
+	 */
+	if( strlen( cache_directory )+HASH_DIGITS+2 > sizeof( path )) return;
+	limit = (off_t)(( cache_size != NIL( char ))? atol( cache_size ): CACHE_SIZE_LIMIT ) * 1024;
+	if(( dir = opendir( cache_directory )) == NIL( DIR )) return;
+	list = NIL( cache_entry );
+	count = size = 0;
+	total = 0;
+	while(( ent = readdir( dir ))) {
+		if(( strlen( ent->d_name ) != HASH_DIGITS )||( strspn( ent->d_name, "0123456789abcdef" ) != HASH_DIGITS )) continue;
+		if( stat( cache_path( path, ent->d_name ), &st ) != 0 ) continue;
+		if( count == size ) {
+			size = size? size*2: 64;
+			list = RESIZE_ARRAY( list, cache_entry, size );
+		}
+		strcpy( list[ count ].name, ent->d_name );
+		list[ count ].used = st.st_mtime;
+		list[ count ].size = st.st_size;
+		total += st.st_size;
+		count++;
+	}
+	closedir( dir );
+	if( total > limit ) {
+		qsort( list, count, sizeof( cache_entry ), compare_entries );
+		for( i = 0; ( i < count )&&( total > limit ); i++ ) {
+			if( unlink( cache_path( path, list[ i ].name )) == 0 ) total -= list[ i ].size;
+		}
+	}
+	if( list ) FREE( list );
+}
+
+/*
+ *	Write a single dependency line into the cache entry.
+ */
+static void cache_dependency( char *name, void *data ) {
+	hash_value	h;
+
+	h = HASH_BASIS;
+	if( !hash_file( name, &h )) return;
+	fprintf( (FILE *)data, "dep %0*llx %s\n", HASH_DIGITS, (unsigned long long)h, name );
+}
+
+/*
+ *	Count the temporary files started by this process, so that
+ *	threads storing the same entry do not write the same file.
+ */
+static atomic_int temp_files = 0;
+
+/*
+ *	Save the outputs of a successful assembly of the named
+ *	source file into the cache.
+ */
+void cache_store( char *name ) {
+	char		key[ HASH_DIGITS+1 ],
+			*ext[ MAX_OUTPUT_EXTENSIONS+1 ],
+			*temp, *path;
+	FILE		*from, *to;
+	struct stat	st;
+	boolean		ok;
+	int		i;
+
+	if( cache_directory == NIL( char )) return;
+	if( !cache_key( name, key )) return;
+	(void)mkdir( cache_directory, 0777 );
+	path = CACHE_PATH( key );
+	temp = STACK_ARRAY( char, strlen( path )+MAX_CONST_SIZE*2+8 );
+	sprintf( temp, "%s.%ld.%d.tmp", path, (long)getpid(), atomic_fetch_add( &temp_files, 1 ));
+	if(( to = fopen( temp, "wb" )) == NIL( FILE )) return;
+	fprintf( to, "i8086-cache " PROGRAM_VERSION_NUMBER "\n" );
+	visit_dependencies( cache_dependency, to );
+	ok = TRUE;
+	(void)output_extensions( ext );
+	for( i = 0; ok && ( ext[ i ] != NIL( char )); i++ ) {
+		char	*out = OUTPUT_PATH( name, ext[ i ]);
+
+		if(( stat( out, &st ) != 0 )||(( from = fopen( out, "rb" )) == NIL( FILE ))) {
+			ok = FALSE;
+			break;
+		}
+		fprintf( to, "out %s %ld\n", ext[ i ], (long)st.st_size );
+		ok = copy_data( from, to, st.st_size );
+		fclose( from );
+	}
+	fprintf( to, "end\n" );
+	if( ferror( to )) ok = FALSE;
+	if( fclose( to )) ok = FALSE;
+	if( ok && ( rename( temp, path ) == 0 )) {
+		if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Saved cache entry %s.\n", key );
+		cache_evict();
+	}
+	else {
+		(void)unlink( temp );
+	}
+}
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,57 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	cache
+ *	=====
+ *
+ *	An optional on disk cache of assembly results.
+ */
+ 
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+/*
+ *	The cache directory (NIL if caching has not been requested)
+ *	and the limit placed on its size in KBytes (NIL selects the
+ *	default).  These are set from the command line.
+ */
+extern char *cache_directory;
+extern char *cache_size;
+
+/*
+ *	Attempt to restore the outputs of assembling the named
+ *	source file from the cache.  Returns TRUE if this has been
+ *	done and no assembly is required.
+ */
+extern boolean cache_restore( char *name );
+
+/*
+ *	Save the outputs of a successful assembly of the named
+ *	source file into the cache.  Failures are not errors; the
+ *	result is simply not cached.
+ */
+extern void cache_store( char *name );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */
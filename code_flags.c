@@ -26,12 +26,6 @@
 #include "os.h"
 #include "includes.h"
 
-/*
- *	Define the variable holding the current set of assembly
- *	language control settings.
- */
-mnemonic_flags assembler_parameters = flag_none;
-
 
 #ifdef VERIFICATION
 
@@ -55,10 +55,10 @@ typedef enum {
 } mnemonic_flags;
 
 /*
- *	Define the variable holding the current set of assembly
- *	language control settings.
+ *	The current set of assembly language control settings
+ *	are held in the assembler context.
  */
-extern mnemonic_flags assembler_parameters;
+#define assembler_parameters	(this_context->parameters)
 
 
 #ifdef VERIFICATION
@@ -27,11 +27,6 @@
 #include "os.h"
 #include "includes.h"
 
-/*
- *	Declare the global holding the flags current in force.
- */
-command_flag command_flags = no_command_flags;
-
 /*
  *	Return TRUE if the output format matches the configuration of
  *	the source code being assembled.
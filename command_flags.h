@@ -29,9 +29,14 @@
 
 /*
  *	Define the set of flags which control some of the operational
- *	characteristics of the assembler.
+ *	characteristics of the assembler.  The flags are held in a 64
+ *	bit word as there are more than an enumeration (an int) can
+ *	hold; those beyond the range of an int are defined after the
+ *	enumeration.
  */
-typedef enum {
+typedef uint64_t command_flag;
+
+enum {
 	no_command_flags		= 0000000,	/* No command line flags enabled. */
 	/*
 	 *	Assembler operating modifications
@@ -45,7 +50,9 @@ typedef enum {
 	generate_dot_exe		= 0000010,	/* Create a complex '.EXE. executable. */
 	generate_dot_obj		= 0000020,	/* Create a '.OBJ' intermediate file. */
 	generate_hex			= 0000040,	/* Output above files in HEXadecimal. */
-	generate_listing		= 0000100,	/* Create an assembly listing file. */
+	generate_listing		= 0000100,	/* Create an assembly listing file (alongside the above). */
+	generate_map			= 0400000,	/* Create symbol map and cross reference files. */
+	generate_depend			= 01000000,	/* Create a make style dependency file. */
 	/*
 	 *	Select target processor
 	 *
@@ -66,6 +73,11 @@ typedef enum {
 	 *	program.
 	 */
 	intel_80286			= 0001000,	/* Extended 80286 CPU instructions */
+	/*
+	 *	The 8088 and 80188 are the 8086 and 80186 with a byte
+	 *	wide data bus, this only affecting their timing.
+	 */
+	eight_bit_bus			= 010000000000,	/* Byte wide data bus (8088/80188) */
 	/*
 	 *	Select restrictions on accepted code.
 	 */
@@ -78,24 +90,47 @@ typedef enum {
 	show_help			= 0020000,	/* Display help text */
 	be_verbose			= 0040000,	/* Make more noise while working */
 	more_verbose			= 0100000,	/* Display more details about internal ops. */
+	watch_for_changes		= 02000000,	/* Reassemble as source files change. */
+	pipeline_stages			= 04000000,	/* Read and write on separate threads. */
+	show_statistics			= 010000000,	/* Report counters and timings per pass. */
+	report_convergence		= 020000000,	/* Report labels and instructions slow to settle. */
+	list_clocks			= 04000000000,	/* Estimate clocks per line in the listing. */
 	
 #ifdef VERIFICATION
 	dump_opcodes			= 0200000,	/* Display the content of the opcode encoding table */
+	run_benchmark			= 040000000,	/* Time assembly of synthetic source files */
+	run_micro_benchmark		= 0100000000,	/* Time the core routines in isolation */
+	disassemble_code		= 0200000000,	/* List binary files as assembly language */
+	round_trip_forms		= 0400000000,	/* Assemble and decode every instruction form */
+#endif
+#ifdef EXECUTION
+	execute_programs		= 01000000000,	/* Run the named '.COM' files */
+	run_program			= 02000000000,	/* Run the '.COM' file once assembled */
 #endif
 
 	/*
 	 *	Define some group classifications.
 	 */
-	output_selection_mask		= ( generate_dot_com | generate_dot_exe | generate_dot_obj | generate_listing ),
+	output_selection_mask		= ( generate_dot_com | generate_dot_exe | generate_dot_obj ),
 	cpu_selection_mask		= ( intel_8086 | intel_80186 | intel_80286 )
 	
-} command_flag;
+};
+
+/*
+ *	The flags beyond the range of an int.
+ */
+#define COMMAND_FLAG(b)		((command_flag)1 << (b))
+
+#define optimize_size		COMMAND_FLAG( 31 )	/* Use the shortest encoding of each instruction. */
+#define expand_branches		COMMAND_FLAG( 32 )	/* Rewrite short branches which cannot reach. */
+#define auto_align		COMMAND_FLAG( 33 )	/* Word align data for a 16-bit bus. */
 
 
 /*
- *	Define the global holding the flags current in force.
+ *	The flags currently in force are held in the
+ *	assembler context.
  */
-extern command_flag command_flags;
+#define command_flags		(this_context->flags)
 
 /*
  *	Return TRUE if the output format matches the configuration of
@@ -0,0 +1,142 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	concurrency
+ *	===========
+ *
+ *	Routines associated with the extended verification mode to
+ *	confirm that assembler contexts are independent of each other.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+#ifdef VERIFICATION
+
+/*
+ *	The details of a single assembly.
+ */
+typedef struct {
+	char		*name;
+	command_flag	flags;
+	mnemonic_flags	parameters;
+	boolean		ok;
+	byte		*code;
+	int		len;
+	pthread_t	thread;
+} assembly_job;
+
+/*
+ *	Assemble a single file into memory inside its own
+ *	context.
+ */
+static void *assemble_job( void *data ) {
+	assembly_job		*job = (assembly_job *)data;
+	assembler_context	*context,
+				*previous;
+
+	context = new_context();
+	previous = select_context( context );
+	command_flags = job->flags & ~( be_verbose | more_verbose | output_selection_mask | generate_listing | generate_map | generate_depend );
+	assembler_parameters = job->parameters;
+	initialise_output( &memory_output_api, FALSE );
+	job->code = NIL( byte );
+	job->len = 0;
+	if(( job->ok = open_file( job->name ))) {
+		job->ok = assemble_file( job->name );
+		if( !close_file()) job->ok = FALSE;
+		job->code = memory_output_result( &( job->len ));
+	}
+	delete_context( context );
+	(void)select_context( previous );
+	return( NIL( void ));
+}
+
+/*
+ *	Assemble each of the files named serially, then on
+ *	the threads.
+ */
+boolean verify_concurrency( int files, char *name[], int threads ) {
+	assembly_job	*serial,
+			*parallel;
+	boolean		ok;
+	int		i, f, failed;
+
+	if(( files < 1 )||( threads < 1 )) {
+		log_error( "Concurrency verification requires files and threads" );
+		return( FALSE );
+	}
+	serial = NEW_ARRAY( assembly_job, files );
+	parallel = NEW_ARRAY( assembly_job, threads );
+	ok = TRUE;
+	/*
+	 *	The reference results.
+	 */
+	for( f = 0; f < files; f++ ) {
+		serial[ f ].name = name[ f ];
+		serial[ f ].flags = command_flags;
+		serial[ f ].parameters = assembler_parameters;
+		(void)assemble_job( &( serial[ f ]));
+		printf( "Serial %s: %s, %d bytes.\n", name[ f ], serial[ f ].ok? "ok": "failed", serial[ f ].len );
+		/*
+		 *	A file which fails serially proves nothing when
+		 *	it fails the same way on the threads.
+		 */
+		if( !serial[ f ].ok ) {
+			log_error_s( "Serial assembly failed", name[ f ]);
+			ok = FALSE;
+		}
+	}
+	/*
+	 *	All of the threads are started before any are
+	 *	waited for.
+	 */
+	for( i = 0; i < threads; i++ ) {
+		parallel[ i ] = serial[ i % files ];
+		if( pthread_create( &( parallel[ i ].thread ), NULL, assemble_job, &( parallel[ i ])) != 0 ) {
+			log_error_i( "Unable to start thread", i );
+			threads = i;
+			ok = FALSE;
+			break;
+		}
+	}
+	failed = 0;
+	for( i = 0; i < threads; i++ ) {
+		assembly_job	*ref;
+
+		(void)pthread_join( parallel[ i ].thread, NULL );
+		ref = &( serial[ i % files ]);
+		if(( parallel[ i ].ok != ref->ok )||( parallel[ i ].len != ref->len )||(( ref->len > 0 )&&( memcmp( parallel[ i ].code, ref->code, ref->len ) != 0 ))) {
+			log_error_si( "Concurrent result differs from serial result", ref->name, i );
+			failed++;
+		}
+		if( parallel[ i ].code ) FREE( parallel[ i ].code );
+	}
+	printf( "Concurrent: %d threads, %d differences.\n", threads, failed );
+	for( f = 0; f < files; f++ ) if( serial[ f ].code ) FREE( serial[ f ].code );
+	FREE( serial );
+	FREE( parallel );
+	return( ok && ( failed == 0 ));
+}
+
+#endif
+
+/*
+ *	EOF
+ */
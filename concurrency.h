@@ -0,0 +1,46 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	concurrency
+ *	===========
+ *
+ *	Routines associated with the extended verification mode to
+ *	confirm that assembler contexts are independent of each other.
+ */
+ 
+#ifndef _CONCURRENCY_H_
+#define _CONCURRENCY_H_
+
+#ifdef VERIFICATION
+
+/*
+ *	Assemble each of the files named serially, then assemble
+ *	them again on the number of threads given (all running at
+ *	the same time), confirming that every serial assembly
+ *	succeeds and every result is identical to the serial result.
+ */
+extern boolean verify_concurrency( int files, char *name[], int threads );
+
+#endif
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -81,6 +81,77 @@
  */
 #define HEX_DUMP_COLS		20
 
+/*
+ *	The listing file is assembled in a buffer of this size
+ *	before being written out, and runs of identical bytes
+ *	at least LISTING_DUP_MINIMUM long are shown as a single
+ *	"n DUP(v)" line rather than as individual bytes.
+ */
+#define LISTING_BUFFER_SIZE	32768
+#define LISTING_DUP_MINIMUM	8
+
+/*
+ *	The default limit (in KBytes) on the size of the
+ *	assembly result cache directory, and the size of the
+ *	buffer used when copying files into and out of it.
+ */
+#define CACHE_SIZE_LIMIT	65536
+#define CACHE_BUFFER_SIZE	8192
+
+/*
+ *	Identifier records are allocated in slabs, the first of
+ *	IDENTIFIER_FIRST_SLAB records, each twice the size of the
+ *	one before up to IDENTIFIER_SLAB_SIZE.  Their names are kept
+ *	in blocks growing the same way from IDENTIFIER_FIRST_NAMES
+ *	to IDENTIFIER_NAME_BLOCK bytes (or the size of the name).
+ *	The first and largest sizes must differ by a power of two.
+ */
+#define IDENTIFIER_FIRST_SLAB	16
+#define IDENTIFIER_SLAB_SIZE	256
+#define IDENTIFIER_FIRST_NAMES	256
+#define IDENTIFIER_NAME_BLOCK	4096
+
+/*
+ *	When tokenising a file in advance each thread is given
+ *	at least TOKENISE_CHUNK_LINES lines.  The label names and
+ *	strings of each chunk are kept in blocks of (at least)
+ *	TOKENISE_ARENA_SIZE bytes, and found through a hash table
+ *	of TOKENISE_NAME_HASH entries.
+ */
+#define TOKENISE_CHUNK_LINES	1024
+#define TOKENISE_ARENA_SIZE	16384
+#define TOKENISE_NAME_HASH	256
+
+/*
+ *	The pipeline queues hold PIPELINE_LINES source lines read
+ *	ahead of the assembler and PIPELINE_BLOCKS blocks of output
+ *	(each PIPELINE_BLOCK_SIZE bytes) waiting to be written.  A
+ *	thread waiting on a queue yields PIPELINE_SPIN times before
+ *	sleeping PIPELINE_SLEEP microseconds at a time.
+ */
+#define PIPELINE_LINES		256
+#define PIPELINE_BLOCKS		16
+#define PIPELINE_BLOCK_SIZE	4096
+#define PIPELINE_SPIN		64
+#define PIPELINE_SLEEP		50
+
+/*
+ *	The convergence report lists the worst CONVERGE_REPORT_LIMIT
+ *	labels and instructions, remembering the first CONVERGE_SIZES
+ *	sizes of each instruction.  Both are found through hash tables
+ *	of CONVERGE_HASH entries.
+ */
+#define CONVERGE_REPORT_LIMIT	10
+#define CONVERGE_SIZES		8
+#define CONVERGE_HASH		1024
+
+/*
+ *	When dumping the opcode table the instructions generated
+ *	from each entry are gathered in an array which starts with
+ *	space for DUMP_INSTRUCTIONS and doubles as required.
+ */
+#define DUMP_INSTRUCTIONS	64
+
 #endif
 
 /*
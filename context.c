@@ -0,0 +1,90 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	context
+ *	=======
+ *
+ *	Creation and selection of assembler contexts.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The context of the current thread.
+ */
+THREAD_LOCAL assembler_context *this_context = NIL( assembler_context );
+
+/*
+ *	Make the context supplied the current context of the
+ *	calling thread, returning the previous current context.
+ */
+assembler_context *select_context( assembler_context *context ) {
+	assembler_context	*previous;
+
+	previous = this_context;
+	this_context = context;
+	return( previous );
+}
+
+/*
+ *	Create a new (empty) context.  Everything starts as zero
+ *	(NIL, FALSE, no_pass, etc) apart from the list tails which
+ *	are set up by releasing the (empty) lists.
+ */
+assembler_context *new_context( void ) {
+	assembler_context	*context,
+				*previous;
+
+	context = NEW( assembler_context );
+	memset( context, 0, sizeof( assembler_context ));
+	previous = select_context( context );
+	release_segments();
+	release_source();
+	(void)select_context( previous );
+	return( context );
+}
+
+/*
+ *	Release a context and everything held within it.
+ */
+void delete_context( assembler_context *context ) {
+	assembler_context	*previous;
+
+	ASSERT( context != NIL( assembler_context ));
+
+	previous = select_context( context );
+	(void)close_listing();
+	release_output();
+	release_memory_output();
+	release_source();
+	release_tokenise();
+	release_identifiers();
+	release_state();
+	release_statistics();
+	release_convergence();
+	release_store();
+	(void)select_context(( previous == context )? NIL( assembler_context ): previous );
+	FREE( context );
+}
+
+
+/*
+ *	EOF
+ */
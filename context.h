@@ -0,0 +1,81 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	context
+ *	=======
+ *
+ *	The assembler context holds all of the state which
+ *	changes while a source file is assembled.  Each module
+ *	defines the part of the context it owns (and macros naming
+ *	its content) in its own header; this brings them together.
+ *
+ *	Each thread has its own "current" context, so separate
+ *	threads can assemble separate files at the same time.  The
+ *	read only tables (opcodes, keywords, etc.) are shared.
+ */
+ 
+#ifndef _CONTEXT_H_
+#define _CONTEXT_H_
+
+typedef struct {
+	command_flag		flags;
+	mnemonic_flags		parameters;
+	errors_context		errors;
+	state_context		state;
+	segments_context	segments;
+	identifiers_context	identifiers;
+	store_context		store;
+	source_context		source;
+	output_context		output;
+	memory_context		memory;
+	listing_context		listing;
+	tokenise_context	tokenise;
+	stats_context		stats;
+	converge_context	converge;
+} assembler_context;
+
+/*
+ *	The context of the current thread.
+ */
+extern THREAD_LOCAL assembler_context *this_context;
+
+/*
+ *	Create a new (empty) context.
+ */
+extern assembler_context *new_context( void );
+
+/*
+ *	Make the context supplied the current context of the
+ *	calling thread, returning the previous current context.
+ */
+extern assembler_context *select_context( assembler_context *context );
+
+/*
+ *	Release a context and everything held within it.  The
+ *	context must not be the current context of another thread.
+ */
+extern void delete_context( assembler_context *context );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */
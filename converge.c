@@ -0,0 +1,316 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	converge
+ *	========
+ *
+ *	Tracking of the labels which move, and the instructions
+ *	which change size, from pass to pass while label values
+ *	settle.  Reported by the "--convergence" option.
+ *
+ *	An instruction changing size moves every label after it
+ *	in its segment, which may in turn change the size of other
+ *	instructions referring to those labels.  The first change
+ *	in each pass is therefore reported as the start of that
+ *	pass's chain.
+ */
+
+#define MEMORY_TAG	memory_reports
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The convergence state is held in the assembler context.
+ */
+#define converge_sites		(this_context->converge.sites)
+#define converge_labels		(this_context->converge.labels)
+#define converge_flips		(this_context->converge.flips)
+#define flip_count		(this_context->converge.flip_count)
+#define flip_size		(this_context->converge.flip_size)
+#define converge_passes		(this_context->converge.passes)
+#define converge_count		(this_context->converge.pass_count)
+#define converge_size		(this_context->converge.pass_size)
+
+/*
+ *	Grow an array by doubling, as required to hold one more
+ *	entry.
+ */
+static void *grow_array( void *array, int used, int *size, int entry ) {
+	if( used == *size ) {
+		*size = *size? *size * 2: CONVERGE_REPORT_LIMIT;
+		array = RESIZE_ARRAY( array, byte, entry * *size );
+	}
+	return( array );
+}
+
+/*
+ *	Return the current pass summary.
+ */
+static converge_pass *this_converge_pass( void ) {
+	ASSERT( converge_count > 0 );
+
+	return( &( converge_passes[ converge_count-1 ]));
+}
+
+/*
+ *	Start a new pass.
+ */
+void start_convergence_pass( void ) {
+	converge_pass	*p;
+
+	if( converge_sites == NIL( converge_site * )) {
+		converge_sites = NEW_ARRAY( converge_site *, CONVERGE_HASH );
+		memset( converge_sites, 0, sizeof( converge_site * ) * CONVERGE_HASH );
+		converge_labels = NEW_ARRAY( converge_label *, CONVERGE_HASH );
+		memset( converge_labels, 0, sizeof( converge_label * ) * CONVERGE_HASH );
+	}
+	converge_passes = (converge_pass *)grow_array( converge_passes, converge_count, &converge_size, sizeof( converge_pass ));
+	p = &( converge_passes[ converge_count++ ]);
+	p->phase = this_pass;
+	p->moved = 0;
+	p->resized = 0;
+}
+
+/*
+ *	Note a label changing value.
+ */
+void note_label_moved( id_record *label, integer from, integer to ) {
+	converge_label	**adrs,
+			*look;
+
+	if( converge_count == 0 ) return;
+	adrs = &( converge_labels[ ((unsigned long)label >> 4 ) % CONVERGE_HASH ]);
+	for( look = *adrs; look; look = look->next ) if( look->label == label ) break;
+	if( look == NIL( converge_label )) {
+		look = NEW( converge_label );
+		look->label = label;
+		(void)current_line( &( look->file ), &( look->line ));
+		look->moves = 0;
+		look->travel = 0;
+		look->next = *adrs;
+		*adrs = look;
+	}
+	look->moves++;
+	look->travel += ( to > from )? ( to - from ): ( from - to );
+	this_converge_pass()->moved++;
+}
+
+/*
+ *	Note the size of the instruction on the current line.
+ */
+void note_instruction_size( int size ) {
+	converge_site	**adrs,
+			*look;
+	converge_flip	*flip;
+	char		*file;
+	int		line;
+
+	if( converge_count == 0 ) return;
+	(void)current_line( &file, &line );
+	if( file == NIL( char )) return;
+	adrs = &( converge_sites[ line % CONVERGE_HASH ]);
+	for( look = *adrs; look; look = look->next ) if(( look->line == line )&&( strcmp( look->file, file ) == 0 )) break;
+	if( look == NIL( converge_site )) {
+		look = NEW( converge_site );
+		look->file = file;
+		look->line = line;
+		look->size = size;
+		look->pass = converge_count;
+		look->flips = 0;
+		look->sizes[ 0 ] = size;
+		look->next = *adrs;
+		*adrs = look;
+		return;
+	}
+	if(( look->size != size )&&( look->pass < converge_count )) {
+		converge_flips = (converge_flip *)grow_array( converge_flips, flip_count, &flip_size, sizeof( converge_flip ));
+		flip = &( converge_flips[ flip_count++ ]);
+		flip->pass = converge_count;
+		flip->site = look;
+		flip->from = look->size;
+		flip->to = size;
+		if( ++( look->flips ) < CONVERGE_SIZES ) look->sizes[ look->flips ] = size;
+		this_converge_pass()->resized++;
+	}
+	look->size = size;
+	look->pass = converge_count;
+}
+
+/*
+ *	Ordering of labels and instructions, worst first.
+ */
+static int compare_labels( const void *a, const void *b ) {
+	converge_label	*l = *(converge_label **)a,
+			*r = *(converge_label **)b;
+
+	if( l->moves != r->moves ) return( r->moves - l->moves );
+	if( l->travel != r->travel ) return(( r->travel > l->travel )? 1: -1 );
+	return( strcmp( l->label->id, r->label->id ));
+}
+
+static int compare_sites( const void *a, const void *b ) {
+	converge_site	*l = *(converge_site **)a,
+			*r = *(converge_site **)b;
+	int		c;
+
+	if( l->flips != r->flips ) return( r->flips - l->flips );
+	if(( c = strcmp( l->file, r->file ))) return( c );
+	return( l->line - r->line );
+}
+
+/*
+ *	Return the name of a phase.
+ */
+static char *phase_text( assembler_phase phase ) {
+	switch( phase ) {
+		case pass_label_gathering:	return( "label gathering" );
+		case pass_value_confirmation:	return( "value confirmation" );
+		case pass_code_generation:	return( "code generation" );
+		default:			break;
+	}
+	return( "none" );
+}
+
+/*
+ *	Write out the report.
+ */
+void write_convergence( FILE *to, char *name ) {
+	converge_label	**label,
+			*l;
+	converge_site	**site,
+			*s;
+	converge_flip	*f;
+	int		labels, sites, i, j, k;
+
+	if( converge_count == 0 ) return;
+	/*
+	 *	Gather and rank the labels and instructions.
+	 */
+	labels = 0;
+	sites = 0;
+	for( i = 0; i < CONVERGE_HASH; i++ ) {
+		for( l = converge_labels[ i ]; l; l = l->next ) labels++;
+		for( s = converge_sites[ i ]; s; s = s->next ) if( s->flips ) sites++;
+	}
+	label = NEW_ARRAY( converge_label *, labels+1 );
+	site = NEW_ARRAY( converge_site *, sites+1 );
+	labels = 0;
+	sites = 0;
+	for( i = 0; i < CONVERGE_HASH; i++ ) {
+		for( l = converge_labels[ i ]; l; l = l->next ) label[ labels++ ] = l;
+		for( s = converge_sites[ i ]; s; s = s->next ) if( s->flips ) site[ sites++ ] = s;
+	}
+	qsort( label, labels, sizeof( converge_label * ), compare_labels );
+	qsort( site, sites, sizeof( converge_site * ), compare_sites );
+
+	flockfile( to );
+	fprintf( to, "Convergence report for %s:-\n", name );
+	/*
+	 *	Each pass, and where its chain of changes started.
+	 */
+	fprintf( to, "%5s %-19s %8s %8s  %s\n", "Pass", "Phase", "Moved", "Resized", "First change" );
+	for( i = 0, k = 0; i < converge_count; i++ ) {
+		fprintf( to, "%5d %-19s %8d %8d", i+1, phase_text( converge_passes[ i ].phase ), converge_passes[ i ].moved, converge_passes[ i ].resized );
+		while(( k < flip_count )&&( converge_flips[ k ].pass < i+1 )) k++;
+		if(( k < flip_count )&&( converge_flips[ k ].pass == i+1 )) {
+			f = &( converge_flips[ k ]);
+			fprintf( to, "  %s:%d (%d -> %d bytes)", f->site->file, f->site->line, f->from, f->to );
+		}
+		fprintf( to, "\n" );
+	}
+	/*
+	 *	The instructions changing size in each pass.
+	 */
+	for( i = 0, k = 0; i < converge_count; i++ ) {
+		while(( k < flip_count )&&( converge_flips[ k ].pass < i+1 )) k++;
+		for( j = 0; ( k+j < flip_count )&&( converge_flips[ k+j ].pass == i+1 ); j++ ) {
+			f = &( converge_flips[ k+j ]);
+			if( j == 0 ) fprintf( to, "Pass %d resized:", i+1 );
+			if( j < CONVERGE_REPORT_LIMIT ) fprintf( to, " %s:%d(%d->%d)", f->site->file, f->site->line, f->from, f->to );
+		}
+		if( j > CONVERGE_REPORT_LIMIT ) fprintf( to, " and %d more", j - CONVERGE_REPORT_LIMIT );
+		if( j ) fprintf( to, "\n" );
+	}
+	/*
+	 *	The worst offenders.
+	 */
+	if( labels ) {
+		fprintf( to, "Labels moving most:-\n%8s %8s  %-24s %s\n", "Moves", "Travel", "Label", "Defined at" );
+		for( i = 0; ( i < labels )&&( i < CONVERGE_REPORT_LIMIT ); i++ ) {
+			l = label[ i ];
+			fprintf( to, "%8d %8ld  %-24s %s:%d\n", l->moves, l->travel, l->label->id, l->file? l->file: "-", l->line );
+		}
+	}
+	if( sites ) {
+		fprintf( to, "Instructions changing size most:-\n%8s  %-16s %s\n", "Changes", "Sizes", "Location" );
+		for( i = 0; ( i < sites )&&( i < CONVERGE_REPORT_LIMIT ); i++ ) {
+			char	sizes[ CONVERGE_SIZES * 4 + 4 ];
+			int	n;
+
+			s = site[ i ];
+			n = 0;
+			for( j = 0; ( j <= s->flips )&&( j < CONVERGE_SIZES ); j++ ) n += sprintf( sizes+n, "%s%d", ( j? ",": "" ), s->sizes[ j ]);
+			if( s->flips >= CONVERGE_SIZES ) strcpy( sizes+n, ",..." );
+			fprintf( to, "%8d  %-16s %s:%d\n", s->flips, sizes, s->file, s->line );
+		}
+	}
+	funlockfile( to );
+	FREE( label );
+	FREE( site );
+}
+
+/*
+ *	Forget everything noted.
+ */
+void release_convergence( void ) {
+	converge_label	*l;
+	converge_site	*s;
+	int		i;
+
+	if( converge_sites ) {
+		for( i = 0; i < CONVERGE_HASH; i++ ) {
+			while(( s = converge_sites[ i ])) {
+				converge_sites[ i ] = s->next;
+				FREE( s );
+			}
+			while(( l = converge_labels[ i ])) {
+				converge_labels[ i ] = l->next;
+				FREE( l );
+			}
+		}
+		FREE( converge_sites );
+		FREE( converge_labels );
+	}
+	converge_sites = NIL( converge_site * );
+	converge_labels = NIL( converge_label * );
+	if( converge_flips ) FREE( converge_flips );
+	converge_flips = NIL( converge_flip );
+	flip_count = 0;
+	flip_size = 0;
+	if( converge_passes ) FREE( converge_passes );
+	converge_passes = NIL( converge_pass );
+	converge_count = 0;
+	converge_size = 0;
+}
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,119 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	converge
+ *	========
+ *
+ *	Tracking of the labels which move, and the instructions
+ *	which change size, from pass to pass while label values
+ *	settle.  Reported by the "--convergence" option.
+ */
+
+#ifndef _CONVERGE_H_
+#define _CONVERGE_H_
+
+/*
+ *	An instruction, identified by where it is in the source,
+ *	and the size it had on the last pass.
+ */
+typedef struct _converge_site {
+	char			*file;
+	int			line,
+				size,
+				pass,		/* Pass size was last noted */
+				flips;		/* Times the size changed */
+	char			sizes[ CONVERGE_SIZES ];	/* The sizes it has had */
+	struct _converge_site	*next;
+} converge_site;
+
+/*
+ *	A label which has moved, where it is defined, how often it
+ *	moved and how far in total.
+ */
+typedef struct _converge_label {
+	id_record		*label;
+	char			*file;
+	int			line,
+				moves;
+	long			travel;
+	struct _converge_label	*next;
+} converge_label;
+
+/*
+ *	An instruction changing size during a pass.
+ */
+typedef struct {
+	int			pass;
+	converge_site		*site;
+	int			from,
+				to;
+} converge_flip;
+
+/*
+ *	The summary of a pass.
+ */
+typedef struct {
+	assembler_phase		phase;
+	int			moved,		/* Labels which moved */
+				resized;	/* Instructions which changed size */
+} converge_pass;
+
+/*
+ *	The convergence state held in the assembler context.
+ */
+typedef struct {
+	converge_site		**sites;
+	converge_label		**labels;
+	converge_flip		*flips;
+	int			flip_count,
+				flip_size;
+	converge_pass		*passes;
+	int			pass_count,
+				pass_size;
+} converge_context;
+
+/*
+ *	Mark the start of each pass.
+ */
+extern void start_convergence_pass( void );
+
+/*
+ *	Note a label changing value, and the size of the instruction
+ *	just assembled from the current line.
+ */
+extern void note_label_moved( id_record *label, integer from, integer to );
+extern void note_instruction_size( int size );
+
+/*
+ *	Write out the ranked report of the labels and instructions
+ *	which delayed convergence for the named file.
+ */
+extern void write_convergence( FILE *to, char *name );
+
+/*
+ *	Forget everything noted.
+ */
+extern void release_convergence( void );
+
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -94,7 +94,9 @@
  *
  *	MAX_CODE_BYTES		The maximum number of bytes which can
  *				form an single machine code instruction
- *				(excluding the prefix bytes).
+ *				(excluding the prefix bytes).  A loop
+ *				expanded to reach a distant target takes
+ *				seven.
  *
  *	MAX_PREFIX_BYTES	The maximum number of bytes which can
  *				precede a machine code instruction as
@@ -104,7 +106,7 @@
  *				can be part of a single instruction
  *				argument.
  */
-#define MAX_CODE_BYTES		6
+#define MAX_CODE_BYTES		7
 #define MAX_PREFIX_BYTES	4
 #define MAX_REGISTERS		2
 
@@ -84,6 +84,12 @@ typedef int32_t		integer;
  */
 #define FUNC(a)		(*(a))
 
+/*
+ *	Storage class of variables holding a separate value
+ *	for each thread.
+ */
+#define THREAD_LOCAL	_Thread_local
+
 /*
  *	Try and catch miss-understandings about pointers
  */
@@ -23,6 +23,8 @@
  *	Provide the various assembler directives
  */
 
+#define MEMORY_TAG	memory_segments
+
 #include "os.h"
 #include "includes.h"
 
@@ -50,7 +52,8 @@ static boolean process_dir_end( int args, token_record **arg, int *len ) {
  *	{label}	EQU	{expression}
  */
 static boolean process_dir_equ( id_record *label, int args, token_record **arg, int *len ) {
-	constant_value	val;
+	constant_value	val,
+			old;
 	int		used;
 
 	if( label == NIL( id_record )) {
@@ -82,17 +85,20 @@ static boolean process_dir_equ( id_record *label, int args, token_record **arg,
 	 */
 	if( label->type == class_unknown ) {
 		label->type = class_const;
-		label->var.value = val;
+		set_label_value( label, &val );
 		this_jiggle++;
 	}
 	else {
-		if( label->var.value.segment != val.segment ) {
+		get_label_value( label, &old );
+		if( old.segment != val.segment ) {
 			log_error( "Inconsistent segment in EQU expression" );
 			return( FALSE );
 		}
-		if( label->var.value.value != val.value ) {
-			if( BOOL( command_flags & more_verbose )) printf( "%s: %04x -> %04x\n", label->id, label->var.value.value, val.value );
-			label->var.value.value = val.value;
+		if( old.value != val.value ) {
+			if( BOOL( command_flags & more_verbose )) fprintf( report_stream(), "%s: %04x -> %04x\n", label->id, old.value, val.value );
+			if( BOOL( command_flags & report_convergence )) note_label_moved( label, old.value, val.value );
+			old.value = val.value;
+			set_label_value( label, &old );
 			this_jiggle++;
 		}
 	}
@@ -238,17 +244,102 @@ static boolean process_dir_reserve( int args, token_record **arg, int *len ) {
 	return( output_space( val.value ));
 }
 
+/*
+ *	Is the segment given one holding code?  Segments declared
+ *	without access flags are judged by their segment register.
+ */
+static boolean holds_code( segment_record *seg ) {
+	if( BOOL( seg->access & segment_program_code )) return( TRUE );
+	if( BOOL( seg->access & ( segment_static_data | segment_variable_data ))) return( FALSE );
+	return( seg->seg_reg == REG_CS );
+}
+
+/*
+ *	Pad the current segment out by count bytes.  As padding in
+ *	code may be run through it is filled with instructions, the
+ *	quicker of 'mov ax,ax' (and a 'nop' for an odd byte) or a jump
+ *	over 'nop's, returning the clocks taken through clocks.  Other
+ *	segments are padded with zeros.
+ */
+static boolean output_padding( int count, int *clocks ) {
+	byte	*filler;
+	boolean	jump;
+	int	i;
+
+	*clocks = 0;
+	if(( count == 0 )|| !holds_code( this_segment )) return( output_space( count ));
+	*clocks = filler_clocks( count, &jump );
+	filler = STACK_ARRAY( byte, count );
+	memset( filler, 0x90, count );
+	if( jump ) {
+		if( count - 2 <= 127 ) {
+			filler[ 0 ] = 0xEB;
+			filler[ 1 ] = count - 2;
+		}
+		else {
+			filler[ 0 ] = 0xE9;
+			filler[ 1 ] = L( count - 3 );
+			filler[ 2 ] = H( count - 3 );
+		}
+	}
+	else {
+		for( i = 0; i+1 < count; i += 2 ) {
+			filler[ i ] = 0x8B;
+			filler[ i+1 ] = 0xC0;
+		}
+	}
+	return( output_data( filler, count ));
+}
+
+/*
+ *	Align to a word boundary when the target CPU has a 16-bit
+ *	data bus, so the word at the current position (the first
+ *	instructions of a loop or a word variable) is fetched in a
+ *	single bus cycle.  The listing notes the bytes spent against
+ *	the clocks gained.  Over a byte wide bus nothing is gained
+ *	and nothing is done.
+ */
+static boolean align_for_bus( void ) {
+	char	note[ LISTING_NOTE_SIZE ];
+	int	gain,
+		clocks;
+
+	if(( gain = misaligned_clocks()) == 0 ) return( TRUE );
+	if(( this_segment->posn % 2 ) == 0 ) return( TRUE );
+	if( !output_padding( 1, &clocks )) return( FALSE );
+	if( clocks ) {
+		snprintf( note, LISTING_NOTE_SIZE, "aligned: 1 byte of filler (%d clocks) for %d clocks per jump here", clocks, gain );
+	}
+	else {
+		snprintf( note, LISTING_NOTE_SIZE, "aligned: 1 byte for %d clocks per word access", gain );
+	}
+	listing_note( note );
+	return( TRUE );
+}
+
 /*
  *	Force the current offset (in the current segment) to align
  *	with either the numerical value or data modifier.
  *
- *		ALIGN	{expression}|{modifier}
+ *		ALIGN	[{expression}|{modifier}]
  *
- *	where modifier is one of BYTE, WORD, DWORD or PTR.
+ *	where modifier is one of BYTE, WORD, DWORD or PTR.  Without
+ *	an argument the alignment suits the target, marking a hot
+ *	loop head (say) to be word aligned on a CPU with a 16-bit
+ *	data bus but left alone on the 8088 and 80188.
  */
 static boolean process_dir_align( int args, token_record **arg, int *len ) {
 	integer	alignment, gap;
+	int	clocks;
 
+	if( args == 0 ) {
+		if( this_segment == NIL( segment_record )) {
+			log_error( "Segment not set before ALIGN" );
+			return( FALSE );
+		}
+		if( misaligned_clocks() == 0 ) listing_note( "not aligned: nothing gained over an 8-bit bus" );
+		return( align_for_bus());
+	}
 	if( args != 1 ) {
 		log_error( "ALIGN requires single argument" );
 		return( FALSE );
@@ -309,7 +400,7 @@ static boolean process_dir_align( int args, token_record **arg, int *len ) {
 	 *	so we are not on a suitable alignment, add in
 	 *	the necessary space.
 	 */
-	return( output_space( alignment - gap ));
+	return( output_padding( alignment - gap, &clocks ));
 }
 
 /*
@@ -406,12 +497,12 @@ static boolean process_dir_group( id_record *label, int args, token_record **arg
 	}
 	if( label->type == class_unknown ) {
 		label->type = class_group;
-		label->var.group = NIL( segment_group );
+		set_label_group( label, NIL( segment_group ));
 	}
 	/*
 	 *	Create the group if it didn't already exist.
 	 */
-	if(( gp = label->var.group ) == NIL( segment_group )) {
+	if(( gp = label_group( label )) == NIL( segment_group )) {
 		/*
 		 *	We are creating a group from scratch.
 		 */
@@ -425,7 +516,7 @@ static boolean process_dir_group( id_record *label, int args, token_record **arg
 		tail_all_groups = &( gp->next );
 
 		label->type = class_group;
-		label->var.group = gp;
+		set_label_group( label, gp );
 	}
 	/*
 	 *	Now step through the arguments which should all be
@@ -452,7 +543,7 @@ static boolean process_dir_group( id_record *label, int args, token_record **arg
 				log_error_i( "GROUP argument not a segment name", i+1 );
 				return( FALSE );
 			}
-			ts = ip->var.segment;
+			ts = label_segment( ip );
 
 			ASSERT( ts != NIL( segment_record ));
 
@@ -592,12 +683,12 @@ static boolean process_dir_segment( id_record *label, int args, token_record **a
 			sp->next = NIL( segment_record );
 
 			label->type = class_segment;
-			label->var.segment = sp;
+			set_label_segment( label, sp );
 		}
 		else {
 			ASSERT( label->type == class_segment );
 
-			sp = label->var.segment;
+			sp = label_segment( label );
 
 			ASSERT( sp != NIL( segment_record ));
 
@@ -653,12 +744,12 @@ static boolean process_dir_segment( id_record *label, int args, token_record **a
 			sp->next = NIL( segment_record );
 
 			ip->type = class_segment;
-			ip->var.segment = sp;
+			set_label_segment( ip, sp );
 		}
 		else {
 			ASSERT( ip->type == class_segment );
 
-			sp = ip->var.segment;
+			sp = label_segment( ip );
 
 			ASSERT( sp != NIL( segment_record ));
 		}
@@ -784,6 +875,13 @@ boolean process_directive( id_record *label, component dir, int args, token_reco
 			return( process_dir_db( args, arg, len ));
 		}
 		case asm_dw: {
+			/*
+			 *	Word variables are aligned (if it helps) with
+			 *	--auto-align.
+			 */
+			if( label && BOOL( command_flags & auto_align )&&( this_segment != NIL( segment_record ))&& !holds_code( this_segment )) {
+				if( !align_for_bus()) return( FALSE );
+			}
 			if( label ) if( !set_label_here( label, this_segment )) return( FALSE );
 			return( process_dir_dw( args, arg, len ));
 		}
@@ -0,0 +1,1012 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	disassemble
+ *	===========
+ *
+ *	Routines associated with the extended verification mode to
+ *	turn machine code back into assembly language using only
+ *	the encoding data held in the opcode table.
+ *
+ *	Each entry of the table is compiled into a decoder: the
+ *	values and masks of the opcode bytes its SB actions set
+ *	(less the bits which SDS, REG and ESC actions vary) and,
+ *	where the following mod-reg-r/m byte carries an EAO operator,
+ *	that operator.  The decoders are then indexed by the first
+ *	opcode byte and the reg field of the byte after it, keeping
+ *	table order, so an instruction is matched by trying only the
+ *	handful of entries which could have produced it.
+ *
+ *	Matching runs the entry's encoding actions in reverse: each
+ *	action reads back what assemble_inst() would have written.
+ *	As this is driven entirely by the table, any error in the
+ *	table shows up in the disassembly.
+ */
+
+#include "os.h"
+#include "includes.h"
+
+#if defined( VERIFICATION )||defined( EXECUTION )
+
+/*
+ *	The output is gathered into DISASSEMBLE_BUFFER bytes before
+ *	being written, each line being at most DISASSEMBLE_LINE long.
+ */
+#define DISASSEMBLE_BUFFER	65536
+#define DISASSEMBLE_LINE	128
+
+/*
+ *	The data size an instruction works on, mirroring the byte,
+ *	word, near and far flags of the instruction record.
+ */
+#define DATA_BYTE		1
+#define DATA_WORD		2
+#define DATA_NEAR		4
+#define DATA_FAR		8
+
+/*
+ *	An entry of the opcode table compiled for decoding.
+ */
+typedef struct {
+	opcode		*op;
+	byte		fixed,				/* Opcode bytes set by SB */
+			value[ MAX_CODE_BYTES ],
+			mask[ MAX_CODE_BYTES ];
+	int		modrm_op;			/* EAO operator or ERROR */
+	boolean		sized,				/* Word/byte held in a bit */
+			escape,				/* Carries an ESC value */
+			flipped;			/* Word relative form */
+	byte		size_index,
+			size_bit;
+} decoder;
+
+/*
+ *	The decoders and, for each first byte and reg field, the
+ *	range of candidates (in table order) which could match.
+ */
+typedef struct {
+	int		first,
+			count;
+} decoder_range;
+
+static decoder		*decoders = NIL( decoder );
+static int		*candidates = NIL( int );
+static decoder_range	dispatch[ 256 ][ 8 ];
+static mnemonic_flags	decoder_cpus = flag_none;
+
+/*
+ *	Registers indexed by their number in the machine code, and
+ *	the text of each component (found once).
+ */
+static register_data	*byte_register[ 8 ],
+			*word_register[ 8 ],
+			*segment_register[ SEGMENT_REGISTERS ],
+			*memory_register[ 8 ][ MAX_REGISTERS ];
+static const char	*component_name[ end_of_line+1 ];
+
+/*
+ *	The state held while matching a single decoder.
+ */
+typedef struct {
+	byte		*code;
+	int		len,
+			posn,
+			segment;
+	boolean		wide,
+			segment_used;
+	byte		data;
+} decode_state;
+
+/*
+ *	Compile an entry of the opcode table into a decoder, the
+ *	flipped version being the word form of a relative branch
+ *	which may take either a byte or word displacement.  Return
+ *	FALSE if the entry has no such form or cannot be decoded.
+ */
+static boolean compile_decoder( opcode *op, boolean flipped, decoder *d ) {
+	boolean	variable,			/* Word size held in the w bit */
+		wide,				/* Otherwise, is it a word */
+		reading,			/* Past the opcode bytes */
+		has_flip;
+	byte	b;
+	word	e;
+	int	i;
+
+	d->op = op;
+	d->fixed = 0;
+	d->modrm_op = ERROR;
+	d->sized = FALSE;
+	d->escape = FALSE;
+	d->flipped = flipped;
+	variable = FALSE;
+	wide = FALSE;
+	reading = FALSE;
+	has_flip = FALSE;
+	for( i = 0; i < op->encoded; i++ ) {
+		e = op->encode[ i ];
+		switch( GET_ACT( e )) {
+			case SB_ACT: {
+				if( reading || ( d->fixed == MAX_CODE_BYTES )) return( FALSE );
+				d->value[ d->fixed ] = SB_VALUE( e );
+				d->mask[ d->fixed++ ] = 0xFF;
+				break;
+			}
+			case IDS_ACT: {
+				if( IDS_ARG( e ) >= op->args ) return( FALSE );
+				variable = TRUE;
+				break;
+			}
+			case FDS_ACT: {
+				if( FDS_SIZE( e ) == DATA_SIZE_WORD ) {
+					variable = FALSE;
+					wide = TRUE;
+				}
+				break;
+			}
+			case SDS_ACT: {
+				if( SDS_INDEX( e ) >= d->fixed ) return( FALSE );
+				b = BIT( SDS_BIT( e ));
+				if( variable ) {
+					d->mask[ SDS_INDEX( e )] &= ~b;
+					d->sized = TRUE;
+					d->size_index = SDS_INDEX( e );
+					d->size_bit = SDS_BIT( e );
+				}
+				else if( wide ) {
+					d->value[ SDS_INDEX( e )] |= b;
+				}
+				else {
+					d->value[ SDS_INDEX( e )] &= ~b;
+				}
+				break;
+			}
+			case SDR_ACT: {
+				if( SDR_INDEX( e ) >= d->fixed ) return( FALSE );
+				b = BIT( SDR_BIT( e ));
+				if( SDR_DIR( e )) {
+					d->value[ SDR_INDEX( e )] |= b;
+				}
+				else {
+					d->value[ SDR_INDEX( e )] &= ~b;
+				}
+				break;
+			}
+			case REG_ACT: {
+				if(( REG_ARG( e ) >= op->args )||( REG_INDEX( e ) >= d->fixed )) return( FALSE );
+				d->mask[ REG_INDEX( e )] &= ~( 7 << REG_BIT( e ));
+				break;
+			}
+			case ESC_ACT: {
+				if(( ESC_ARG( e ) >= op->args )||( d->fixed < 1 )) return( FALSE );
+				d->mask[ 0 ] &= ~7;
+				d->escape = TRUE;
+				break;
+			}
+			case EA_ACT: {
+				if(( EA_REG( e ) >= op->args )||( EA_EADRS( e ) >= op->args )) return( FALSE );
+				reading = TRUE;
+				break;
+			}
+			case EAO_ACT: {
+				if( EAO_EADRS( e ) >= op->args ) return( FALSE );
+				if( !reading ) d->modrm_op = EAO_OPCODE( e );
+				reading = TRUE;
+				break;
+			}
+			case IMM_ACT: {
+				if( IMM_ARG( e ) >= op->args ) return( FALSE );
+				reading = TRUE;
+				break;
+			}
+			case SXI_ACT: {
+				if( SXI_ARG( e ) >= op->args ) return( FALSE );
+				reading = TRUE;
+				break;
+			}
+			case REL_ACT: {
+				if( REL_ARG( e ) >= op->args ) return( FALSE );
+				if( REL_RANGE( e ) == RANGE_BOTH ) {
+					if( REL_INDEX( e ) >= d->fixed ) return( FALSE );
+					if( flipped ) d->value[ REL_INDEX( e )] ^= BIT( REL_BIT( e ));
+					has_flip = TRUE;
+				}
+				reading = TRUE;
+				break;
+			}
+			case TER_ACT: {
+				if( TER_ARG( e ) >= op->args ) return( FALSE );
+				break;
+			}
+			case VDS_ACT: {
+				if( VDS_ARG( e ) >= op->args ) return( FALSE );
+				break;
+			}
+			default: {
+				return( FALSE );
+			}
+		}
+	}
+	if( d->fixed == 0 ) return( FALSE );
+	if( flipped && !has_flip ) return( FALSE );
+	/*
+	 *	The ESC value is spread across the reg field so
+	 *	there is no operator to check.
+	 */
+	if( d->escape ) d->modrm_op = ERROR;
+	for( i = 0; i < d->fixed; i++ ) d->value[ i ] &= d->mask[ i ];
+	return( TRUE );
+}
+
+/*
+ *	Is the decoder a candidate for the first byte and reg
+ *	field given?
+ */
+static boolean decoder_matches( decoder *d, int first, int reg ) {
+	if(( first & d->mask[ 0 ]) != d->value[ 0 ]) return( FALSE );
+	if(( d->fixed == 1 )&&( d->modrm_op != ERROR )&&( d->modrm_op != reg )) return( FALSE );
+	return( TRUE );
+}
+
+void initialise_decoder( mnemonic_flags cpus ) {
+	opcode	*op;
+	int	count,
+		used,
+		first,
+		reg,
+		i;
+
+	if(( decoders != NIL( decoder ))&&( cpus == decoder_cpus )) return;
+	if( decoders != NIL( decoder )) {
+		FREE( decoders );
+		FREE( candidates );
+	}
+	decoder_cpus = cpus;
+	/*
+	 *	Registers and their names.
+	 */
+	for( i = 0; i < 8; i++ ) {
+		byte_register[ i ] = register_component( reg_al + i );
+		word_register[ i ] = register_component( reg_ax + i );
+	}
+	segment_register[ REG_ES ] = register_component( reg_es );
+	segment_register[ REG_CS ] = register_component( reg_cs );
+	segment_register[ REG_SS ] = register_component( reg_ss );
+	segment_register[ REG_DS ] = register_component( reg_ds );
+	memory_register[ 0 ][ 0 ] = register_component( reg_bx );
+	memory_register[ 0 ][ 1 ] = register_component( reg_si );
+	memory_register[ 1 ][ 0 ] = register_component( reg_bx );
+	memory_register[ 1 ][ 1 ] = register_component( reg_di );
+	memory_register[ 2 ][ 0 ] = register_component( reg_bp );
+	memory_register[ 2 ][ 1 ] = register_component( reg_si );
+	memory_register[ 3 ][ 0 ] = register_component( reg_bp );
+	memory_register[ 3 ][ 1 ] = register_component( reg_di );
+	memory_register[ 4 ][ 0 ] = register_component( reg_si );
+	memory_register[ 5 ][ 0 ] = register_component( reg_di );
+	memory_register[ 6 ][ 0 ] = register_component( reg_bp );
+	memory_register[ 7 ][ 0 ] = register_component( reg_bx );
+	for( i = 0; i <= end_of_line; i++ ) component_name[ i ] = component_text( i );
+	/*
+	 *	Compile the entries for the CPUs selected, each
+	 *	may have a second (word relative) form.
+	 */
+	for( count = 0; opcodes[ count ].op != nothing; count++ );
+	decoders = NEW_ARRAY( decoder, count * 2 );
+	used = 0;
+	for( op = opcodes; op->op != nothing; op++ ) {
+		if( !BOOL( op->flags & cpus )) continue;
+		if( compile_decoder( op, FALSE, &( decoders[ used ]))) used++;
+		if( compile_decoder( op, TRUE, &( decoders[ used ]))) used++;
+	}
+	/*
+	 *	Count, then list, the candidates for each first
+	 *	byte and reg field.
+	 */
+	count = 0;
+	for( first = 0; first < 256; first++ ) {
+		for( reg = 0; reg < 8; reg++ ) {
+			for( i = 0; i < used; i++ ) if( decoder_matches( &( decoders[ i ]), first, reg )) count++;
+		}
+	}
+	candidates = NEW_ARRAY( int, count + 1 );
+	count = 0;
+	for( first = 0; first < 256; first++ ) {
+		for( reg = 0; reg < 8; reg++ ) {
+			dispatch[ first ][ reg ].first = count;
+			for( i = 0; i < used; i++ ) if( decoder_matches( &( decoders[ i ]), first, reg )) candidates[ count++ ] = i;
+			dispatch[ first ][ reg ].count = count - dispatch[ first ][ reg ].first;
+		}
+	}
+}
+
+/*
+ *	The width of a register (or the data) an argument of the
+ *	class given works on, when the w bit says wide.
+ */
+static boolean arg_width( effective_address class, boolean wide ) {
+	if( !BOOL( class & ( ea_byte_registers | ea_mem_mod_adrs ))) return( TRUE );
+	if( !BOOL( class & ( ea_word_registers | ea_mem_mod_adrs ))) return( FALSE );
+	return( wide );
+}
+
+/*
+ *	Fill in an argument as register number n, checking it is
+ *	admitted by the class of the argument.
+ */
+static boolean set_register( ea_breakdown *arg, effective_address class, boolean wide, int n ) {
+	if( BOOL( class & ea_segment_reg ) && !BOOL( class & ea_all_reg )) {
+		if( n >= SEGMENT_REGISTERS ) return( FALSE );
+		arg->ea = ea_segment_reg;
+		arg->reg[ 0 ] = segment_register[ n ];
+	}
+	else if( arg_width( class, wide )) {
+		arg->ea = ( n == REG_AX )? ea_word_acc: ea_word_reg;
+		arg->reg[ 0 ] = word_register[ n ];
+	}
+	else {
+		arg->ea = ( n == REG_AL )? ea_byte_acc: ea_byte_reg;
+		arg->reg[ 0 ] = byte_register[ n ];
+	}
+	arg->registers = 1;
+	return( BOOL( arg->ea & class ));
+}
+
+/*
+ *	Read a byte or word value from the code.
+ */
+static boolean read_value( decode_state *state, int size, integer *v ) {
+	byte	*p;
+
+	if( state->posn + size > state->len ) return( FALSE );
+	p = state->code + state->posn;
+	switch( size ) {
+		case 1: {
+			*v = p[ 0 ];
+			break;
+		}
+		case 2: {
+			*v = W( p[ 1 ], p[ 0 ]);
+			break;
+		}
+		default: {
+			return( FALSE );
+		}
+	}
+	state->posn += size;
+	return( TRUE );
+}
+
+/*
+ *	Fill in an argument from the mod and r/m fields of the
+ *	byte given, reading any displacement which follows.
+ */
+static boolean set_address( decode_state *state, ea_breakdown *arg, effective_address class, byte modrm ) {
+	int		mod = modrm >> 6,
+			rm = modrm & 7;
+	integer		v;
+
+	if( mod == 3 ) return( set_register( arg, class, state->wide, rm ));
+	v = 0;
+	if(( mod == 0 )&&( rm == 6 )) {
+		if( !read_value( state, 2, &v )) return( FALSE );
+		arg->ea = ea_indirect;
+	}
+	else {
+		if( mod == 1 ) {
+			if( !read_value( state, 1, &v )) return( FALSE );
+			v = (signed char)v;
+		}
+		else if( mod == 2 ) {
+			if( !read_value( state, 2, &v )) return( FALSE );
+		}
+		arg->reg[ 0 ] = memory_register[ rm ][ 0 ];
+		if( rm < 4 ) {
+			arg->reg[ 1 ] = memory_register[ rm ][ 1 ];
+			arg->registers = 2;
+			arg->ea = ea_base_index_disp;
+		}
+		else {
+			arg->registers = 1;
+			if(( mod == 0 )||(( mod == 1 )&&( rm == 6 )&&( v == 0 ))) {
+				arg->ea = ea_pointer_reg;
+			}
+			else {
+				arg->ea = ( rm < 6 )? ea_index_disp: ea_base_disp;
+			}
+		}
+	}
+	/*
+	 *	The far forms of each are only different in the data
+	 *	found at the address.
+	 */
+	if( BOOL( class & ea_far_mod_reg_adrs )) {
+		switch( arg->ea ) {
+			case ea_indirect:		arg->ea = ea_far_indirect;		break;
+			case ea_pointer_reg:		arg->ea = ea_far_pointer_reg;		break;
+			case ea_base_disp:		arg->ea = ea_far_base_disp;		break;
+			case ea_index_disp:		arg->ea = ea_far_index_disp;		break;
+			case ea_base_index_disp:	arg->ea = ea_far_base_index_disp;	break;
+			default:			break;
+		}
+		arg->mod = far_modifier;
+	}
+	arg->immediate_arg.value = v;
+	arg->immediate_arg.scope = get_scope( v );
+	arg->segment_override = state->segment;
+	state->segment_used = TRUE;
+	return( BOOL( arg->ea & class ));
+}
+
+/*
+ *	Confirm an argument is compatible with the data size, as
+ *	perform_vds() does while assembling.
+ */
+static boolean verify_size( ea_breakdown *arg, byte data ) {
+	switch( arg->ea ) {
+		case ea_byte_acc:
+		case ea_byte_reg: {
+			return( BOOL( data & DATA_BYTE ));
+		}
+		case ea_word_acc:
+		case ea_word_reg:
+		case ea_segment_reg: {
+			return( BOOL( data & ( DATA_WORD | DATA_NEAR )));
+		}
+		case ea_immediate: {
+			if( BOOL( data & DATA_BYTE )) return( BOOL( arg->immediate_arg.scope & scope_byte ));
+			if( BOOL( data & DATA_WORD )) return( BOOL( arg->immediate_arg.scope & scope_word ));
+			if( BOOL( data & ( DATA_NEAR | DATA_FAR ))) return( BOOL( arg->immediate_arg.scope & scope_address ));
+			return( FALSE );
+		}
+		case ea_indirect:
+		case ea_pointer_reg:
+		case ea_base_disp:
+		case ea_index_disp:
+		case ea_base_index_disp: {
+			if( BOOL( arg->mod & byte_modifier )) return( BOOL( data & DATA_BYTE ));
+			if( BOOL( arg->mod & word_modifier )) return( BOOL( data & DATA_WORD ));
+			return( TRUE );
+		}
+		default: {
+			break;
+		}
+	}
+	return( BOOL( data & DATA_FAR ));
+}
+
+/*
+ *	Run the encoding actions of a decoder in reverse against
+ *	the code, returning the bytes used (or 0 if it does not
+ *	match).  posn is the address of the first opcode byte.
+ */
+static int decode_with( decoder *d, decode_state *state, word posn, decoded_inst *inst ) {
+	opcode		*op = d->op;
+	byte		*code = state->code,
+			vds_data[ MAX_OPCODE_ENCODING ];
+	boolean		set[ MAX_OPCODE_ARGS ],
+			sized[ MAX_OPCODE_ARGS ];
+	ea_breakdown	*arg;
+	integer		v;
+	word		e;
+	int		i, a;
+
+	if( state->len < d->fixed ) return( 0 );
+	for( i = 1; i < d->fixed; i++ ) if(( code[ i ] & d->mask[ i ]) != d->value[ i ]) return( 0 );
+	for( a = 0; a < op->args; a++ ) {
+		arg = &( inst->arg[ a ]);
+		arg->ea = ea_empty;
+		arg->mod = no_modifier;
+		arg->registers = 0;
+		arg->segment_override = UNKNOWN_SEG;
+		arg->immediate_arg.value = 0;
+		arg->immediate_arg.scope = scope_none;
+		arg->immediate_arg.segment = NIL( segment_record );
+		set[ a ] = FALSE;
+		sized[ a ] = FALSE;
+	}
+	inst->op = op;
+	inst->far_segment = 0;
+	state->posn = d->fixed;
+	state->wide = d->sized? BOOL( code[ d->size_index ] & BIT( d->size_bit )): TRUE;
+	state->data = 0;
+	for( i = 0; i < op->encoded; i++ ) {
+		e = op->encode[ i ];
+		switch( GET_ACT( e )) {
+			case IDS_ACT: {
+				a = IDS_ARG( e );
+				state->data = arg_width( op->arg[ a ], state->wide )? DATA_WORD: DATA_BYTE;
+				sized[ a ] = TRUE;
+				break;
+			}
+			case FDS_ACT: {
+				switch( FDS_SIZE( e )) {
+					case DATA_SIZE_BYTE:	state->data |= DATA_BYTE;	break;
+					case DATA_SIZE_WORD:	state->data |= DATA_WORD;	break;
+					case DATA_SIZE_NEAR:	state->data |= DATA_NEAR;	break;
+					default:		state->data |= DATA_FAR;	break;
+				}
+				break;
+			}
+			case IMM_ACT: {
+				a = IMM_ARG( e );
+				arg = &( inst->arg[ a ]);
+				if( BOOL( state->data & DATA_FAR )) {
+					if( !read_value( state, 2, &v )) return( 0 );
+					arg->immediate_arg.value = v;
+					if( !read_value( state, 2, &v )) return( 0 );
+					inst->far_segment = (word)v;
+					arg->ea = BOOL( op->arg[ a ] & ea_far_immediate )? ea_far_immediate: ea_immediate;
+				}
+				else {
+					if( !read_value( state, BOOL( state->data & ( DATA_NEAR | DATA_WORD ))? 2: 1, &v )) return( 0 );
+					arg->immediate_arg.value = v;
+					arg->ea = BOOL( op->arg[ a ] & ea_immediate )? ea_immediate: ea_indirect;
+				}
+				arg->immediate_arg.scope = get_scope( arg->immediate_arg.value );
+				if( BOOL( state->data & ( DATA_NEAR | DATA_FAR ))) arg->immediate_arg.scope |= scope_address;
+				if( !BOOL( arg->ea & op->arg[ a ])) return( 0 );
+				set[ a ] = TRUE;
+				break;
+			}
+			case SXI_ACT: {
+				if( !read_value( state, 1, &v )) return( 0 );
+				a = SXI_ARG( e );
+				arg = &( inst->arg[ a ]);
+				arg->ea = ea_immediate;
+				arg->immediate_arg.value = (word)(signed char)v;
+				arg->immediate_arg.scope = get_scope( arg->immediate_arg.value );
+				if( !BOOL( arg->ea & op->arg[ a ])) return( 0 );
+				set[ a ] = TRUE;
+				break;
+			}
+			case EA_ACT: {
+				byte	modrm;
+
+				if( state->posn >= state->len ) return( 0 );
+				modrm = code[ state->posn++ ];
+				if( !set_register( &( inst->arg[ EA_REG( e )]), op->arg[ EA_REG( e )], state->wide, ( modrm >> 3 ) & 7 )) return( 0 );
+				if( !set_address( state, &( inst->arg[ EA_EADRS( e )]), op->arg[ EA_EADRS( e )], modrm )) return( 0 );
+				set[ EA_REG( e )] = TRUE;
+				set[ EA_EADRS( e )] = TRUE;
+				break;
+			}
+			case EAO_ACT: {
+				byte	modrm;
+
+				if( state->posn >= state->len ) return( 0 );
+				modrm = code[ state->posn++ ];
+				if( !d->escape && ((( modrm >> 3 ) & 7 ) != EAO_OPCODE( e ))) return( 0 );
+				if( !set_address( state, &( inst->arg[ EAO_EADRS( e )]), op->arg[ EAO_EADRS( e )], modrm )) return( 0 );
+				set[ EAO_EADRS( e )] = TRUE;
+				break;
+			}
+			case REG_ACT: {
+				a = REG_ARG( e );
+				if( !set_register( &( inst->arg[ a ]), op->arg[ a ], state->wide, ( code[ REG_INDEX( e )] >> REG_BIT( e )) & 7 )) return( 0 );
+				set[ a ] = TRUE;
+				break;
+			}
+			case ESC_ACT: {
+				if( state->len < 2 ) return( 0 );
+				a = ESC_ARG( e );
+				arg = &( inst->arg[ a ]);
+				arg->ea = ea_immediate;
+				arg->immediate_arg.value = (( code[ 0 ] & 7 ) << 3 )|(( code[ 1 ] >> 3 ) & 7 );
+				arg->immediate_arg.scope = get_scope( arg->immediate_arg.value );
+				set[ a ] = TRUE;
+				break;
+			}
+			case REL_ACT: {
+				int	size;
+
+				size = (( REL_RANGE( e ) == RANGE_WORD )||(( REL_RANGE( e ) == RANGE_BOTH )&& d->flipped ))? 2: 1;
+				if( !read_value( state, size, &v )) return( 0 );
+				if( size == 1 ) v = (signed char)v;
+				a = REL_ARG( e );
+				arg = &( inst->arg[ a ]);
+				arg->ea = ea_immediate;
+				arg->immediate_arg.value = (word)( posn + state->posn + v );
+				arg->immediate_arg.scope = get_scope( arg->immediate_arg.value ) | scope_address;
+				set[ a ] = TRUE;
+				break;
+			}
+			case VDS_ACT: {
+				vds_data[ i ] = state->data;
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+	/*
+	 *	Arguments not found in the code are implied by the
+	 *	instruction: a register it tests for or the
+	 *	accumulator.
+	 */
+	for( a = 0; a < op->args; a++ ) {
+		if( set[ a ]) continue;
+		for( i = 0; i < op->encoded; i++ ) {
+			e = op->encode[ i ];
+			if(( GET_ACT( e ) == TER_ACT )&&( TER_ARG( e ) == a )&& TER_PASS( e )) break;
+		}
+		if( i < op->encoded ) {
+			if( !set_register( &( inst->arg[ a ]), op->arg[ a ], state->wide, TER_REG( e ))) return( 0 );
+		}
+		else {
+			if( !BOOL( op->arg[ a ] & ea_accumulators )) return( 0 );
+			if( !set_register( &( inst->arg[ a ]), op->arg[ a ] & ea_accumulators, state->wide, REG_AL )) return( 0 );
+		}
+	}
+	/*
+	 *	Memory sized by the instruction needs its size given.
+	 */
+	for( a = 0; a < op->args; a++ ) {
+		if( sized[ a ] && BOOL( inst->arg[ a ].ea & ea_mem_mod_adrs )) inst->arg[ a ].mod = ( state->wide? word_modifier: byte_modifier ) | ptr_modifier;
+	}
+	/*
+	 *	Finally the tests made after the arguments are known.
+	 */
+	for( i = 0; i < op->encoded; i++ ) {
+		e = op->encode[ i ];
+		switch( GET_ACT( e )) {
+			case TER_ACT: {
+				arg = &( inst->arg[ TER_ARG( e )]);
+				if( arg->registers != 1 ) return( 0 );
+				if( BOOL( arg->reg[ 0 ]->reg_no == TER_REG( e )) != BOOL( TER_PASS( e ))) return( 0 );
+				break;
+			}
+			case VDS_ACT: {
+				if( !verify_size( &( inst->arg[ VDS_ARG( e )]), vds_data[ i ])) return( 0 );
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+	return( state->posn );
+}
+
+int decode_inst( byte *code, int len, word posn, decoded_inst *inst ) {
+	decode_state	state;
+	decoder_range	*range;
+	decoder		*d;
+	opcode_prefix	prefs;
+	boolean		lock,
+			rep,
+			repne;
+	int		p, i, used;
+
+	ASSERT( decoders != NIL( decoder ));
+
+	/*
+	 *	Gather any prefix bytes, a repeated prefix not
+	 *	being something the assembler could produce.
+	 */
+	state.segment = UNKNOWN_SEG;
+	lock = FALSE;
+	rep = FALSE;
+	repne = FALSE;
+	for( p = 0; ( p < len )&&( p < MAX_PREFIX_BYTES ); p++ ) {
+		switch( code[ p ]) {
+			case 0xF0: {
+				if( lock ) return( 0 );
+				lock = TRUE;
+				continue;
+			}
+			case 0xF3: {
+				if( rep || repne ) return( 0 );
+				rep = TRUE;
+				continue;
+			}
+			case 0xF2: {
+				if( rep || repne ) return( 0 );
+				repne = TRUE;
+				continue;
+			}
+			case 0x26:
+			case 0x2E:
+			case 0x36:
+			case 0x3E: {
+				if( state.segment != UNKNOWN_SEG ) return( 0 );
+				state.segment = ( code[ p ] >> 3 ) & 3;
+				continue;
+			}
+			default: {
+				break;
+			}
+		}
+		break;
+	}
+	if( p >= len ) return( 0 );
+	state.code = code + p;
+	state.len = len - p;
+	range = &( dispatch[ state.code[ 0 ]][ ( state.len > 1 )?(( state.code[ 1 ] >> 3 ) & 7 ): 0 ]);
+	for( i = 0; i < range->count; i++ ) {
+		d = &( decoders[ candidates[ range->first + i ]]);
+		/*
+		 *	The prefixes must be ones the instruction takes.
+		 */
+		prefs = no_prefix;
+		if( lock ) prefs |= lock_prefix;
+		if( rep ) prefs |= BOOL( d->op->prefs & rep_prefix )? rep_prefix: rep_eq_prefix;
+		if( repne ) prefs |= rep_ne_prefix;
+		if( BOOL( prefs & ~d->op->prefs )) continue;
+		state.segment_used = FALSE;
+		if(( used = decode_with( d, &state, (word)( posn + p ), inst ))) {
+			/*
+			 *	A segment prefix must apply to an argument.
+			 */
+			if(( state.segment != UNKNOWN_SEG )&& !state.segment_used ) continue;
+			inst->prefs = prefs;
+			inst->size = p + used;
+			return( inst->size );
+		}
+	}
+	return( 0 );
+}
+
+/*
+ *	Append text to a line.
+ */
+static char *put_text( char *p, const char *s ) {
+	while( *s != EOS ) *p++ = *s++;
+	return( p );
+}
+
+/*
+ *	Append a number (in hexadecimal, as the assembler would
+ *	read it) of at least the digits given.  The C style prefix
+ *	is used as a leading zero (needed before a trailing 'h'
+ *	when the first digit is a letter) would mark it as octal.
+ */
+static char *put_number( char *p, dword v, int digits ) {
+	static const char	hex[] = "0123456789ABCDEF";
+	char			t[ 8 ];
+	int			n;
+
+	n = 0;
+	do {
+		t[ n++ ] = hex[ v & 15 ];
+		v >>= 4;
+	} while( v || ( n < digits ));
+	*p++ = '0';
+	*p++ = 'x';
+	while( n ) *p++ = t[ --n ];
+	return( p );
+}
+
+/*
+ *	Append the modifiers given.
+ */
+static char *put_modifiers( char *p, modifier mod ) {
+	component	mods[ MAXIMUM_MODIFIERS ], *m;
+
+	if( mod == no_modifier ) return( p );
+	expand_modifier( mod, mods, MAXIMUM_MODIFIERS );
+	for( m = mods; *m != nothing; m++ ) {
+		p = put_text( p, component_name[ *m ]);
+		*p++ = SPACE;
+	}
+	return( p );
+}
+
+/*
+ *	Append an argument.
+ */
+static char *put_argument( char *p, decoded_inst *inst, ea_breakdown *arg ) {
+	integer		v;
+	int		i;
+
+	p = put_modifiers( p, arg->mod & ~far_modifier );
+	if( BOOL( arg->mod & far_modifier )) p = put_text( p, "far " );
+	v = arg->immediate_arg.value;
+	switch( arg->ea ) {
+		case ea_byte_acc:
+		case ea_byte_reg:
+		case ea_word_acc:
+		case ea_word_reg:
+		case ea_segment_reg: {
+			return( put_text( p, component_name[ arg->reg[ 0 ]->comp ]));
+		}
+		case ea_immediate: {
+			return( put_number( p, v, ( v > 0xFF )? 4: 2 ));
+		}
+		case ea_far_immediate: {
+			p = put_text( p, "far " );
+			p = put_number( p, inst->far_segment, 4 );
+			*p++ = ':';
+			return( put_number( p, v, 4 ));
+		}
+		default: {
+			break;
+		}
+	}
+	/*
+	 *	An address in memory.
+	 */
+	*p++ = '[';
+	if( arg->segment_override != UNKNOWN_SEG ) {
+		p = put_text( p, component_name[ segment_register[ arg->segment_override ]->comp ]);
+		*p++ = ':';
+	}
+	if( arg->registers == 0 ) {
+		p = put_number( p, (word)v, 4 );
+	}
+	else {
+		for( i = 0; i < arg->registers; i++ ) {
+			if( i ) *p++ = '+';
+			p = put_text( p, component_name[ arg->reg[ i ]->comp ]);
+		}
+		if( v < 0 ) {
+			*p++ = '-';
+			p = put_number( p, -v, 2 );
+		}
+		else if( BOOL( arg->ea & ( ea_base_disp | ea_index_disp | ea_far_base_disp | ea_far_index_disp ))||( v > 0 )) {
+			*p++ = '+';
+			p = put_number( p, v, ( v > 0xFF )? 4: 2 );
+		}
+	}
+	*p++ = ']';
+	return( p );
+}
+
+int format_inst( decoded_inst *inst, char *buffer, int max ) {
+	char	*p;
+	int	a;
+
+	ASSERT( max >= DISASSEMBLE_LINE );
+	(void)max;
+
+	p = buffer;
+	*p++ = '\t';
+	if( BOOL( inst->prefs & lock_prefix )) p = put_text( p, "lock " );
+	if( BOOL( inst->prefs & rep_prefix )) p = put_text( p, "rep " );
+	if( BOOL( inst->prefs & rep_eq_prefix )) p = put_text( p, "repe " );
+	if( BOOL( inst->prefs & rep_ne_prefix )) p = put_text( p, "repne " );
+	p = put_modifiers( p, inst->op->mods );
+	p = put_text( p, component_name[ inst->op->op ]);
+	for( a = 0; a < inst->op->args; a++ ) {
+		*p++ = a? ',': '\t';
+		p = put_argument( p, inst, &( inst->arg[ a ]));
+	}
+	*p = EOS;
+	return( p - buffer );
+}
+
+/*
+ *	Disassemble a single file into the buffer given, flushing
+ *	it to stdout as it fills.
+ */
+static boolean disassemble_file( char *name, word origin, char *buffer ) {
+	static const char	hex[] = "0123456789ABCDEF";
+	decoded_inst		inst;
+	struct timespec		start,
+				end;
+	FILE			*from;
+	byte			*image;
+	long			size,
+				at,
+				count;
+	char			*p;
+	int			used, i, c;
+
+	if(( from = fopen( name, "rb" )) == NIL( FILE )) {
+		log_error_s( "Unable to open file", name );
+		return( FALSE );
+	}
+	if(( fseek( from, 0, SEEK_END ) != 0 )||(( size = ftell( from )) < 0 )||( fseek( from, 0, SEEK_SET ) != 0 )) {
+		log_error_s( "Unable to size file", name );
+		fclose( from );
+		return( FALSE );
+	}
+	image = NEW_ARRAY( byte, size + 1 );
+	if( fread( image, 1, size, from ) != (size_t)size ) {
+		log_error_s( "Unable to read file", name );
+		FREE( image );
+		fclose( from );
+		return( FALSE );
+	}
+	fclose( from );
+	printf( "; %s\n", name );
+	clock_gettime( CLOCK_MONOTONIC, &start );
+	p = buffer;
+	count = 0;
+	for( at = 0; at < size; at += used ) {
+		word	posn = (word)( origin + at );
+
+		if(( used = decode_inst( image + at, ( size - at > INT_MAX )? INT_MAX: (int)( size - at ), posn, &inst )) == 0 ) used = 1;
+		/*
+		 *	Address and code bytes.
+		 */
+		for( i = 12; i >= 0; i -= 4 ) *p++ = hex[( posn >> i ) & 15 ];
+		*p++ = SPACE;
+		c = 5;
+		for( i = 0; i < used; i++ ) {
+			*p++ = hex[ image[ at+i ] >> 4 ];
+			*p++ = hex[ image[ at+i ] & 15 ];
+			*p++ = SPACE;
+			c += 3;
+		}
+		while( c++ < 5 + HEX_DUMP_COLS ) *p++ = SPACE;
+		/*
+		 *	The instruction, or the byte not recognised.
+		 */
+		if( inst.size == used ) {
+			p += format_inst( &inst, p, DISASSEMBLE_LINE );
+			count++;
+		}
+		else {
+			p = put_text( p, "\tdb\t" );
+			p = put_number( p, image[ at ], 2 );
+		}
+		*p++ = NL;
+		if( p - buffer > DISASSEMBLE_BUFFER - 2 * DISASSEMBLE_LINE ) {
+			fwrite( buffer, 1, p - buffer, stdout );
+			p = buffer;
+		}
+		inst.size = 0;
+	}
+	fwrite( buffer, 1, p - buffer, stdout );
+	clock_gettime( CLOCK_MONOTONIC, &end );
+	if( BOOL( command_flags & be_verbose )) {
+		double	secs = ( end.tv_sec - start.tv_sec ) + ( end.tv_nsec - start.tv_nsec ) / 1e9;
+
+		printf( "; %ld bytes, %ld instructions in %.3f seconds (%.1f MBytes/second)\n", size, count, secs, ( secs > 0 )? size / secs / 1e6: 0.0 );
+	}
+	FREE( image );
+	return( TRUE );
+}
+
+boolean disassemble_files( int files, char *name[], word origin ) {
+	mnemonic_flags	cpus;
+	char		*buffer;
+	boolean		ok;
+	int		i;
+
+	if( files == 0 ) {
+		log_error( "Expecting binary files" );
+		return( FALSE );
+	}
+	/*
+	 *	Instructions first available on the target CPU
+	 *	and those before it.
+	 */
+	if( BOOL( command_flags & intel_80286 )) {
+		cpus = flag_086 | flag_186 | flag_286;
+	}
+	else if( BOOL( command_flags & intel_80186 )) {
+		cpus = flag_086 | flag_186;
+	}
+	else {
+		cpus = flag_086;
+	}
+	initialise_decoder( cpus );
+	buffer = NEW_ARRAY( char, DISASSEMBLE_BUFFER );
+	ok = TRUE;
+	for( i = 0; i < files; i++ ) if( !disassemble_file( name[ i ], origin, buffer )) ok = FALSE;
+	FREE( buffer );
+	return( ok );
+}
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,82 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	disassemble
+ *	===========
+ *
+ *	Routines associated with the extended verification mode to
+ *	turn machine code back into assembly language using only
+ *	the encoding data held in the opcode table.
+ */
+
+#ifndef _DISASSEMBLE_H_
+#define _DISASSEMBLE_H_
+
+#if defined( VERIFICATION )||defined( EXECUTION )
+
+/*
+ *	An instruction recovered from machine code.  The arguments
+ *	are held in the form given to assemble_inst(), with relative
+ *	targets held as the address branched to and the segment of
+ *	a far immediate address held separately.
+ */
+typedef struct {
+	opcode		*op;				/* The opcode table entry matched */
+	opcode_prefix	prefs;				/* Prefixes (other than segments) */
+	int		size;				/* Bytes used, including prefixes */
+	word		far_segment;			/* Segment of a far immediate */
+	ea_breakdown	arg[ MAX_OPCODE_ARGS ];
+} decoded_inst;
+
+/*
+ *	Build the decoding tables from the opcode table, admitting
+ *	only the instructions first available on the CPUs given (as
+ *	mnemonic flags).  This must be done before any of the threads
+ *	using decode_inst() are started.
+ */
+extern void initialise_decoder( mnemonic_flags cpus );
+
+/*
+ *	Decode the instruction at the start of the len bytes of code
+ *	given (found at address posn) returning the number of bytes
+ *	used or 0 if no instruction could be identified.
+ */
+extern int decode_inst( byte *code, int len, word posn, decoded_inst *inst );
+
+/*
+ *	Write a decoded instruction as assembly language text (of at
+ *	most max characters including the EOS) into the buffer given
+ *	returning the length of the text.
+ */
+extern int format_inst( decoded_inst *inst, char *buffer, int max );
+
+/*
+ *	Disassemble each of the binary files named, as if loaded at
+ *	the origin given, writing a listing to stdout.  Returns FALSE
+ *	if any file could not be read.
+ */
+extern boolean disassemble_files( int files, char *name[], word origin );
+
+#endif
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -76,8 +76,13 @@ static const char *display_direct( word v ) {
 	return( "Unknown" );
 }
 
-static const char *display_subop( word v ) {
-	static char subop[ 5 ];
+/*
+ *	The text of a sub-opcode is built in a buffer supplied by
+ *	the caller, as entries are displayed on several threads.
+ */
+#define SUBOP_TEXT	5
+
+static const char *display_subop( word v, char *subop ) {
 	if( v > 7 ) return( "Unknown" );
 	subop[ 0 ] = '%';
 	subop[ 1 ] = BOOL( v & 4 )? '1': '0';
@@ -87,8 +92,9 @@ static const char *display_subop( word v ) {
 	return( subop );
 }
 
-static void display_definition( opcode *op ) {
+static void display_definition( FILE *to, opcode *op ) {
 	component	mods[ MAXIMUM_MODIFIERS ], *m;
+	char		subop[ SUBOP_TEXT ];
 	int		i;
 	word		w;
 
@@ -96,11 +102,11 @@ static void display_definition( opcode *op ) {
 	 *	Simply dump the content of the encoding table.
 	 */
 	expand_modifier( op->mods, mods, MAXIMUM_MODIFIERS );
-	for( m = mods; *m != nothing; printf( "%s ", component_text( *m++ )));
-	printf( "%s, ", component_text( op->op ));
+	for( m = mods; *m != nothing; fprintf( to, "%s ", component_text( *m++ )));
+	fprintf( to, "%s, ", component_text( op->op ));
 	for( i = 0; i < op->args; i++ ) {
-		printf( "," );
-		show_ea_bitmap( op->arg[ i ]);
+		fprintf( to, "," );
+		show_ea_bitmap( to, op->arg[ i ]);
 	}
 	for( i = 0; i < op->encoded; i++ ) {
 		w = op->encode[ i ];
@@ -114,7 +120,7 @@ static void display_definition( opcode *op ) {
 				 *
 				 *	SB(v)		v = value to add to instruction
 				 */
-				printf( ", SB(val=$%02X)", SB_VALUE( w ));
+				fprintf( to, ", SB(val=$%02X)", SB_VALUE( w ));
 				break;
 			}
 			case IDS_ACT: {
@@ -129,7 +135,7 @@ static void display_definition( opcode *op ) {
 				 *					1:Unsigned
 				 *					2:Signed
 				 */
-				printf( ", IDS(arg=%d,sign=%s)", IDS_ARG( w ), display_sign( IDS_SIGN( w )));
+				fprintf( to, ", IDS(arg=%d,sign=%s)", IDS_ARG( w ), display_sign( IDS_SIGN( w )));
 				break;
 			}
 			case FDS_ACT: {
@@ -147,7 +153,7 @@ static void display_definition( opcode *op ) {
 				 *					1:Unsigned
 				 *					2:Signed
 				 */
-				printf( ", FDS(size=%s,sign=%s)", display_sizing( FDS_SIZE( w )), display_sign( FDS_SIGN( w )));
+				fprintf( to, ", FDS(size=%s,sign=%s)", display_sizing( FDS_SIZE( w )), display_sign( FDS_SIGN( w )));
 				break;
 			}
 			case IMM_ACT: {
@@ -160,7 +166,7 @@ static void display_definition( opcode *op ) {
 				 *
 				 *	IMM(a)		a = Argument Number
 				 */
-				printf( ", IMM(arg=%d)", IMM_ARG( w ));
+				fprintf( to, ", IMM(arg=%d)", IMM_ARG( w ));
 				break;
 			}
 			case EA_ACT: {
@@ -173,7 +179,7 @@ static void display_definition( opcode *op ) {
 				 *	EA(r,a)		r = argument that is the register component
 				 *			a = argument number where the EA can be found
 				 */
-				printf( ", EA(reg_arg=%d,ea_arg=%d)", EA_REG( w ), EA_EADRS( w ));
+				fprintf( to, ", EA(reg_arg=%d,ea_arg=%d)", EA_REG( w ), EA_EADRS( w ));
 				break;
 			}
 			case EAO_ACT: {
@@ -186,7 +192,7 @@ static void display_definition( opcode *op ) {
 				 *	EAO(o,a)	o = 3 bit opcode to insert into the byte
 				 *			a = argument number where the EA can be found
 				 */
-				printf( ", EAO(opcode=%s,ea_arg=%d)", display_subop( EAO_OPCODE( w )), EAO_EADRS( w ));
+				fprintf( to, ", EAO(opcode=%s,ea_arg=%d)", display_subop( EAO_OPCODE( w ), subop ), EAO_EADRS( w ));
 				break;
 			}
 			case SDS_ACT: {
@@ -199,7 +205,7 @@ static void display_definition( opcode *op ) {
 				 *	SDS(i,b)	i = index into machine instruction (0..7)
 				 *			b = bit number in byte (0..7)
 				 */
-				printf( ", SDS(byte=%d,bit=%d)", SDS_INDEX( w ), SDS_BIT( w ));
+				fprintf( to, ", SDS(byte=%d,bit=%d)", SDS_INDEX( w ), SDS_BIT( w ));
 				break;
 			}
 			case SDR_ACT: {
@@ -214,7 +220,7 @@ static void display_definition( opcode *op ) {
 				 *			i = index into machine instruction (0..7)
 				 *			b = bit number in byte (0..7)
 				 */
-				printf( ", SDR(dir:%s,byte=%d,bit=%d)", display_direct( SDR_DIR( w )), SDR_INDEX( w ), SDR_BIT( w ));
+				fprintf( to, ", SDR(dir:%s,byte=%d,bit=%d)", display_direct( SDR_DIR( w )), SDR_INDEX( w ), SDR_BIT( w ));
 				break;
 			}
 			case REG_ACT: {
@@ -229,7 +235,7 @@ static void display_definition( opcode *op ) {
 				 *			i = index into machine instruction (0..7)
 				 *			b = bit number in byte (0..7)
 				 */
-				printf( ", REG(arg=%d,byte=%d,bit=%d)", REG_ARG( w ), REG_INDEX( w ), REG_BIT( w ));
+				fprintf( to, ", REG(arg=%d,byte=%d,bit=%d)", REG_ARG( w ), REG_INDEX( w ), REG_BIT( w ));
 				break;
 			}
 			case ESC_ACT: {
@@ -241,7 +247,7 @@ static void display_definition( opcode *op ) {
 				 *
 				 *	ESC(a)		a = Argument number of immediate data
 				 */
-				printf( ", ESC(arg=%d)", ESC_ARG( w ));
+				fprintf( to, ", ESC(arg=%d)", ESC_ARG( w ));
 				break;
 			}
 			case REL_ACT: {
@@ -260,12 +266,24 @@ static void display_definition( opcode *op ) {
 				 *			i = index of code to adjust for word disp
 				 *			b = bit in index byte to flip.
 				 */
-				printf( ", REL(arg=%d,range=%s,byte=%d,bit=%d)", REL_ARG( w ), display_range( REL_RANGE( w )), REL_INDEX( w ), REL_BIT( w ));
+				fprintf( to, ", REL(arg=%d,range=%s,byte=%d,bit=%d)", REL_ARG( w ), display_range( REL_RANGE( w )), REL_INDEX( w ), REL_BIT( w ));
+				break;
+			}
+			case SXI_ACT: {
+				/*
+				 *	Sign eXtended Immediate (Action 11)
+				 *
+				 *	Encode immediate data as a single byte which the CPU
+				 *	sign extends to a word.
+				 *
+				 *	SXI(a)		a = Argument number of immediate data
+				 */
+				fprintf( to, ", SXI(arg=%d)", SXI_ARG( w ));
 				break;
 			}
 			case TER_ACT: {
 				/*
-				 *	TEst Register (Action 11)
+				 *	TEst Register (Action 13)
 				 *
 				 *	Check that the argument specified is, (or is not) a specified
 				 *	register.
@@ -274,12 +292,12 @@ static void display_definition( opcode *op ) {
 				 *			p = condition result required to pass
 				 *			r = register specification
 				 */
-				printf( ", TER(arg=%d,pass=%d,reg=%d)", TER_ARG( w ), TER_PASS( w ), TER_REG( w ));
+				fprintf( to, ", TER(arg=%d,pass=%d,reg=%d)", TER_ARG( w ), TER_PASS( w ), TER_REG( w ));
 				break;
 			}
 			case VDS_ACT: {
 				/*
-				 *	Verify Data Size (Action 11)
+				 *	Verify Data Size (Action 12)
 				 *
 				 *	Check that the argument specified has the compatible size
 				 *	configuration as the size data recorded in the constructed
@@ -287,34 +305,23 @@ static void display_definition( opcode *op ) {
 				 *
 				 *	VDS(a)		a = Argument number of immediate data
 				 */
-				printf( ", VDS(arg=%d)", VDS_ARG( w ));
+				fprintf( to, ", VDS(arg=%d)", VDS_ARG( w ));
 				break;
 			}
 			default: {
-				printf( ", Unknown($%04X)", w );
+				fprintf( to, ", Unknown($%04X)", w );
 				break;
 			}
 		}
 	}
-	printf( "\n" );
 }
 
-static void display_instruction( boolean show_more, char *flags, component *mods, opcode *op, ea_breakdown *arg, instruction *mc ) {
+static void display_text( FILE *to, boolean show_more, char *flags, component *mods, opcode *op, ea_breakdown *arg ) {
 	int	i, j;
 	
-	/*
-	 *	Dump the hexidecimal code first
-	 */
-	j = HEX_DUMP_COLS;
-	for( i = 0; i < mc->coded; i++ ) {
-		printf( "%02X ", mc->code[ i ]);
-		j -= 3;
-	}
-	while( j-- > 0 ) printf( " " );
-	printf( ";" );
-	if( show_more ) printf( "[%s]\t", flags );
-	while( *mods != nothing ) printf( "%s ", component_text( *mods++ ));
-	printf( "%s ", component_text( op->op ));
+	if( show_more ) fprintf( to, "[%s]\t", flags );
+	while( *mods != nothing ) fprintf( to, "%s ", component_text( *mods++ ));
+	fprintf( to, "%s ", component_text( op->op ));
 	for( i = 0; i < op->args; i++ ) {
 		component	arg_mods[ MAXIMUM_MODIFIERS ];
 		boolean		has_imm,
@@ -322,9 +329,9 @@ static void display_instruction( boolean show_more, char *flags, component *mods
 				has_far,
 				add_add;
 		
-		if( i ) printf( ", " );
+		if( i ) fprintf( to, ", " );
 		expand_modifier( arg[ i ].mod, arg_mods, MAXIMUM_MODIFIERS );
-		for( j = 0; arg_mods[ j ] != nothing; printf( "%s ", component_text( arg_mods[ j++ ])));
+		for( j = 0; arg_mods[ j ] != nothing; fprintf( to, "%s ", component_text( arg_mods[ j++ ])));
 		
 		has_imm = BOOL( arg[ i ].ea & (	ea_immediate |		ea_far_immediate |
 						ea_indirect |		ea_far_indirect |
@@ -349,26 +356,25 @@ static void display_instruction( boolean show_more, char *flags, component *mods
 						ea_index_disp |		ea_far_index_disp |
 						ea_base_index_disp |	ea_far_base_index_disp ));
 
-		if( has_far ) printf( "far " );
-		if( has_ind ) printf( "[" );
+		if( has_far ) fprintf( to, "far " );
+		if( has_ind ) fprintf( to, "[" );
 		for( j = 0; j < arg[ i ].registers; j++ ) {
-			if( j ) printf( "+" );
-			printf( "%s", component_text( arg[ i ].reg[ j ]->comp ));
+			if( j ) fprintf( to, "+" );
+			fprintf( to, "%s", component_text( arg[ i ].reg[ j ]->comp ));
 		}
 		if( has_imm ) {
 			char	s[ BUFFER_FOR_SCOPE ];
 			
 			s[ convert_scope_to_text( TRUE, arg[ i ].immediate_arg.scope, s, BUFFER_FOR_SCOPE-1 )] = EOS;
 			if( add_add ) {
-				printf( "+{%s}", s );
+				fprintf( to, "+{%s}", s );
 			}
 			else {
-				printf( "{%s}", s );
+				fprintf( to, "{%s}", s );
 			}
 		}
-		if( has_ind ) printf( "]" );
+		if( has_ind ) fprintf( to, "]" );
 	}
-	printf( "\n" );
 }
 
 /*
@@ -394,13 +400,7 @@ static component segment_register[ SEGMENT_REGISTERS ] = {
 };
 
 
-typedef struct {
-	effective_address	map,
-				pick;
-	byte			step;
-} ea_state;
-
-static boolean init_ea_state( ea_state *state, effective_address source ) {
+boolean init_ea_state( ea_state *state, effective_address source ) {
 
 	ASSERT( state != NIL( ea_state ));
 
@@ -410,7 +410,7 @@ static boolean init_ea_state( ea_state *state, effective_address source ) {
 	return( state->map != ea_empty );
 }
 
-static boolean next_ea_state( ea_state *state, ea_breakdown *target ) {
+boolean next_ea_state( ea_state *state, ea_breakdown *target ) {
 
 	ASSERT( state != NIL( ea_state ));
 	ASSERT( target != NIL( ea_breakdown ));
@@ -705,68 +705,293 @@ static boolean next_ea_state( ea_state *state, ea_breakdown *target ) {
 
 
 /*
- *	Full dump of everything
+ *	The instructions generated from a single entry of the
+ *	opcode table.  The text of the entry's definition, then
+ *	that of each instruction, is held (EOS terminated) in a
+ *	single buffer.
+ */
+typedef struct {
+	int		text;				/* Offset of the text in the buffer */
+	byte		coded,
+			code[ MAX_CODE_BYTES ];
+} dumped_instruction;
+
+typedef struct {
+	char			*text;
+	size_t			size;
+	dumped_instruction	*inst;
+	int			count,
+				max;
+} dumped_entry;
+
+/*
+ *	The state shared by the threads dumping the table.
+ */
+typedef struct {
+	dumped_entry		*entry;
+	int			entries;
+	atomic_int		next;
+	boolean			show_more;
+	command_flag		flags;
+	mnemonic_flags		parameters;
+} dump_state;
+
+/*
+ *	Record an instruction (if it encodes) for an entry.
  */
-void dump_opcode_list( boolean show_more ) {
-	opcode		*op;
+static void dump_instruction( FILE *to, dumped_entry *entry, boolean show_more, char *opflags, component *mods, opcode *op, ea_breakdown *arg ) {
+	instruction		mc;
+	dumped_instruction	*d;
+
+	if( !assemble_inst( op, no_prefix, arg, &mc )) return;
+	if( entry->count == entry->max ) {
+		entry->max = entry->max? entry->max * 2: DUMP_INSTRUCTIONS;
+		entry->inst = RESIZE_ARRAY( entry->inst, dumped_instruction, entry->max );
+	}
+	d = &( entry->inst[ entry->count++ ]);
+	d->text = (int)ftell( to );
+	d->coded = mc.coded;
+	memcpy( d->code, mc.code, mc.coded );
+	display_text( to, show_more, opflags, mods, op, arg );
+	fputc( EOS, to );
+}
+
+/*
+ *	Generate all of the instructions of a single entry.
+ */
+static void dump_entry( dumped_entry *entry, opcode *op, boolean show_more ) {
 	component	mods[ MAXIMUM_MODIFIERS ];
 	char		opflags[ MAXIMUM_FLAGS ];
-	int		i;
-	instruction	mc;
 	ea_breakdown	arg[ MAX_OPCODE_ARGS ];
-
-	printf( "Opcode List:-\n" );
-	for( op = opcodes; op->op != nothing; op++ ) {
-		for( i = 0; i < HEX_DUMP_COLS; i++ ) printf( " " );
-		printf( "; " );
-		display_definition( op );
-		/*
-		 *	Gather common elements of all instructions.
-		 */
-		expand_mnemonic_flags( op->flags, opflags, MAXIMUM_FLAGS );
-		expand_modifier( op->mods, mods, MAXIMUM_MODIFIERS );
-		/*
-		 *	Encode the instruction described
-		 */
-		switch( op->args ) {
-			case 0: {
-				/*
-				 *	No arguments.
-				 */
-				if( assemble_inst( op, no_prefix, arg, &mc )) display_instruction( show_more, opflags, mods, op, arg, &mc );
-				break;
-			}
-			case 1: {
-				ea_state	foreach;
-				
-				if( init_ea_state( &foreach, op->arg[ 0 ])) {
-					while( next_ea_state( &foreach, &( arg[ 0 ]))) {
-						if( assemble_inst( op, no_prefix, arg, &mc )) display_instruction( show_more, opflags, mods, op, arg, &mc );
-					}
+	FILE		*to;
+
+	entry->text = NIL( char );
+	entry->size = 0;
+	entry->inst = NIL( dumped_instruction );
+	entry->count = 0;
+	entry->max = 0;
+	if(( to = open_memstream( &( entry->text ), &( entry->size ))) == NIL( FILE )) {
+		log_error( "Unable to create dump buffer" );
+		return;
+	}
+	display_definition( to, op );
+	fputc( EOS, to );
+	/*
+	 *	Gather common elements of all instructions.
+	 */
+	expand_mnemonic_flags( op->flags, opflags, MAXIMUM_FLAGS );
+	expand_modifier( op->mods, mods, MAXIMUM_MODIFIERS );
+	/*
+	 *	Encode the instruction described
+	 */
+	switch( op->args ) {
+		case 0: {
+			/*
+			 *	No arguments.
+			 */
+			dump_instruction( to, entry, show_more, opflags, mods, op, arg );
+			break;
+		}
+		case 1: {
+			ea_state	foreach;
+			
+			if( init_ea_state( &foreach, op->arg[ 0 ])) {
+				while( next_ea_state( &foreach, &( arg[ 0 ]))) {
+					dump_instruction( to, entry, show_more, opflags, mods, op, arg );
 				}
-				break;
 			}
-			case 2: {
-				ea_state	foreach_1,
-						foreach_2;
-				
-				if( init_ea_state( &foreach_1, op->arg[ 0 ])) {
-					while( next_ea_state( &foreach_1, &( arg[ 0 ]))) {
-						if( init_ea_state( &foreach_2, op->arg[ 1 ])) {
-							while( next_ea_state( &foreach_2, &( arg[ 1 ]))) {
-								if( assemble_inst( op, no_prefix, arg, &mc )) display_instruction( show_more, opflags, mods, op, arg, &mc );
-							}
+			break;
+		}
+		case 2: {
+			ea_state	foreach_1,
+					foreach_2;
+			
+			if( init_ea_state( &foreach_1, op->arg[ 0 ])) {
+				while( next_ea_state( &foreach_1, &( arg[ 0 ]))) {
+					if( init_ea_state( &foreach_2, op->arg[ 1 ])) {
+						while( next_ea_state( &foreach_2, &( arg[ 1 ]))) {
+							dump_instruction( to, entry, show_more, opflags, mods, op, arg );
 						}
 					}
 				}
-				break;
-			}
-			default: {
-				log_error( "Argument count error" );
-				break;
 			}
+			break;
+		}
+		default: {
+			log_error( "Argument count error" );
+			break;
+		}
+	}
+	fclose( to );
+}
+
+/*
+ *	Take entries from the table until there are none left;
+ *	run on each thread in a context of its own.
+ */
+static void *dump_entries( void *data ) {
+	dump_state		*state = (dump_state *)data;
+	assembler_context	*context,
+				*previous;
+	int			e;
+
+	context = new_context();
+	previous = select_context( context );
+	command_flags = state->flags;
+	assembler_parameters = state->parameters;
+	this_pass = data_verification;
+	while(( e = atomic_fetch_add( &( state->next ), 1 )) < state->entries ) dump_entry( &( state->entry[ e ]), &( opcodes[ e ]), state->show_more );
+	delete_context( context );
+	(void)select_context( previous );
+	return( NIL( void ));
+}
+
+/*
+ *	Write out the entries as text.
+ */
+static void write_dump_text( FILE *to, dump_state *state ) {
+	dumped_entry		*entry;
+	dumped_instruction	*d;
+	int			e, i, j;
+
+	fprintf( to, "Opcode List:-\n" );
+	for( e = 0; e < state->entries; e++ ) {
+		entry = &( state->entry[ e ]);
+		if( entry->text == NIL( char )) continue;
+		fprintf( to, "%*s; %s\n", HEX_DUMP_COLS, "", entry->text );
+		for( i = 0; i < entry->count; i++ ) {
+			d = &( entry->inst[ i ]);
+			for( j = 0; j < d->coded; j++ ) fprintf( to, "%02X ", d->code[ j ]);
+			j *= 3;
+			while( j++ < HEX_DUMP_COLS ) fputc( SPACE, to );
+			fprintf( to, ";%s\n", entry->text + d->text );
+		}
+	}
+}
+
+/*
+ *	Write a 16 or 32 bit value, least significant byte first.
+ */
+static void put_dump_word( FILE *to, unsigned int v ) {
+	fputc( v & 0xff, to );
+	fputc(( v >> 8 ) & 0xff, to );
+}
+
+static void put_dump_long( FILE *to, unsigned long v ) {
+	put_dump_word( to, v & 0xffff );
+	put_dump_word( to, ( v >> 16 ) & 0xffff );
+}
+
+/*
+ *	Write out the entries in the binary form described in
+ *	dump.h, returning FALSE if this fails.
+ */
+static boolean write_dump_binary( char *name, dump_state *state ) {
+	dumped_entry	*entry;
+	FILE		*to;
+	unsigned long	text,
+			first,
+			records;
+	boolean		ok;
+	int		e, i, j;
+
+	if(( to = fopen( name, "wb" )) == NIL( FILE )) {
+		log_error_s( "Unable to create file", name );
+		return( FALSE );
+	}
+	records = 0;
+	text = 0;
+	for( e = 0; e < state->entries; e++ ) {
+		records += state->entry[ e ].count;
+		text += state->entry[ e ].size;
+	}
+	fwrite( DUMP_MAGIC, 1, DUMP_MAGIC_SIZE, to );
+	put_dump_long( to, DUMP_VERSION );
+	put_dump_long( to, state->entries );
+	put_dump_long( to, records );
+	put_dump_long( to, text );
+	/*
+	 *	The entries.
+	 */
+	text = 0;
+	first = 0;
+	for( e = 0; e < state->entries; e++ ) {
+		entry = &( state->entry[ e ]);
+		put_dump_word( to, opcodes[ e ].op );
+		put_dump_word( to, opcodes[ e ].args );
+		put_dump_long( to, opcodes[ e ].flags );
+		put_dump_long( to, text );
+		put_dump_long( to, first );
+		put_dump_long( to, entry->count );
+		text += entry->size;
+		first += entry->count;
+	}
+	/*
+	 *	The instructions.
+	 */
+	text = 0;
+	for( e = 0; e < state->entries; e++ ) {
+		entry = &( state->entry[ e ]);
+		for( i = 0; i < entry->count; i++ ) {
+			put_dump_long( to, e );
+			put_dump_long( to, text + entry->inst[ i ].text );
+			fputc( entry->inst[ i ].coded, to );
+			for( j = 0; j < DUMP_CODE_BYTES; j++ ) fputc(( j < entry->inst[ i ].coded )? entry->inst[ i ].code[ j ]: 0, to );
 		}
+		text += entry->size;
+	}
+	/*
+	 *	The text.
+	 */
+	for( e = 0; e < state->entries; e++ ) if( state->entry[ e ].size ) fwrite( state->entry[ e ].text, 1, state->entry[ e ].size, to );
+	ok = !ferror( to );
+	if( fclose( to )) ok = FALSE;
+	return( ok );
+}
+
+/*
+ *	Full dump of everything
+ */
+boolean dump_opcode_list( boolean show_more, int threads, char *binary ) {
+	dump_state	state;
+	pthread_t	*thread;
+	boolean		ok;
+	int		i, started;
+
+	for( state.entries = 0; opcodes[ state.entries ].op != nothing; state.entries++ );
+	state.entry = NEW_ARRAY( dumped_entry, state.entries );
+	atomic_init( &( state.next ), 0 );
+	state.show_more = show_more;
+	state.flags = command_flags;
+	state.parameters = assembler_parameters;
+	/*
+	 *	The entries are shared out between the threads as
+	 *	each becomes free, the results are put back in table
+	 *	order as they are written.
+	 */
+	if( threads < 1 ) threads = 1;
+	thread = NEW_ARRAY( pthread_t, threads );
+	started = 0;
+	for( i = 1; i < threads; i++ ) {
+		if( pthread_create( &( thread[ i ]), NULL, dump_entries, &state ) != 0 ) break;
+		started++;
+	}
+	(void)dump_entries( &state );
+	for( i = 1; i <= started; i++ ) (void)pthread_join( thread[ i ], NULL );
+	FREE( thread );
+	if( binary != NIL( char )) {
+		ok = write_dump_binary( binary, &state );
 	}
+	else {
+		write_dump_text( stdout, &state );
+		ok = !ferror( stdout );
+	}
+	for( i = 0; i < state.entries; i++ ) {
+		free( state.entry[ i ].text );		/* From open_memstream() */
+		if( state.entry[ i ].inst ) FREE( state.entry[ i ].inst );
+	}
+	FREE( state.entry );
+	return( ok );
 }
 
 /*
@@ -777,7 +1002,10 @@ void dump_opcode_table( void ) {
 	 *	Simply dump the content of the encoding table.
 	 */
 	printf( "Opcode Table:-\n" );
-	for( opcode *op = opcodes; op->op != nothing; display_definition( op++ ));
+	for( opcode *op = opcodes; op->op != nothing; op++ ) {
+		display_definition( stdout, op );
+		printf( "\n" );
+	}
 }
 
 #endif
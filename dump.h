@@ -30,9 +30,64 @@
 #ifdef VERIFICATION
 
 /*
- *	Full dump of everything
+ *	The binary form of the full dump, intended to be mapped
+ *	directly into memory by an external validator.  All values
+ *	are held least significant byte first:
+ *
+ *	Header (24 bytes)
+ *		magic[8]	DUMP_MAGIC
+ *		version		32 bits, DUMP_VERSION
+ *		entries		32 bits, entries in the opcode table
+ *		records		32 bits, instructions generated
+ *		text		32 bits, bytes of text
+ *
+ *	Entry (20 bytes each, in table order, following the header)
+ *		op		16 bits, the mnemonic component
+ *		args		16 bits, arguments taken
+ *		flags		32 bits, the mnemonic flags
+ *		definition	32 bits, offset of the definition text
+ *		first		32 bits, index of the first instruction
+ *		count		32 bits, instructions generated
+ *
+ *	Instruction (16 bytes each, in table order, following the
+ *	entries)
+ *		entry		32 bits, index of the source entry
+ *		text		32 bits, offset of the instruction text
+ *		coded		8 bits, bytes of machine code
+ *		code[7]		the machine code, zero padded
+ *
+ *	Text (following the instructions) made up of EOS terminated
+ *	strings matching those of the text form of the dump.
+ */
+#define DUMP_MAGIC		"I86OPDMP"
+#define DUMP_MAGIC_SIZE		8
+#define DUMP_VERSION		1
+#define DUMP_CODE_BYTES		7
+
+/*
+ *	The state of a walk through an example of each of the
+ *	effective addresses in a set.  Having been initialised
+ *	(which returns FALSE if the set is empty) each call to
+ *	next_ea_state() fills in the next example, returning FALSE
+ *	once there are no more.
+ */
+typedef struct {
+	effective_address	map,
+				pick;
+	byte			step;
+} ea_state;
+
+extern boolean init_ea_state( ea_state *state, effective_address source );
+extern boolean next_ea_state( ea_state *state, ea_breakdown *target );
+
+/*
+ *	Full dump of everything, the entries of the opcode table
+ *	are shared between the number of threads given and the
+ *	result written (in table order) as text to stdout or, if
+ *	binary is not NIL, in binary form to the file named.
+ *	Returns FALSE if the dump could not be written.
  */
-extern void dump_opcode_list( boolean show_more );
+extern boolean dump_opcode_list( boolean show_more, int threads, char *binary );
 
 /*
  *	Basic dump of each entry in the opcode table.
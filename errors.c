@@ -26,29 +26,106 @@
 #include "os.h"
 #include "includes.h"
 
+/*
+ *	Return the stream errors are reported on.
+ */
+FILE *error_stream( void ) {
+	if(( this_context == NIL( assembler_context ))||( this_context->errors.stream == NIL( FILE ))) return( stderr );
+	return( this_context->errors.stream );
+}
+
+/*
+ *	Set (or clear with NIL) the stream errors are reported
+ *	on for the current context.
+ */
+void set_error_stream( FILE *to ) {
+	ASSERT( this_context != NIL( assembler_context ));
+
+	this_context->errors.stream = to;
+}
+
+/*
+ *	Return the stream reports are written on.
+ */
+FILE *report_stream( void ) {
+	if(( this_context == NIL( assembler_context ))||( this_context->errors.report == NIL( FILE ))) return( stdout );
+	return( this_context->errors.report );
+}
+
+/*
+ *	Set (or clear with NIL) the stream reports are written
+ *	on for the current context.
+ */
+void set_report_stream( FILE *to ) {
+	ASSERT( this_context != NIL( assembler_context ));
+
+	this_context->errors.report = to;
+}
+
+/*
+ *	Set (or clear) the suppression of errors for the current
+ *	context.
+ */
+boolean quiet_errors( boolean quiet ) {
+	boolean	was;
+
+	ASSERT( this_context != NIL( assembler_context ));
+
+	was = this_context->errors.quiet;
+	this_context->errors.quiet = quiet;
+	return( was );
+}
+
+/*
+ *	Errors are not reported while suppressed.
+ */
+#define QUIETENED	(( this_context != NIL( assembler_context ))&& this_context->errors.quiet )
+
 void log_error( const char *msg ) {
-	error_is_at( stderr );
-	fprintf( stderr, "E: %s\n", msg );
+	FILE	*to = error_stream();
+
+	if( QUIETENED ) return;
+	error_is_at( to );
+	fprintf( to, "E: %s\n", msg );
 }
 
 void log_error_i( const char *msg, integer i ) {
-	error_is_at( stderr );
-	fprintf( stderr, "E: %s (%d)\n", msg, (int)i );
+	FILE	*to = error_stream();
+
+	if( QUIETENED ) return;
+	error_is_at( to );
+	fprintf( to, "E: %s (%d)\n", msg, (int)i );
 }
 
 void log_error_c( const char *msg, char c ) {
-	error_is_at( stderr );
-	fprintf( stderr, "E: %s ('%c')\n", msg, c );
+	FILE	*to = error_stream();
+
+	if( QUIETENED ) return;
+	error_is_at( to );
+	fprintf( to, "E: %s ('%c')\n", msg, c );
 }
 
 void log_error_s( const char *msg, char *s ) {
-	error_is_at( stderr );
-	fprintf( stderr, "E: %s (%s)\n", msg, s );
+	FILE	*to = error_stream();
+
+	if( QUIETENED ) return;
+	error_is_at( to );
+	fprintf( to, "E: %s (%s)\n", msg, s );
 }
 
 void log_error_si( const char *msg, char *s, integer i ) {
-	error_is_at( stderr );
-	fprintf( stderr, "E: %s (%s,%d)\n", msg, s, (int)i );
+	FILE	*to = error_stream();
+
+	if( QUIETENED ) return;
+	error_is_at( to );
+	fprintf( to, "E: %s (%s,%d)\n", msg, s, (int)i );
+}
+
+/*
+ *	Pass on diagnostics captured elsewhere.
+ */
+void log_text( char *text, int len ) {
+	fwrite( text, 1, len, error_stream());
 }
 
 /*
@@ -26,12 +26,51 @@
 #ifndef _ERRORS_H_
 #define _ERRORS_H_
 
+/*
+ *	Where errors are reported, held in the assembler context.
+ *	If no stream has been set errors go to stderr.  Reports
+ *	and verbose output go to stdout unless a stream has been
+ *	set for them too.
+ */
+typedef struct {
+	FILE		*stream,
+			*report;
+	boolean		quiet;
+} errors_context;
+
+extern void set_error_stream( FILE *to );
+
+/*
+ *	Return the stream errors are reported on for the current
+ *	context (stderr if none has been set).
+ */
+extern FILE *error_stream( void );
+
+/*
+ *	Set (or clear with NIL) the stream reports and verbose
+ *	output are written on for the current context, and return
+ *	that stream (stdout if none has been set).
+ */
+extern void set_report_stream( FILE *to );
+extern FILE *report_stream( void );
+
+/*
+ *	Set (or clear) the suppression of errors while an
+ *	alternative is tried, returning the previous setting.
+ */
+extern boolean quiet_errors( boolean quiet );
+
 extern void log_error( const char *msg );
 extern void log_error_i( const char *msg, integer i );
 extern void log_error_c( const char *msg, char c );
 extern void log_error_s( const char *msg, char *s );
 extern void log_error_si( const char *msg, char *s, integer i );
 
+/*
+ *	Pass on diagnostics captured elsewhere (on another thread).
+ */
+extern void log_text( char *text, int len );
+
 #endif
 
 /*
@@ -369,6 +369,7 @@ boolean evaluate( token_record *expr, int len, int *consumed, constant_value *v,
 	int		vtop, otop, used;
 	boolean		atom;
 
+	pass_stats.evaluations++;
 	vtop = 0;
 	otop = 0;
 	used = 0;
@@ -445,7 +446,7 @@ boolean evaluate( token_record *expr, int len, int *consumed, constant_value *v,
 						vtop++;
 					}
 					else {
-						value_stack[ vtop++ ] = expr->var.label->var.value;
+						get_label_value( expr->var.label, &( value_stack[ vtop++ ]));
 					}
 					atom = FALSE;
 					break;
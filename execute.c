@@ -0,0 +1,1676 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	execute
+ *	=======
+ *
+ *	A headless 8086/80186 interpreter used to check that the
+ *	'.COM' files produced behave as intended.
+ *
+ *	Instructions are decoded by the same table driven decoder
+ *	as the disassembler and then translated into a compact
+ *	form held in a cache keyed by CS:IP.  Memory is divided
+ *	into pages, and a write into a page holding any cached
+ *	instruction advances the generation of that page making
+ *	those instructions stale, so self modifying code is seen.
+ *
+ *	Just enough of DOS is provided (through INT 20h and 21h)
+ *	for a program to write to the console, read its input,
+ *	work on files within a sandbox directory and exit with
+ *	a status.
+ */
+
+#include "os.h"
+#include "includes.h"
+
+#ifdef EXECUTION
+
+/*
+ *	The machine has the full 1 MByte address space, the
+ *	program being loaded at EXECUTE_ORIGIN in the segment
+ *	EXECUTE_SEGMENT following its program segment prefix.
+ */
+#define EXECUTE_MEMORY		0x100000
+#define EXECUTE_SEGMENT		0x1000
+#define EXECUTE_ORIGIN		0x100
+#define EXECUTE_TOP		0xA000
+#define EXECUTE_LARGEST		( 0x10000 - EXECUTE_ORIGIN - 2 )
+
+/*
+ *	Decoded instructions are held in EXECUTE_CACHE entries (a
+ *	power of two) and memory is split into pages of 1 <<
+ *	EXECUTE_PAGE_SHIFT bytes for invalidating them.  At most
+ *	EXECUTE_FETCH bytes are offered to the decoder.
+ */
+#define EXECUTE_CACHE		8192
+#define EXECUTE_PAGE_SHIFT	8
+#define EXECUTE_PAGES		( EXECUTE_MEMORY >> EXECUTE_PAGE_SHIFT )
+#define EXECUTE_FETCH		16
+
+/*
+ *	DOS file handles (the first few being the standard
+ *	devices) and the longest file name accepted.
+ */
+#define EXECUTE_HANDLES		20
+#define EXECUTE_FIRST_FILE	5
+#define EXECUTE_NAME		128
+
+/*
+ *	The number of instructions a program may execute unless
+ *	given otherwise.
+ */
+#define EXECUTE_STEPS		100000000
+
+/*
+ *	The bits of the flags register.
+ */
+#define FLAG_CF			0x0001
+#define FLAG_PF			0x0004
+#define FLAG_AF			0x0010
+#define FLAG_ZF			0x0040
+#define FLAG_SF			0x0080
+#define FLAG_TF			0x0100
+#define FLAG_IF			0x0200
+#define FLAG_DF			0x0400
+#define FLAG_OF			0x0800
+#define FLAGS_USED		0x0FD5
+#define FLAGS_FIXED		0xF002
+
+/*
+ *	DOS error codes returned with the carry flag set.
+ */
+#define DOS_BAD_FUNCTION	1
+#define DOS_NOT_FOUND		2
+#define DOS_NO_HANDLES		4
+#define DOS_DENIED		5
+#define DOS_BAD_HANDLE		6
+
+/*
+ *	Form an address in the 1 MByte space (wrapping as the
+ *	8086 does).
+ */
+#define LINEAR(s,o)		(((((dword)(s)) << 4 )+( o ))&( EXECUTE_MEMORY-1 ))
+
+/*
+ *	A register which is not there.
+ */
+#define NO_REGISTER		0xFF
+
+char *execute_sandbox = NIL( char );
+char *execute_steps = NIL( char );
+
+/*
+ *	The kinds of argument a translated instruction has.
+ */
+typedef enum {
+	arg_none,
+	arg_byte_reg,
+	arg_word_reg,
+	arg_segment_reg,
+	arg_immediate,
+	arg_memory
+} arg_kind;
+
+/*
+ *	How a string instruction is repeated.
+ */
+typedef enum {
+	repeat_none,
+	repeat_equal,
+	repeat_not_equal
+} repeat_kind;
+
+/*
+ *	An argument translated for execution.  Registers are held
+ *	by their number in the machine code and a memory address
+ *	as the sum of the value and up to two registers in the
+ *	segment given.
+ */
+typedef struct {
+	byte		kind,
+			base,
+			index,
+			segment;
+	word		value;
+} operand;
+
+/*
+ *	A decoded instruction, as cached.
+ */
+typedef struct {
+	boolean		valid;
+	word		cs,				/* Where it was decoded */
+			ip;
+	dword		page[ 2 ],			/* Pages of its first and last bytes */
+			generation[ 2 ];		/* and their generations at the time */
+	component	op;
+	byte		size,
+			args,
+			repeat;
+	boolean		wide,				/* Word (not byte) data */
+			far;				/* Far address or return */
+	word		far_segment;
+	operand		arg[ MAX_OPCODE_ARGS ];
+} cached_inst;
+
+/*
+ *	The whole of the machine.
+ */
+typedef struct {
+	char		*name;
+	byte		*memory;
+	word		reg[ 8 ],
+			seg[ SEGMENT_REGISTERS ],
+			ip,
+			flags,
+			at_cs,				/* The instruction being executed */
+			at_ip;
+	cached_inst	*cache;
+	dword		*generation;
+	byte		*holds_code;
+	int		handle[ EXECUTE_HANDLES ];
+	boolean		later_cpu,			/* 80186 rather than 8086 behaviour */
+			running,
+			faulted;
+	int		status;
+	unsigned long	steps,
+			limit,
+			cached;
+} machine;
+
+/*
+ *	Stop the machine, reporting why and where.
+ */
+static void fault( machine *m, const char *msg, int code ) {
+	char	where[ 64 + EXECUTE_NAME ];
+
+	if( code == ERROR ) {
+		snprintf( where, sizeof( where ), "%s %04X:%04X", m->name, m->at_cs, m->at_ip );
+	}
+	else {
+		snprintf( where, sizeof( where ), "%s %04X:%04X %02Xh", m->name, m->at_cs, m->at_ip, code );
+	}
+	log_error_s( msg, where );
+	m->running = FALSE;
+	m->faulted = TRUE;
+}
+
+/*
+ *	Stop the machine as the program asked.
+ */
+static void exit_program( machine *m, int status ) {
+	m->status = status;
+	m->running = FALSE;
+}
+
+/*
+ *	Registers.
+ */
+static word byte_reg( machine *m, int r ) {
+	return(( r < 4 )?( m->reg[ r ] & 0xFF ):( m->reg[ r-4 ] >> 8 ));
+}
+
+static void set_byte_reg( machine *m, int r, word v ) {
+	if( r < 4 ) {
+		m->reg[ r ] = ( m->reg[ r ] & 0xFF00 )|( v & 0xFF );
+	}
+	else {
+		m->reg[ r-4 ] = ( m->reg[ r-4 ] & 0x00FF )|(( v & 0xFF ) << 8 );
+	}
+}
+
+static void set_flag( machine *m, word f, boolean on ) {
+	if( on ) {
+		m->flags |= f;
+	}
+	else {
+		m->flags &= ~f;
+	}
+}
+
+/*
+ *	Memory, a write making any instructions cached from the
+ *	page written stale.
+ */
+static word read_data( machine *m, word s, word o, boolean wide ) {
+	if( !wide ) return( m->memory[ LINEAR( s, o )]);
+	return( m->memory[ LINEAR( s, o )]|( m->memory[ LINEAR( s, (word)( o+1 ))] << 8 ));
+}
+
+static void write_byte( machine *m, word s, word o, word v ) {
+	dword	a = LINEAR( s, o );
+
+	m->memory[ a ] = (byte)v;
+	a >>= EXECUTE_PAGE_SHIFT;
+	if( m->holds_code[ a ]) {
+		m->holds_code[ a ] = FALSE;
+		m->generation[ a ]++;
+	}
+}
+
+static void write_data( machine *m, word s, word o, boolean wide, word v ) {
+	write_byte( m, s, o, v );
+	if( wide ) write_byte( m, s, (word)( o+1 ), v >> 8 );
+}
+
+static void push( machine *m, word v ) {
+	m->reg[ REG_SP ] -= 2;
+	write_data( m, m->seg[ REG_SS ], m->reg[ REG_SP ], TRUE, v );
+}
+
+static word pop( machine *m ) {
+	word	v = read_data( m, m->seg[ REG_SS ], m->reg[ REG_SP ], TRUE );
+
+	m->reg[ REG_SP ] += 2;
+	return( v );
+}
+
+/*
+ *	Arguments.
+ */
+static word operand_offset( machine *m, operand *o ) {
+	word	a = o->value;
+
+	if( o->base != NO_REGISTER ) a += m->reg[ o->base ];
+	if( o->index != NO_REGISTER ) a += m->reg[ o->index ];
+	return( a );
+}
+
+static word get_operand( machine *m, operand *o, boolean wide ) {
+	switch( o->kind ) {
+		case arg_byte_reg:	return( byte_reg( m, o->base ));
+		case arg_word_reg:	return( m->reg[ o->base ]);
+		case arg_segment_reg:	return( m->seg[ o->base ]);
+		case arg_immediate:	return( o->value );
+		case arg_memory:	return( read_data( m, m->seg[ o->segment ], operand_offset( m, o ), wide ));
+		default:		break;
+	}
+	return( 0 );
+}
+
+static void set_operand( machine *m, operand *o, boolean wide, word v ) {
+	switch( o->kind ) {
+		case arg_byte_reg: {
+			set_byte_reg( m, o->base, v );
+			break;
+		}
+		case arg_word_reg: {
+			m->reg[ o->base ] = v;
+			break;
+		}
+		case arg_segment_reg: {
+			m->seg[ o->base ] = v;
+			break;
+		}
+		case arg_memory: {
+			write_data( m, m->seg[ o->segment ], operand_offset( m, o ), wide, v );
+			break;
+		}
+		default: {
+			break;
+		}
+	}
+}
+
+/*
+ *	Set the zero, sign and parity flags from a result.
+ */
+static void result_flags( machine *m, word v, boolean wide ) {
+	byte	p = (byte)v;
+
+	if( !wide ) v &= 0xFF;
+	p ^= p >> 4;
+	p ^= p >> 2;
+	p ^= p >> 1;
+	set_flag( m, FLAG_ZF, v == 0 );
+	set_flag( m, FLAG_SF, BOOL( v & ( wide? 0x8000: 0x80 )));
+	set_flag( m, FLAG_PF, !BOOL( p & 1 ));
+}
+
+/*
+ *	The two argument arithmetic and logical operations.
+ */
+static word arithmetic( machine *m, component op, word a, word b, boolean wide ) {
+	dword	mask = wide? 0xFFFF: 0xFF,
+		sign = wide? 0x8000: 0x80,
+		r, c;
+
+	a &= mask;
+	b &= mask;
+	switch( op ) {
+		case op_add:
+		case op_adc: {
+			c = (( op == op_adc )&& BOOL( m->flags & FLAG_CF ))? 1: 0;
+			r = (dword)a + b + c;
+			set_flag( m, FLAG_CF, r > mask );
+			set_flag( m, FLAG_OF, BOOL(( a ^ r )&( b ^ r )& sign ));
+			set_flag( m, FLAG_AF, BOOL(( a ^ b ^ r )& 0x10 ));
+			break;
+		}
+		case op_sub:
+		case op_sbb:
+		case op_cmp: {
+			c = (( op == op_sbb )&& BOOL( m->flags & FLAG_CF ))? 1: 0;
+			r = (dword)a - b - c;
+			set_flag( m, FLAG_CF, (dword)b + c > a );
+			set_flag( m, FLAG_OF, BOOL(( a ^ b )&( a ^ r )& sign ));
+			set_flag( m, FLAG_AF, BOOL(( a ^ b ^ r )& 0x10 ));
+			break;
+		}
+		default: {
+			switch( op ) {
+				case op_or:	r = a | b;	break;
+				case op_xor:	r = a ^ b;	break;
+				default:	r = a & b;	break;
+			}
+			m->flags &= ~( FLAG_CF | FLAG_OF | FLAG_AF );
+			break;
+		}
+	}
+	result_flags( m, (word)r, wide );
+	return( (word)( r & mask ));
+}
+
+/*
+ *	Shifts and rotates (of count places, flags being left alone
+ *	for a count of zero).
+ */
+static word shift( machine *m, component op, word v, int count, boolean wide ) {
+	word	sign = wide? 0x8000: 0x80,
+		mask = wide? 0xFFFF: 0xFF,
+		before;
+	boolean	cf = BOOL( m->flags & FLAG_CF ),
+		out;
+	int	i;
+
+	if( m->later_cpu ) count &= 0x1F;
+	if( count == 0 ) return( v );
+	v &= mask;
+	before = v;
+	for( i = 0; i < count; i++ ) {
+		before = v;
+		switch( op ) {
+			case op_rol: {
+				cf = BOOL( v & sign );
+				v = (( v << 1 )|( cf? 1: 0 ))& mask;
+				break;
+			}
+			case op_ror: {
+				cf = BOOL( v & 1 );
+				v = ( v >> 1 )|( cf? sign: 0 );
+				break;
+			}
+			case op_rcl: {
+				out = BOOL( v & sign );
+				v = (( v << 1 )|( cf? 1: 0 ))& mask;
+				cf = out;
+				break;
+			}
+			case op_rcr: {
+				out = BOOL( v & 1 );
+				v = ( v >> 1 )|( cf? sign: 0 );
+				cf = out;
+				break;
+			}
+			case op_shr: {
+				cf = BOOL( v & 1 );
+				v >>= 1;
+				break;
+			}
+			case op_sar: {
+				cf = BOOL( v & 1 );
+				v = ( v >> 1 )|( v & sign );
+				break;
+			}
+			default: {
+				cf = BOOL( v & sign );
+				v = ( v << 1 )& mask;
+				break;
+			}
+		}
+	}
+	set_flag( m, FLAG_CF, cf );
+	switch( op ) {
+		case op_ror:
+		case op_rcr: {
+			set_flag( m, FLAG_OF, BOOL( v & sign ) != BOOL( v & ( sign >> 1 )));
+			break;
+		}
+		case op_shr: {
+			set_flag( m, FLAG_OF, BOOL( before & sign ));
+			result_flags( m, v, wide );
+			break;
+		}
+		case op_sar: {
+			set_flag( m, FLAG_OF, FALSE );
+			result_flags( m, v, wide );
+			break;
+		}
+		case op_rol:
+		case op_rcl: {
+			set_flag( m, FLAG_OF, BOOL( v & sign ) != cf );
+			break;
+		}
+		default: {
+			set_flag( m, FLAG_OF, BOOL( v & sign ) != cf );
+			result_flags( m, v, wide );
+			break;
+		}
+	}
+	return( v );
+}
+
+/*
+ *	Multiply and divide the accumulator, the divide returning
+ *	FALSE if the result does not fit.
+ */
+static void multiply( machine *m, boolean sign, word v, boolean wide ) {
+	boolean	over;
+
+	if( wide ) {
+		if( sign ) {
+			integer	r = (integer)(int16_t)m->reg[ REG_AX ] * (int16_t)v;
+
+			m->reg[ REG_AX ] = (word)r;
+			m->reg[ REG_DX ] = (word)( r >> 16 );
+			over = ( r != (int16_t)r );
+		}
+		else {
+			dword	r = (dword)m->reg[ REG_AX ] * v;
+
+			m->reg[ REG_AX ] = (word)r;
+			m->reg[ REG_DX ] = (word)( r >> 16 );
+			over = ( m->reg[ REG_DX ] != 0 );
+		}
+	}
+	else {
+		if( sign ) {
+			integer	r = (integer)(int8_t)byte_reg( m, REG_AL ) * (int8_t)v;
+
+			m->reg[ REG_AX ] = (word)r;
+			over = ( r != (int8_t)r );
+		}
+		else {
+			m->reg[ REG_AX ] = byte_reg( m, REG_AL ) * ( v & 0xFF );
+			over = ( m->reg[ REG_AX ] > 0xFF );
+		}
+	}
+	set_flag( m, FLAG_CF, over );
+	set_flag( m, FLAG_OF, over );
+}
+
+static boolean divide( machine *m, boolean sign, word v, boolean wide ) {
+	if( !wide ) v &= 0xFF;
+	if( v == 0 ) return( FALSE );
+	if( wide ) {
+		dword	n = ((dword)m->reg[ REG_DX ] << 16 )| m->reg[ REG_AX ];
+
+		if( sign ) {
+			int64_t	a = (int32_t)n,
+				d = (int16_t)v,
+				q = a / d;
+
+			if(( q > 32767 )||( q < -32768 )) return( FALSE );
+			m->reg[ REG_AX ] = (word)q;
+			m->reg[ REG_DX ] = (word)( a % d );
+		}
+		else {
+			dword	q = n / v;
+
+			if( q > 0xFFFF ) return( FALSE );
+			m->reg[ REG_AX ] = (word)q;
+			m->reg[ REG_DX ] = (word)( n % v );
+		}
+	}
+	else {
+		word	n = m->reg[ REG_AX ];
+
+		if( sign ) {
+			integer	a = (int16_t)n,
+				d = (int8_t)v,
+				q = a / d;
+
+			if(( q > 127 )||( q < -128 )) return( FALSE );
+			m->reg[ REG_AX ] = (( a % d ) << 8 )|( q & 0xFF );
+		}
+		else {
+			word	q = n / v;
+
+			if( q > 0xFF ) return( FALSE );
+			m->reg[ REG_AX ] = (( n % v ) << 8 )| q;
+		}
+	}
+	return( TRUE );
+}
+
+/*
+ *	The decimal adjustments.
+ */
+static void adjust( machine *m, component op ) {
+	word	al = byte_reg( m, REG_AL ),
+		ah = byte_reg( m, REG_AH );
+	boolean	cf = BOOL( m->flags & FLAG_CF ),
+		af = BOOL( m->flags & FLAG_AF );
+
+	switch( op ) {
+		case op_aaa:
+		case op_aas: {
+			if((( al & 0x0F ) > 9 )|| af ) {
+				if( op == op_aaa ) {
+					al += 6;
+					ah += 1;
+				}
+				else {
+					al -= 6;
+					ah -= 1;
+				}
+				af = cf = TRUE;
+			}
+			else {
+				af = cf = FALSE;
+			}
+			set_byte_reg( m, REG_AL, al & 0x0F );
+			set_byte_reg( m, REG_AH, ah );
+			break;
+		}
+		case op_daa:
+		case op_das: {
+			word	old = al;
+			boolean	old_cf = cf;
+
+			cf = FALSE;
+			if((( al & 0x0F ) > 9 )|| af ) {
+				if( op == op_daa ) {
+					cf = old_cf || ( al + 6 > 0xFF );
+					al = ( al + 6 )& 0xFF;
+				}
+				else {
+					cf = old_cf || ( al < 6 );
+					al = ( al - 6 )& 0xFF;
+				}
+				af = TRUE;
+			}
+			else {
+				af = FALSE;
+			}
+			if(( old > 0x99 )|| old_cf ) {
+				al = (( op == op_daa )?( al + 0x60 ):( al - 0x60 ))& 0xFF;
+				cf = TRUE;
+			}
+			set_byte_reg( m, REG_AL, al );
+			result_flags( m, al, FALSE );
+			break;
+		}
+		default: {
+			break;
+		}
+	}
+	set_flag( m, FLAG_CF, cf );
+	set_flag( m, FLAG_AF, af );
+}
+
+/*
+ *	Test the condition of a conditional jump.
+ */
+static boolean condition( machine *m, component op ) {
+	boolean	cf = BOOL( m->flags & FLAG_CF ),
+		zf = BOOL( m->flags & FLAG_ZF ),
+		sf = BOOL( m->flags & FLAG_SF ),
+		of = BOOL( m->flags & FLAG_OF ),
+		pf = BOOL( m->flags & FLAG_PF );
+
+	switch( op ) {
+		case op_ja:
+		case op_jnbe:	return( !cf && !zf );
+		case op_jae:
+		case op_jnb:
+		case op_jnc:	return( !cf );
+		case op_jb:
+		case op_jc:
+		case op_jnae:	return( cf );
+		case op_jbe:
+		case op_jna:	return( cf || zf );
+		case op_je:
+		case op_jz:	return( zf );
+		case op_jne:
+		case op_jnz:	return( !zf );
+		case op_jg:
+		case op_jnle:	return( !zf &&( sf == of ));
+		case op_jge:
+		case op_jnl:	return( sf == of );
+		case op_jl:
+		case op_jnge:	return( sf != of );
+		case op_jle:
+		case op_jng:	return( zf ||( sf != of ));
+		case op_jo:	return( of );
+		case op_jno:	return( !of );
+		case op_jp:
+		case op_jpe:	return( pf );
+		case op_jnp:
+		case op_jpo:	return( !pf );
+		case op_js:	return( sf );
+		case op_jns:	return( !sf );
+		default:	break;
+	}
+	return( FALSE );
+}
+
+/*
+ *	Read the ASCIIZ name of a file from the program and form
+ *	the path to it in the sandbox.  Names are confined to the
+ *	sandbox (no directories or drives) and folded to lower
+ *	case as DOS ignores case.
+ */
+static boolean sandbox_path( machine *m, word s, word o, char *path, int max ) {
+	char	name[ EXECUTE_NAME ];
+	int	i;
+	byte	c;
+
+	if( execute_sandbox == NIL( char )) return( FALSE );
+	for( i = 0; i < EXECUTE_NAME; i++ ) {
+		c = (byte)read_data( m, s, (word)( o+i ), FALSE );
+		if( c == EOS ) break;
+		if(( c == '/' )||( c == '\\' )||( c == ':' )||( c <= SPACE )||( c >= 0x7F )) return( FALSE );
+		name[ i ] = tolower( c );
+	}
+	if(( i == 0 )||( i == EXECUTE_NAME )||( name[ 0 ] == PERIOD )) return( FALSE );
+	name[ i ] = EOS;
+	return( snprintf( path, max, "%s/%s", execute_sandbox, name ) < max );
+}
+
+/*
+ *	Set the result of a DOS call: success, or an error code
+ *	in AX with the carry flag set.
+ */
+static void dos_result( machine *m, boolean ok, word error ) {
+	set_flag( m, FLAG_CF, !ok );
+	if( !ok ) m->reg[ REG_AX ] = error;
+}
+
+static word dos_error( void ) {
+	switch( errno ) {
+		case ENOENT:	return( DOS_NOT_FOUND );
+		case EMFILE:
+		case ENFILE:	return( DOS_NO_HANDLES );
+		case EBADF:	return( DOS_BAD_HANDLE );
+		default:	break;
+	}
+	return( DOS_DENIED );
+}
+
+/*
+ *	Open (or create) a file in the sandbox returning the
+ *	handle in AX.
+ */
+static void dos_open( machine *m, int flags ) {
+	char	path[ PATH_MAX ];
+	int	h, fd;
+
+	if( !sandbox_path( m, m->seg[ REG_DS ], m->reg[ REG_DX ], path, PATH_MAX )) {
+		dos_result( m, FALSE, DOS_DENIED );
+		return;
+	}
+	for( h = EXECUTE_FIRST_FILE; ( h < EXECUTE_HANDLES )&&( m->handle[ h ] != ERROR ); h++ );
+	if( h == EXECUTE_HANDLES ) {
+		dos_result( m, FALSE, DOS_NO_HANDLES );
+		return;
+	}
+	if(( fd = open( path, flags, 0644 )) < 0 ) {
+		dos_result( m, FALSE, dos_error());
+		return;
+	}
+	m->handle[ h ] = fd;
+	m->reg[ REG_AX ] = h;
+	dos_result( m, TRUE, 0 );
+}
+
+/*
+ *	Read or write through a handle (in BX) CX bytes at DS:DX,
+ *	returning the count transferred in AX.
+ */
+static void dos_transfer( machine *m, boolean writing ) {
+	word	h = m->reg[ REG_BX ],
+		count = m->reg[ REG_CX ],
+		at = m->reg[ REG_DX ];
+	byte	*buffer;
+	long	done;
+	int	c, i;
+
+	if(( h >= EXECUTE_HANDLES )||(( h >= EXECUTE_FIRST_FILE )&&( m->handle[ h ] == ERROR ))||( h > 2 && h < EXECUTE_FIRST_FILE )) {
+		dos_result( m, FALSE, DOS_BAD_HANDLE );
+		return;
+	}
+	buffer = NEW_ARRAY( byte, count + 1 );
+	if( writing ) {
+		for( i = 0; i < count; i++ ) buffer[ i ] = (byte)read_data( m, m->seg[ REG_DS ], (word)( at+i ), FALSE );
+		switch( h ) {
+			case 0:
+			case 1:		done = fwrite( buffer, 1, count, report_stream());		break;
+			case 2:		done = fwrite( buffer, 1, count, stderr );		break;
+			default:	done = write( m->handle[ h ], buffer, count );		break;
+		}
+	}
+	else {
+		switch( h ) {
+			case 0:
+			case 1:
+			case 2: {
+				/*
+				 *	The console gives a line at a time.
+				 */
+				for( done = 0; ( done < count )&&(( c = getchar()) != EOF ); ) {
+					buffer[ done++ ] = (byte)c;
+					if( c == NL ) break;
+				}
+				break;
+			}
+			default: {
+				done = read( m->handle[ h ], buffer, count );
+				break;
+			}
+		}
+		for( i = 0; i < done; i++ ) write_byte( m, m->seg[ REG_DS ], (word)( at+i ), buffer[ i ]);
+	}
+	FREE( buffer );
+	if( done < 0 ) {
+		dos_result( m, FALSE, dos_error());
+		return;
+	}
+	m->reg[ REG_AX ] = (word)done;
+	dos_result( m, TRUE, 0 );
+}
+
+/*
+ *	The DOS functions provided, selected by AH.
+ */
+static void dos_function( machine *m ) {
+	char	path[ PATH_MAX ];
+	word	ah = byte_reg( m, REG_AH ),
+		dl = byte_reg( m, REG_DL ),
+		h = m->reg[ REG_BX ];
+	off_t	posn;
+	int	c, i;
+
+	switch( ah ) {
+		case 0x00: {
+			exit_program( m, 0 );
+			break;
+		}
+		case 0x01:
+		case 0x07:
+		case 0x08: {
+			if(( c = getchar()) == EOF ) c = 0x1A;
+			if( ah == 0x01 ) fputc( c, report_stream());
+			set_byte_reg( m, REG_AL, c );
+			break;
+		}
+		case 0x02: {
+			fputc( dl, report_stream());
+			set_byte_reg( m, REG_AL, dl );
+			break;
+		}
+		case 0x06: {
+			if( dl != 0xFF ) {
+				fputc( dl, report_stream());
+				set_byte_reg( m, REG_AL, dl );
+				break;
+			}
+			c = getchar();
+			set_flag( m, FLAG_ZF, c == EOF );
+			set_byte_reg( m, REG_AL, ( c == EOF )? 0: c );
+			break;
+		}
+		case 0x09: {
+			for( i = 0; ( i < 0x10000 )&&(( c = read_data( m, m->seg[ REG_DS ], (word)( m->reg[ REG_DX ]+i ), FALSE )) != '$' ); i++ ) fputc( c, report_stream());
+			set_byte_reg( m, REG_AL, '$' );
+			break;
+		}
+		case 0x25: {
+			i = byte_reg( m, REG_AL ) * 4;
+			write_data( m, 0, (word)i, TRUE, m->reg[ REG_DX ]);
+			write_data( m, 0, (word)( i+2 ), TRUE, m->seg[ REG_DS ]);
+			break;
+		}
+		case 0x30: {
+			m->reg[ REG_AX ] = 0x0005;
+			m->reg[ REG_BX ] = 0;
+			m->reg[ REG_CX ] = 0;
+			break;
+		}
+		case 0x35: {
+			i = byte_reg( m, REG_AL ) * 4;
+			m->reg[ REG_BX ] = read_data( m, 0, (word)i, TRUE );
+			m->seg[ REG_ES ] = read_data( m, 0, (word)( i+2 ), TRUE );
+			break;
+		}
+		case 0x3C: {
+			dos_open( m, O_RDWR | O_CREAT | O_TRUNC );
+			break;
+		}
+		case 0x3D: {
+			switch( byte_reg( m, REG_AL ) & 3 ) {
+				case 0:		dos_open( m, O_RDONLY );	break;
+				case 1:		dos_open( m, O_WRONLY );	break;
+				default:	dos_open( m, O_RDWR );		break;
+			}
+			break;
+		}
+		case 0x3E: {
+			if(( h < EXECUTE_FIRST_FILE )||( h >= EXECUTE_HANDLES )||( m->handle[ h ] == ERROR )) {
+				dos_result( m, h < EXECUTE_FIRST_FILE, DOS_BAD_HANDLE );
+				break;
+			}
+			close( m->handle[ h ]);
+			m->handle[ h ] = ERROR;
+			dos_result( m, TRUE, 0 );
+			break;
+		}
+		case 0x3F:
+		case 0x40: {
+			dos_transfer( m, ah == 0x40 );
+			break;
+		}
+		case 0x41: {
+			if( !sandbox_path( m, m->seg[ REG_DS ], m->reg[ REG_DX ], path, PATH_MAX )) {
+				dos_result( m, FALSE, DOS_DENIED );
+				break;
+			}
+			dos_result( m, unlink( path ) == 0, dos_error());
+			break;
+		}
+		case 0x42: {
+			if(( h < EXECUTE_FIRST_FILE )||( h >= EXECUTE_HANDLES )||( m->handle[ h ] == ERROR )) {
+				dos_result( m, FALSE, DOS_BAD_HANDLE );
+				break;
+			}
+			posn = (off_t)(int32_t)(((dword)m->reg[ REG_CX ] << 16 )| m->reg[ REG_DX ]);
+			switch( byte_reg( m, REG_AL )) {
+				case 0:		posn = lseek( m->handle[ h ], posn, SEEK_SET );	break;
+				case 1:		posn = lseek( m->handle[ h ], posn, SEEK_CUR );	break;
+				case 2:		posn = lseek( m->handle[ h ], posn, SEEK_END );	break;
+				default:	posn = ERROR; errno = EINVAL;			break;
+			}
+			if( posn < 0 ) {
+				dos_result( m, FALSE, ( errno == EINVAL )? DOS_BAD_FUNCTION: dos_error());
+				break;
+			}
+			m->reg[ REG_AX ] = (word)posn;
+			m->reg[ REG_DX ] = (word)( posn >> 16 );
+			dos_result( m, TRUE, 0 );
+			break;
+		}
+		case 0x4C: {
+			exit_program( m, byte_reg( m, REG_AL ));
+			break;
+		}
+		default: {
+			fault( m, "Unsupported DOS function", ah );
+			break;
+		}
+	}
+}
+
+/*
+ *	Take an interrupt.  Those the program has not pointed
+ *	elsewhere are handled here, INT 20h and 21h being DOS.
+ */
+static void interrupt( machine *m, int n ) {
+	word	ip = read_data( m, 0, (word)( n * 4 ), TRUE ),
+		cs = read_data( m, 0, (word)( n * 4 + 2 ), TRUE );
+
+	if(( ip == 0 )&&( cs == 0 )) {
+		switch( n ) {
+			case 0x00: {
+				fault( m, "Divide error", ERROR );
+				break;
+			}
+			case 0x20: {
+				exit_program( m, 0 );
+				break;
+			}
+			case 0x21: {
+				dos_function( m );
+				break;
+			}
+			default: {
+				fault( m, "Unsupported interrupt", n );
+				break;
+			}
+		}
+		return;
+	}
+	push( m, m->flags | FLAGS_FIXED );
+	m->flags &= ~( FLAG_IF | FLAG_TF );
+	push( m, m->seg[ REG_CS ]);
+	push( m, m->ip );
+	m->seg[ REG_CS ] = cs;
+	m->ip = ip;
+}
+
+/*
+ *	Translate an argument as found by the decoder.
+ */
+static boolean translate_operand( ea_breakdown *arg, operand *o, boolean *far ) {
+	int	i;
+
+	o->base = NO_REGISTER;
+	o->index = NO_REGISTER;
+	o->segment = REG_DS;
+	o->value = (word)arg->immediate_arg.value;
+	switch( arg->ea ) {
+		case ea_byte_acc:
+		case ea_byte_reg: {
+			o->kind = arg_byte_reg;
+			o->base = arg->reg[ 0 ]->reg_no;
+			return( TRUE );
+		}
+		case ea_word_acc:
+		case ea_word_reg: {
+			o->kind = arg_word_reg;
+			o->base = arg->reg[ 0 ]->reg_no;
+			return( TRUE );
+		}
+		case ea_segment_reg: {
+			o->kind = arg_segment_reg;
+			o->base = arg->reg[ 0 ]->reg_no;
+			return( TRUE );
+		}
+		case ea_far_immediate: {
+			*far = TRUE;
+			o->kind = arg_immediate;
+			return( TRUE );
+		}
+		case ea_immediate: {
+			o->kind = arg_immediate;
+			return( TRUE );
+		}
+		default: {
+			break;
+		}
+	}
+	if( !BOOL( arg->ea & ( ea_mem_mod_adrs | ea_far_mod_reg_adrs ))) return( FALSE );
+	if( BOOL( arg->ea & ea_far_mod_reg_adrs )) *far = TRUE;
+	o->kind = arg_memory;
+	for( i = 0; i < arg->registers; i++ ) {
+		if( arg->reg[ i ]->reg_no == REG_BP ) o->segment = REG_SS;
+		if( i == 0 ) {
+			o->base = arg->reg[ i ]->reg_no;
+		}
+		else {
+			o->index = arg->reg[ i ]->reg_no;
+		}
+	}
+	if( arg->segment_override != UNKNOWN_SEG ) o->segment = arg->segment_override;
+	return( TRUE );
+}
+
+/*
+ *	Translate a decoded instruction for the cache.  The data
+ *	size follows the first register or sized memory argument,
+ *	while string instructions (which have none) carry it in
+ *	the low bit of the opcode.
+ */
+static boolean translate( decoded_inst *inst, byte *code, cached_inst *c ) {
+	ea_breakdown	*arg;
+	int		a, p;
+
+	c->op = inst->op->op;
+	c->size = inst->size;
+	c->args = inst->op->args;
+	c->far_segment = inst->far_segment;
+	c->far = BOOL( inst->op->mods & far_modifier )||( c->op == op_ljmp )||( c->op == op_lcall )||( c->op == op_lret );
+	if( BOOL( inst->prefs & rep_ne_prefix )) {
+		c->repeat = repeat_not_equal;
+	}
+	else if( BOOL( inst->prefs & ( rep_prefix | rep_eq_prefix ))) {
+		c->repeat = repeat_equal;
+	}
+	else {
+		c->repeat = repeat_none;
+	}
+	for( a = 0; a < c->args; a++ ) {
+		if( !translate_operand( &( inst->arg[ a ]), &( c->arg[ a ]), &( c->far ))) return( FALSE );
+	}
+	for( p = 0; ( code[ p ] == 0xF0 )||( code[ p ] == 0xF2 )||( code[ p ] == 0xF3 )||(( code[ p ] & 0xE7 ) == 0x26 ); p++ );
+	c->wide = BOOL( code[ p ] & 1 );
+	if( c->args > 0 ) {
+		c->wide = TRUE;
+		for( a = 0; a < c->args; a++ ) {
+			arg = &( inst->arg[ a ]);
+			if( BOOL( arg->ea & ea_byte_registers )) {
+				c->wide = FALSE;
+				break;
+			}
+			if( BOOL( arg->ea & ea_word_registers )) break;
+			if( BOOL( arg->ea & ea_mem_mod_adrs )&& BOOL( arg->mod & ( byte_modifier | word_modifier ))) {
+				c->wide = BOOL( arg->mod & word_modifier );
+				break;
+			}
+		}
+	}
+	/*
+	 *	The short form of exchange with the accumulator
+	 *	holds its register in the opcode.
+	 */
+	if(( c->op == op_xchg )&&( c->args < 2 )) {
+		c->args = 2;
+		c->wide = TRUE;
+		c->arg[ 0 ].kind = arg_word_reg;
+		c->arg[ 0 ].base = REG_AX;
+		c->arg[ 1 ].kind = arg_word_reg;
+		c->arg[ 1 ].base = code[ p ] & 7;
+	}
+	return( TRUE );
+}
+
+/*
+ *	Find the instruction at CS:IP, from the cache if it is
+ *	there and still current.
+ */
+static cached_inst *fetch( machine *m ) {
+	dword		at = LINEAR( m->seg[ REG_CS ], m->ip );
+	cached_inst	*c = &( m->cache[ at & ( EXECUTE_CACHE-1 )]);
+	decoded_inst	inst;
+	int		len, i;
+
+	if( c->valid &&( c->ip == m->ip )&&( c->cs == m->seg[ REG_CS ])&&( c->generation[ 0 ] == m->generation[ c->page[ 0 ]])&&( c->generation[ 1 ] == m->generation[ c->page[ 1 ]])) {
+		m->cached++;
+		return( c );
+	}
+	c->valid = FALSE;
+	len = EXECUTE_MEMORY - at;
+	if( len > EXECUTE_FETCH ) len = EXECUTE_FETCH;
+	if( decode_inst( m->memory + at, len, m->ip, &inst ) == 0 ) return( NIL( cached_inst ));
+	if( !translate( &inst, m->memory + at, c )) return( NIL( cached_inst ));
+	c->cs = m->seg[ REG_CS ];
+	c->ip = m->ip;
+	c->page[ 0 ] = at >> EXECUTE_PAGE_SHIFT;
+	c->page[ 1 ] = (( at + c->size - 1 )&( EXECUTE_MEMORY-1 )) >> EXECUTE_PAGE_SHIFT;
+	for( i = 0; i < 2; i++ ) {
+		c->generation[ i ] = m->generation[ c->page[ i ]];
+		m->holds_code[ c->page[ i ]] = TRUE;
+	}
+	c->valid = TRUE;
+	return( c );
+}
+
+/*
+ *	Carry out a string instruction (repeated as its prefix
+ *	says).
+ */
+static void string_inst( machine *m, cached_inst *c ) {
+	word	delta = c->wide? 2: 1,
+		v;
+
+	if( BOOL( m->flags & FLAG_DF )) delta = -delta;
+	for( ;; ) {
+		if(( c->repeat != repeat_none )&&( m->reg[ REG_CX ] == 0 )) break;
+		switch( c->op ) {
+			case op_movs: {
+				v = read_data( m, m->seg[ REG_DS ], m->reg[ REG_SI ], c->wide );
+				write_data( m, m->seg[ REG_ES ], m->reg[ REG_DI ], c->wide, v );
+				m->reg[ REG_SI ] += delta;
+				m->reg[ REG_DI ] += delta;
+				break;
+			}
+			case op_lods: {
+				v = read_data( m, m->seg[ REG_DS ], m->reg[ REG_SI ], c->wide );
+				if( c->wide ) {
+					m->reg[ REG_AX ] = v;
+				}
+				else {
+					set_byte_reg( m, REG_AL, v );
+				}
+				m->reg[ REG_SI ] += delta;
+				break;
+			}
+			case op_stos: {
+				write_data( m, m->seg[ REG_ES ], m->reg[ REG_DI ], c->wide, m->reg[ REG_AX ]);
+				m->reg[ REG_DI ] += delta;
+				break;
+			}
+			case op_scas: {
+				(void)arithmetic( m, op_cmp, m->reg[ REG_AX ], read_data( m, m->seg[ REG_ES ], m->reg[ REG_DI ], c->wide ), c->wide );
+				m->reg[ REG_DI ] += delta;
+				break;
+			}
+			case op_cmps: {
+				(void)arithmetic( m, op_cmp, read_data( m, m->seg[ REG_DS ], m->reg[ REG_SI ], c->wide ), read_data( m, m->seg[ REG_ES ], m->reg[ REG_DI ], c->wide ), c->wide );
+				m->reg[ REG_SI ] += delta;
+				m->reg[ REG_DI ] += delta;
+				break;
+			}
+			case op_ins: {
+				write_data( m, m->seg[ REG_ES ], m->reg[ REG_DI ], c->wide, 0xFFFF );
+				m->reg[ REG_DI ] += delta;
+				break;
+			}
+			default: {
+				m->reg[ REG_SI ] += delta;
+				break;
+			}
+		}
+		if( c->repeat == repeat_none ) break;
+		m->reg[ REG_CX ]--;
+		if(( c->op == op_scas )||( c->op == op_cmps )) {
+			if(( c->repeat == repeat_equal )&& !BOOL( m->flags & FLAG_ZF )) break;
+			if(( c->repeat == repeat_not_equal )&& BOOL( m->flags & FLAG_ZF )) break;
+		}
+	}
+}
+
+/*
+ *	Transfer control to a far address.
+ */
+static void far_jump( machine *m, word cs, word ip ) {
+	m->seg[ REG_CS ] = cs;
+	m->ip = ip;
+}
+
+/*
+ *	Find the target of a jump or call, which is either given
+ *	directly or read from the register or memory argument.
+ */
+static void branch( machine *m, cached_inst *c, boolean call ) {
+	operand	*o = &( c->arg[ 0 ]);
+	word	ip, cs;
+
+	if( c->far ) {
+		if( o->kind == arg_immediate ) {
+			ip = o->value;
+			cs = c->far_segment;
+		}
+		else {
+			ip = read_data( m, m->seg[ o->segment ], operand_offset( m, o ), TRUE );
+			cs = read_data( m, m->seg[ o->segment ], (word)( operand_offset( m, o )+2 ), TRUE );
+		}
+		if( call ) {
+			push( m, m->seg[ REG_CS ]);
+			push( m, m->ip );
+		}
+		far_jump( m, cs, ip );
+		return;
+	}
+	ip = get_operand( m, o, TRUE );
+	if( call ) push( m, m->ip );
+	m->ip = ip;
+}
+
+/*
+ *	Execute a single instruction.
+ */
+static void step( machine *m ) {
+	cached_inst	*c;
+	operand		*a0, *a1;
+	word		v, w, sp;
+	int		i;
+
+	m->at_cs = m->seg[ REG_CS ];
+	m->at_ip = m->ip;
+	if(( c = fetch( m )) == NIL( cached_inst )) {
+		fault( m, "Unrecognised instruction", m->memory[ LINEAR( m->at_cs, m->at_ip )]);
+		return;
+	}
+	m->ip += c->size;
+	a0 = &( c->arg[ 0 ]);
+	a1 = &( c->arg[ 1 ]);
+	switch( c->op ) {
+		/*
+		 *	Arithmetic and logic.
+		 */
+		case op_add:
+		case op_adc:
+		case op_sub:
+		case op_sbb:
+		case op_and:
+		case op_or:
+		case op_xor: {
+			set_operand( m, a0, c->wide, arithmetic( m, c->op, get_operand( m, a0, c->wide ), get_operand( m, a1, c->wide ), c->wide ));
+			break;
+		}
+		case op_cmp:
+		case op_test: {
+			(void)arithmetic( m, c->op, get_operand( m, a0, c->wide ), get_operand( m, a1, c->wide ), c->wide );
+			break;
+		}
+		case op_inc:
+		case op_dec: {
+			boolean	cf = BOOL( m->flags & FLAG_CF );
+
+			set_operand( m, a0, c->wide, arithmetic( m, ( c->op == op_inc )? op_add: op_sub, get_operand( m, a0, c->wide ), 1, c->wide ));
+			set_flag( m, FLAG_CF, cf );
+			break;
+		}
+		case op_neg: {
+			set_operand( m, a0, c->wide, arithmetic( m, op_sub, 0, get_operand( m, a0, c->wide ), c->wide ));
+			break;
+		}
+		case op_not: {
+			set_operand( m, a0, c->wide, ~get_operand( m, a0, c->wide ));
+			break;
+		}
+		case op_mul:
+		case op_imul: {
+			multiply( m, c->op == op_imul, get_operand( m, a0, c->wide ), c->wide );
+			break;
+		}
+		case op_div:
+		case op_idiv: {
+			if( !divide( m, c->op == op_idiv, get_operand( m, a0, c->wide ), c->wide )) interrupt( m, 0 );
+			break;
+		}
+		case op_aaa:
+		case op_aas:
+		case op_daa:
+		case op_das: {
+			adjust( m, c->op );
+			break;
+		}
+		case op_aam: {
+			v = byte_reg( m, REG_AL );
+			set_byte_reg( m, REG_AH, v / 10 );
+			set_byte_reg( m, REG_AL, v % 10 );
+			result_flags( m, v % 10, FALSE );
+			break;
+		}
+		case op_aad: {
+			v = ( byte_reg( m, REG_AH ) * 10 + byte_reg( m, REG_AL ))& 0xFF;
+			m->reg[ REG_AX ] = v;
+			result_flags( m, v, FALSE );
+			break;
+		}
+		case op_cbw: {
+			m->reg[ REG_AX ] = (word)(int8_t)byte_reg( m, REG_AL );
+			break;
+		}
+		case op_cwd: {
+			m->reg[ REG_DX ] = BOOL( m->reg[ REG_AX ] & 0x8000 )? 0xFFFF: 0;
+			break;
+		}
+		case op_rol:
+		case op_ror:
+		case op_rcl:
+		case op_rcr:
+		case op_shl:
+		case op_sal:
+		case op_shr:
+		case op_sar: {
+			i = ( c->args > 1 )?( get_operand( m, a1, FALSE )& 0xFF ): 1;
+			set_operand( m, a0, c->wide, shift( m, c->op, get_operand( m, a0, c->wide ), i, c->wide ));
+			break;
+		}
+		/*
+		 *	Data movement.
+		 */
+		case op_mov: {
+			set_operand( m, a0, c->wide, get_operand( m, a1, c->wide ));
+			break;
+		}
+		case op_xchg: {
+			v = get_operand( m, a0, c->wide );
+			set_operand( m, a0, c->wide, get_operand( m, a1, c->wide ));
+			set_operand( m, a1, c->wide, v );
+			break;
+		}
+		case op_lea: {
+			set_operand( m, a0, TRUE, operand_offset( m, a1 ));
+			break;
+		}
+		case op_lds:
+		case op_les: {
+			v = operand_offset( m, a1 );
+			set_operand( m, a0, TRUE, read_data( m, m->seg[ a1->segment ], v, TRUE ));
+			m->seg[( c->op == op_lds )? REG_DS: REG_ES ] = read_data( m, m->seg[ a1->segment ], (word)( v+2 ), TRUE );
+			break;
+		}
+		case op_push: {
+			/*
+			 *	The 8086 pushes SP as it is after the push.
+			 */
+			if(( a0->kind == arg_word_reg )&&( a0->base == REG_SP )&& !m->later_cpu ) {
+				push( m, m->reg[ REG_SP ] - 2 );
+				break;
+			}
+			push( m, get_operand( m, a0, TRUE ));
+			break;
+		}
+		case op_pop: {
+			v = pop( m );
+			set_operand( m, a0, TRUE, v );
+			break;
+		}
+		case op_pusha: {
+			sp = m->reg[ REG_SP ];
+			for( i = REG_AX; i <= REG_DI; i++ ) push( m, ( i == REG_SP )? sp: m->reg[ i ]);
+			break;
+		}
+		case op_popa: {
+			for( i = REG_DI; i >= REG_AX; i-- ) {
+				v = pop( m );
+				if( i != REG_SP ) m->reg[ i ] = v;
+			}
+			break;
+		}
+		case op_pushf: {
+			push( m, m->flags | FLAGS_FIXED );
+			break;
+		}
+		case op_popf: {
+			m->flags = pop( m )& FLAGS_USED;
+			break;
+		}
+		case op_lahf: {
+			set_byte_reg( m, REG_AH, ( m->flags & 0xD5 )| 0x02 );
+			break;
+		}
+		case op_sahf: {
+			m->flags = ( m->flags & 0xFF00 )|( byte_reg( m, REG_AH )& 0xD5 );
+			break;
+		}
+		case op_xlat: {
+			set_byte_reg( m, REG_AL, read_data( m, m->seg[ REG_DS ], (word)( m->reg[ REG_BX ]+ byte_reg( m, REG_AL )), FALSE ));
+			break;
+		}
+		case op_in: {
+			if( c->wide ) {
+				m->reg[ REG_AX ] = 0xFFFF;
+			}
+			else {
+				set_byte_reg( m, REG_AL, 0xFF );
+			}
+			break;
+		}
+		case op_out: {
+			break;
+		}
+		case op_movs:
+		case op_lods:
+		case op_stos:
+		case op_scas:
+		case op_cmps:
+		case op_ins:
+		case op_outs: {
+			string_inst( m, c );
+			break;
+		}
+		/*
+		 *	Transfer of control.
+		 */
+		case op_jmp:
+		case op_ljmp: {
+			branch( m, c, FALSE );
+			break;
+		}
+		case op_call:
+		case op_lcall: {
+			branch( m, c, TRUE );
+			break;
+		}
+		case op_ret:
+		case op_lret: {
+			v = pop( m );
+			w = c->far? pop( m ): m->seg[ REG_CS ];
+			if( c->args > 0 ) m->reg[ REG_SP ] += a0->value;
+			far_jump( m, w, v );
+			break;
+		}
+		case op_iret: {
+			v = pop( m );
+			w = pop( m );
+			m->flags = pop( m )& FLAGS_USED;
+			far_jump( m, w, v );
+			break;
+		}
+		case op_int: {
+			interrupt( m, a0->value & 0xFF );
+			break;
+		}
+		case op_break: {
+			interrupt( m, 3 );
+			break;
+		}
+		case op_into: {
+			if( BOOL( m->flags & FLAG_OF )) interrupt( m, 4 );
+			break;
+		}
+		case op_bound: {
+			v = operand_offset( m, a1 );
+			i = (int16_t)get_operand( m, a0, TRUE );
+			if(( i < (int16_t)read_data( m, m->seg[ a1->segment ], v, TRUE ))||( i > (int16_t)read_data( m, m->seg[ a1->segment ], (word)( v+2 ), TRUE ))) {
+				m->ip = m->at_ip;
+				interrupt( m, 5 );
+			}
+			break;
+		}
+		case op_loop:
+		case op_loope:
+		case op_loopz:
+		case op_looppe:
+		case op_looppz:
+		case op_loopne:
+		case op_loopnz: {
+			boolean	zf = BOOL( m->flags & FLAG_ZF );
+
+			if( --m->reg[ REG_CX ] == 0 ) break;
+			if((( c->op == op_loope )||( c->op == op_loopz )||( c->op == op_looppe )||( c->op == op_looppz ))&& !zf ) break;
+			if((( c->op == op_loopne )||( c->op == op_loopnz ))&& zf ) break;
+			m->ip = a0->value;
+			break;
+		}
+		case op_jcxz: {
+			if( m->reg[ REG_CX ] == 0 ) m->ip = a0->value;
+			break;
+		}
+		case op_enter: {
+			push( m, m->reg[ REG_BP ]);
+			m->reg[ REG_BP ] = m->reg[ REG_SP ];
+			m->reg[ REG_SP ] -= a0->value;
+			break;
+		}
+		case op_leave: {
+			m->reg[ REG_SP ] = m->reg[ REG_BP ];
+			m->reg[ REG_BP ] = pop( m );
+			break;
+		}
+		/*
+		 *	Flags and the processor.
+		 */
+		case op_clc:	m->flags &= ~FLAG_CF;	break;
+		case op_stc:	m->flags |= FLAG_CF;	break;
+		case op_cmc:	m->flags ^= FLAG_CF;	break;
+		case op_cld:	m->flags &= ~FLAG_DF;	break;
+		case op_std:	m->flags |= FLAG_DF;	break;
+		case op_cli:	m->flags &= ~FLAG_IF;	break;
+		case op_sti:	m->flags |= FLAG_IF;	break;
+		case op_nop:
+		case op_wait:
+		case op_esc: {
+			break;
+		}
+		case op_hlt: {
+			fault( m, "Processor halted", ERROR );
+			break;
+		}
+		default: {
+			if( condition( m, c->op )) {
+				m->ip = a0->value;
+				break;
+			}
+			if(( c->op >= op_ja )&&( c->op <= op_jz )) break;
+			fault( m, "Unsupported instruction", m->memory[ LINEAR( m->at_cs, m->at_ip )]);
+			break;
+		}
+	}
+}
+
+/*
+ *	Prepare a fresh machine with the program image loaded.
+ */
+static boolean load_program( machine *m, char *name ) {
+	FILE	*from;
+	long	size;
+	dword	psp;
+	int	i;
+
+	if(( from = fopen( name, "rb" )) == NIL( FILE )) {
+		log_error_s( "Unable to open file", name );
+		return( FALSE );
+	}
+	if(( fseek( from, 0, SEEK_END ) != 0 )||(( size = ftell( from )) < 0 )||( fseek( from, 0, SEEK_SET ) != 0 )) {
+		log_error_s( "Unable to size file", name );
+		fclose( from );
+		return( FALSE );
+	}
+	if( size > EXECUTE_LARGEST ) {
+		log_error_s( "Program too large", name );
+		fclose( from );
+		return( FALSE );
+	}
+	memset( m->memory, 0, EXECUTE_MEMORY );
+	psp = LINEAR( EXECUTE_SEGMENT, 0 );
+	if( fread( m->memory + psp + EXECUTE_ORIGIN, 1, size, from ) != (size_t)size ) {
+		log_error_s( "Unable to read file", name );
+		fclose( from );
+		return( FALSE );
+	}
+	fclose( from );
+	/*
+	 *	The program segment prefix: an exit at its start (so
+	 *	a near return from the program ends it), the top of
+	 *	memory and an empty command tail.
+	 */
+	m->memory[ psp + 0x00 ] = 0xCD;
+	m->memory[ psp + 0x01 ] = 0x20;
+	m->memory[ psp + 0x02 ] = L( EXECUTE_TOP );
+	m->memory[ psp + 0x03 ] = H( EXECUTE_TOP );
+	m->memory[ psp + 0x50 ] = 0xCD;
+	m->memory[ psp + 0x51 ] = 0x21;
+	m->memory[ psp + 0x52 ] = 0xCB;
+	m->memory[ psp + 0x81 ] = 0x0D;
+	/*
+	 *	Registers as DOS leaves them, with a zero word on the
+	 *	stack.
+	 */
+	memset( m->reg, 0, sizeof( m->reg ));
+	for( i = 0; i < SEGMENT_REGISTERS; i++ ) m->seg[ i ] = EXECUTE_SEGMENT;
+	m->reg[ REG_SP ] = 0xFFFE;
+	m->ip = EXECUTE_ORIGIN;
+	m->flags = FLAG_IF;
+	/*
+	 *	Nothing cached.
+	 */
+	for( i = 0; i < EXECUTE_CACHE; i++ ) m->cache[ i ].valid = FALSE;
+	memset( m->holds_code, 0, EXECUTE_PAGES );
+	for( i = 0; i < EXECUTE_HANDLES; i++ ) m->handle[ i ] = ERROR;
+	m->name = name;
+	m->running = TRUE;
+	m->faulted = FALSE;
+	m->status = 0;
+	m->steps = 0;
+	m->cached = 0;
+	return( TRUE );
+}
+
+/*
+ *	Run a loaded program to the end.
+ */
+static void run_machine( machine *m ) {
+	int	h;
+
+	while( m->running ) {
+		if( m->steps++ == m->limit ) {
+			fault( m, "Instruction limit reached", ERROR );
+			break;
+		}
+		step( m );
+	}
+	fflush( report_stream());
+	for( h = EXECUTE_FIRST_FILE; h < EXECUTE_HANDLES; h++ ) {
+		if( m->handle[ h ] != ERROR ) close( m->handle[ h ]);
+	}
+}
+
+void initialise_execution( void ) {
+	/*
+	 *	Instructions of the 80186 (though not the 80286) may
+	 *	be used when the target allows.
+	 */
+	initialise_decoder( BOOL( command_flags & ( intel_80186 | intel_80286 ))? ( flag_086 | flag_186 ): flag_086 );
+}
+
+boolean execute_program( char *name, int *status ) {
+	struct timespec	start,
+			end;
+	machine		m;
+	boolean		ok;
+
+	ASSERT( name != NIL( char ));
+	ASSERT( status != NIL( int ));
+
+	initialise_execution();
+	m.later_cpu = BOOL( command_flags & ( intel_80186 | intel_80286 ));
+	m.limit = ( execute_steps != NIL( char ))? strtoul( execute_steps, NIL( char * ), 0 ): EXECUTE_STEPS;
+	m.memory = NEW_ARRAY( byte, EXECUTE_MEMORY );
+	m.cache = NEW_ARRAY( cached_inst, EXECUTE_CACHE );
+	m.generation = NEW_ARRAY( dword, EXECUTE_PAGES );
+	m.holds_code = NEW_ARRAY( byte, EXECUTE_PAGES );
+	memset( m.generation, 0, EXECUTE_PAGES * sizeof( dword ));
+	ok = FALSE;
+	if( load_program( &m, name )) {
+		clock_gettime( CLOCK_MONOTONIC, &start );
+		run_machine( &m );
+		clock_gettime( CLOCK_MONOTONIC, &end );
+		if( BOOL( command_flags & be_verbose )) {
+			double	secs = ( end.tv_sec - start.tv_sec ) + ( end.tv_nsec - start.tv_nsec ) / 1e9;
+
+			fprintf( report_stream(), "; %s: exit status %d, %lu instructions (%lu cached) in %.3f seconds (%.1f MIPS)\n",
+					name, m.status, m.steps, m.cached, secs, ( secs > 0 )? m.steps / secs / 1e6: 0.0 );
+		}
+		*status = m.status;
+		ok = !m.faulted;
+	}
+	FREE( m.memory );
+	FREE( m.cache );
+	FREE( m.generation );
+	FREE( m.holds_code );
+	return( ok );
+}
+
+int execute_files( int files, char *name[] ) {
+	int	status,
+		result,
+		i;
+
+	if( files == 0 ) {
+		log_error( "Expecting '.COM' files" );
+		return( 1 );
+	}
+	result = 0;
+	for( i = 0; i < files; i++ ) {
+		if( !execute_program( name[ i ], &status )) status = 1;
+		if( status != 0 ) result = status;
+	}
+	return( result );
+}
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,69 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	execute
+ *	=======
+ *
+ *	A headless 8086/80186 interpreter with just enough of
+ *	DOS to run the '.COM' files the assembler produces.
+ */
+
+#ifndef _EXECUTE_H_
+#define _EXECUTE_H_
+
+#ifdef EXECUTION
+
+/*
+ *	The directory DOS file handles are confined to (files
+ *	cannot be opened without one) and the greatest number of
+ *	instructions a program may execute (given as text by the
+ *	command line).
+ */
+extern char *execute_sandbox;
+extern char *execute_steps;
+
+/*
+ *	Prepare the instruction decoder for the CPU selected by the
+ *	command flags.  This must be done before any threads which
+ *	may run programs are started.
+ */
+extern void initialise_execution( void );
+
+/*
+ *	Load the '.COM' file named at 0100h in a fresh machine and
+ *	run it until it exits.  Returns FALSE (having reported the
+ *	fault) if the program could not be loaded or stopped on
+ *	something the interpreter cannot handle, otherwise the exit
+ *	code the program gave is returned through status.
+ */
+extern boolean execute_program( char *name, int *status );
+
+/*
+ *	Run each of the '.COM' files named in turn, returning the
+ *	exit status of the last to fail (or 0 if none did).
+ */
+extern int execute_files( int files, char *name[] );
+
+#endif
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -66,6 +66,12 @@
  *		contains only that code required to handle program
  *		arguments and a final call to the routine that assembles
  *		a program file.
+ *
+ *	October 2026
+ *
+ *		When compiled with LIBRARY defined this module is
+ *		empty and the objects can be archived as 'libi8086'
+ *		exposing the in memory interface in libi8086.h.
  */
 
 #include "os.h"
@@ -73,6 +79,8 @@
 
 
 
+#ifndef LIBRARY
+
 /*
  *	Flags and bit field equivalent.
  */
@@ -89,11 +97,21 @@ static struct {
 	{ "--obj",			"Output a '.OBJ' linkable file",	generate_dot_obj,	flag_none	},
 	{ "--hex",			"Output binary files in ASCII",		generate_hex,		flag_none	},
 	{ "--ascii",			"Output binary files in ASCII",		generate_hex,		flag_none	},
-	{ "--listing",			"Produce detailed listing",		generate_listing,	flag_none	},
+	{ "--listing",			"Also produce a '.LST' listing",	generate_listing,	flag_none	},
+	{ "--map",			"Also produce '.MAP' and '.XRF' files",	generate_map,		flag_none	},
+	{ "--depend",			"Also produce a '.D' dependency file",	generate_depend,	flag_none	},
+	{ "--stats",			"Report counters and timings per pass",	show_statistics,	flag_none	},
+	{ "--convergence",		"Report labels slow to settle",		report_convergence,	flag_none	},
+	{ "--clocks",			"Estimate clocks per line in the listing", list_clocks,		flag_none	},
+	{ "--optimize-size",		"Use the shortest encoding available",	optimize_size,		flag_none	},
+	{ "--expand-branches",		"Rewrite out of range short branches",	expand_branches,	flag_none	},
+	{ "--auto-align",		"Word align labelled word data",	auto_align,		flag_none	},
+	{ "--pipeline",			"Read and write on separate threads",	pipeline_stages,	flag_none	},
+	{ "--watch",			"Reassemble whenever a source changes",	watch_for_changes,	flag_none	},
 	{ "--8086",			"Only permit 8086 code",		intel_8086,		flag_086	},
-	{ "--8088",			"Only permit 8088 code",		intel_8086,		flag_086	},
+	{ "--8088",			"Only permit 8088 code",		intel_8086|eight_bit_bus,flag_086	},
 	{ "--80186",			"Only permit 80186 and earlier code",	intel_80186,		flag_186	},
-	{ "--80188",			"Only permit 80188 and earlier code",	intel_80186,		flag_186	},
+	{ "--80188",			"Only permit 80188 and earlier code",	intel_80186|eight_bit_bus,flag_186	},
 	{ "--80286",			"Only permit 80286 and earlier code",	intel_80286,		flag_286	},
 	{ "--access-segments",		"Permit assignment to segments",	allow_segment_access,	flag_seg	},
 	{ "--position-dependent",	"Permit fixed/absolute position code",	allow_position_dependent,flag_abs	},
@@ -102,6 +120,15 @@ static struct {
 
 #ifdef VERIFICATION
 	{ "--dump-opcodes",		"Dump internal opcode table",		dump_opcodes,		flag_none	},
+	{ "--benchmark",		"Time assembly of synthetic sources",	run_benchmark,		flag_none	},
+	{ "--micro-benchmark",		"Time the core routines in isolation",	run_micro_benchmark,	flag_none	},
+	{ "--disassemble",		"List binary files as assembly language", disassemble_code,	flag_none	},
+	{ "--round-trip",		"Assemble and decode every instruction form", round_trip_forms,	flag_none	},
+#endif
+
+#ifdef EXECUTION
+	{ "--execute",			"Run '.COM' files in the interpreter",	execute_programs,	flag_none	},
+	{ "--run",			"Run the '.COM' file once assembled",	run_program,		flag_none	},
 #endif
 
 	{ "--verbose",			"Show extra details during assembly",	be_verbose,		flag_none	},
@@ -109,6 +136,102 @@ static struct {
 	{ NIL( char ) }
 };
 
+#ifdef VERIFICATION
+/*
+ *	Number of threads used to verify concurrent assembly.
+ */
+static char *verify_threads = NIL( char );
+
+/*
+ *	The benchmark scenario, repeat count and the file any
+ *	generated source is written to.
+ */
+static char *bench_scenario_text = NIL( char );
+static char *bench_repeat = NIL( char );
+static char *bench_generate = NIL( char );
+
+/*
+ *	The micro-benchmark warm-up count and the baseline (with
+ *	its percentage threshold) results are compared against.
+ */
+static char *bench_warm_up = NIL( char );
+static char *bench_baseline = NIL( char );
+static char *bench_threshold = NIL( char );
+
+/*
+ *	The file the opcode dump is written to in binary form.
+ */
+static char *dump_binary = NIL( char );
+
+/*
+ *	The address binary files are disassembled from.
+ */
+static char *disassemble_origin = NIL( char );
+
+/*
+ *	The number of rounds of (random) instruction forms and
+ *	the seed they are generated from.
+ */
+static char *round_trip_rounds = NIL( char );
+static char *round_trip_seed = NIL( char );
+#endif
+
+/*
+ *	Number of worker threads used when assembling more
+ *	than one file.
+ */
+static char *worker_count = NIL( char );
+
+/*
+ *	The socket a persistent server listens on and a flag set
+ *	while that server is running requests.
+ */
+static char *server_socket = NIL( char );
+static boolean serving = FALSE;
+
+/*
+ *	Options which take a value, given as "--option=value" (or
+ *	as "-j N" where the value follows as a separate argument).
+ */
+static struct {
+	char		*option,
+			*explain;
+	char		**value;
+} possible_option[] = {
+	{ "--cache-dir=",		"Cache assembly results in directory",	&cache_directory	},
+	{ "--cache-size=",		"Limit cache directory size (KBytes)",	&cache_size		},
+	{ "--jobs=",			"Assemble files on N worker threads",	&worker_count		},
+	{ "-j",				"Assemble files on N worker threads",	&worker_count		},
+	{ "--stats=",			"Report per pass as 'text' or 'json'",	&stats_format		},
+	{ "--lex-threads=",		"Tokenise each file on N threads",	&tokenise_threads	},
+	{ "--server=",			"Serve assembly requests on a socket",	&server_socket		},
+
+#ifdef MEMORY_ACCOUNTING
+	{ "--memory-budget=",		"Fail if peak memory use exceeds N bytes", &memory_budget	},
+#endif
+
+#ifdef VERIFICATION
+	{ "--verify-threads=",		"Assemble files concurrently on N threads", &verify_threads	},
+	{ "--scenario=",		"Benchmark scenario name or settings",	&bench_scenario_text	},
+	{ "--repeat=",			"Repeat each benchmark N times",	&bench_repeat		},
+	{ "--generate=",		"Write the scenario source to a file",	&bench_generate		},
+	{ "--warm-up=",			"Micro-benchmark warm-up runs",		&bench_warm_up		},
+	{ "--baseline=",		"Compare micro-benchmarks with a file",	&bench_baseline		},
+	{ "--threshold=",		"Percentage slower counted a regression", &bench_threshold	},
+	{ "--dump-binary=",		"Write the opcode dump to a binary file", &dump_binary		},
+	{ "--origin=",			"Address a disassembled file loads at",	&disassemble_origin	},
+	{ "--rounds=",			"Round trip every form N times",	&round_trip_rounds	},
+	{ "--seed=",			"Seed the random round trip forms",	&round_trip_seed	},
+#endif
+
+#ifdef EXECUTION
+	{ "--sandbox=",			"Directory programs run may use files in", &execute_sandbox	},
+	{ "--steps=",			"Most instructions a program may run",	&execute_steps		},
+#endif
+
+	{ NIL( char ) }
+};
+
 /*
  *	Pick out the flags
  */
@@ -126,10 +249,51 @@ static boolean process_flags( int *argc, char *argv[] ) {
 			assembler_parameters |= possible_flag[ j ].params;
 			for( k = i; k < *argc; k++ ) argv[ k ] = argv[ k+1 ];
 			*argc -= 1;
+			continue;
 		}
-		else {
-			i++;
+		for( j = 0; possible_option[ j ].option != NIL( char ); j++ ) {
+			if( strncmp( argv[ i ], possible_option[ j ].option, strlen( possible_option[ j ].option )) == 0 ) break;
+		}
+		if( possible_option[ j ].option != NIL( char )) {
+			*( possible_option[ j ].value ) = argv[ i ] + strlen( possible_option[ j ].option );
+			for( k = i; k < *argc; k++ ) argv[ k ] = argv[ k+1 ];
+			*argc -= 1;
+			if(( **( possible_option[ j ].value ) == EOS )&&( i < *argc )) {
+				*( possible_option[ j ].value ) = argv[ i ];
+				for( k = i; k < *argc; k++ ) argv[ k ] = argv[ k+1 ];
+				*argc -= 1;
+			}
+			continue;
 		}
+		i++;
+	}
+	if( stats_format != NIL( char )) {
+		if(( strcmp( stats_format, "text" ) != 0 )&&( strcmp( stats_format, "json" ) != 0 )) {
+			log_error_s( "Unrecognised statistics format", stats_format );
+			return( FALSE );
+		}
+		command_flags |= show_statistics;
+	}
+
+#ifdef MEMORY_ACCOUNTING
+	if( memory_budget != NIL( char )) {
+		char	*end;
+
+		/*
+		 *	A number of bytes, or of KBytes with a 'K'.
+		 */
+		(void)strtol( memory_budget, &end, 10 );
+		if(( *end == 'k' )||( *end == 'K' )) end++;
+		if(( !isdigit( *memory_budget ))||( *end != EOS )) {
+			log_error_s( "Invalid memory budget", memory_budget );
+			return( FALSE );
+		}
+	}
+#endif
+
+	if( serving && BOOL( command_flags & ( show_version | show_help ))) {
+		log_error( "Option not available through server" );
+		return( FALSE );
 	}
 	if( BOOL( command_flags & show_version )) {
 		printf( "Version details:-\n" );
@@ -140,64 +304,206 @@ static boolean process_flags( int *argc, char *argv[] ) {
 	if( BOOL( command_flags & show_help )) {
 		printf( "Options:-\n" );
 		for( i = 0; possible_flag[ i ].flag != NIL( char ); i++ ) printf( "\t%-24s%s\n", possible_flag[ i ].flag, possible_flag[ i ].explain );
+		for( i = 0; possible_option[ i ].option != NIL( char ); i++ ) printf( "\t%-24s%s\n", possible_option[ i ].option, possible_option[ i ].explain );
 		exit( 0 );
 	}
 
 #ifdef VERIFICATION
+	if( serving && ( BOOL( command_flags & ( dump_opcodes | run_benchmark | run_micro_benchmark | disassemble_code | round_trip_forms ))||( verify_threads != NIL( char ))||( bench_generate != NIL( char )))) {
+		log_error( "Option not available through server" );
+		return( FALSE );
+	}
 	if( BOOL( command_flags & dump_opcodes )) {
 
 		ASSERT( this_pass == no_pass );
 		
 		this_pass = data_verification;
-		if( BOOL( command_flags & be_verbose )) {
-			dump_opcode_list( BOOL( command_flags & more_verbose ));
-		}
-		else {
-			dump_opcode_table();
+		if( BOOL( command_flags & be_verbose )||( dump_binary != NIL( char ))) {
+			exit( dump_opcode_list( BOOL( command_flags & more_verbose ), ( worker_count != NIL( char ))? atoi( worker_count ): 1, dump_binary )? 0: 1 );
 		}
+		dump_opcode_table();
 		exit( 0 );
 	}
+	if( bench_generate != NIL( char )) {
+		bench_scenario	scenario;
+
+		if( !find_scenario(( bench_scenario_text != NIL( char ))? bench_scenario_text: "medium", &scenario )) exit( 1 );
+		exit(( generate_source( bench_generate, &scenario ) == ERROR )? 1: 0 );
+	}
+	if( BOOL( command_flags & run_benchmark )) {
+		exit( run_benchmarks( bench_scenario_text, ( bench_repeat != NIL( char ))? atoi( bench_repeat ): 3 )? 0: 1 );
+	}
+	if( BOOL( command_flags & run_micro_benchmark )) {
+		exit( run_micro_benchmarks( bench_scenario_text,
+				( bench_warm_up != NIL( char ))? atoi( bench_warm_up ): 5,
+				( bench_repeat != NIL( char ))? atoi( bench_repeat ): 51,
+				bench_baseline,
+				( bench_threshold != NIL( char ))? atoi( bench_threshold ): 10 )? 0: 1 );
+	}
 #endif
 
+	/*
+	 *	A server takes its CPU and output selections from
+	 *	each request.
+	 */
+	if( server_socket != NIL( char )) {
+		if( serving ) {
+			log_error( "Server already running" );
+			return( FALSE );
+		}
+		return( TRUE );
+	}
 	if( !BOOL( command_flags & cpu_selection_mask )) {
 		log_error( "Target CPU not specified" );
 		return( FALSE );
 	}
-	if( !BOOL( command_flags & output_selection_mask )) {
+
+#ifdef VERIFICATION
+	if( verify_threads != NIL( char )) {
+		exit( verify_concurrency( *argc-1, argv+1, atoi( verify_threads ))? 0: 1 );
+	}
+	if( BOOL( command_flags & disassemble_code )) {
+		exit( disassemble_files( *argc-1, argv+1, (word)(( disassemble_origin != NIL( char ))? strtol( disassemble_origin, NIL( char * ), 0 ): 0x100 ))? 0: 1 );
+	}
+	if( BOOL( command_flags & round_trip_forms )) {
+		exit( verify_round_trip(( worker_count != NIL( char ))? atoi( worker_count ): 1,
+				( round_trip_rounds != NIL( char ))? atoi( round_trip_rounds ): 1,
+				( round_trip_seed != NIL( char ))? (dword)strtoul( round_trip_seed, NIL( char * ), 0 ): 1 )? 0: 1 );
+	}
+#endif
+
+#ifdef EXECUTION
+	if( serving && BOOL( command_flags & ( execute_programs | run_program ))) {
+		log_error( "Option not available through server" );
+		return( FALSE );
+	}
+	if( BOOL( command_flags & execute_programs )) {
+		exit( execute_files( *argc-1, argv+1 ));
+	}
+	if( BOOL( command_flags & run_program )) {
+		if( !BOOL( command_flags & generate_dot_com )|| BOOL( command_flags & generate_hex )) {
+			log_error( "Running requires binary '.COM' output" );
+			return( FALSE );
+		}
+		initialise_execution();
+	}
+#endif
+
+	if( !BOOL( command_flags & ( output_selection_mask | generate_listing | generate_map | generate_depend ))) {
 		log_error( "Output format not specified" );
 		return( FALSE );
 	}
+	if( BOOL( command_flags & list_clocks )&& !BOOL( command_flags & generate_listing )) {
+		log_error( "Clock estimates require a listing" );
+		return( FALSE );
+	}
 	return( TRUE );
 }
 
+#ifdef EXECUTION
 /*
- *	The main entry point for the "i8086" assembler.
+ *	Run the '.COM' file assembled from the source named,
+ *	returning its exit status (or 1 if it faulted).
  */
-int main( int argc, char *argv[] ) {
-	int	count;
+static int run_output( char *name ) {
+	char	*s, *t;
+	int	status;
+
+	if( !BOOL( command_flags & run_program )) return( 0 );
+	s = strcpy( STACK_ARRAY( char, strlen( name ) + 5 ), name );
+	if(( t = strrchr( s, PERIOD ))) *t = EOS;
+	strcat( s, ".com" );
+	return( execute_program( s, &status )? status: 1 );
+}
+#else
+#define run_output(n)	0
+#endif
+
+/*
+ *	Assemble a single source file in the current context,
+ *	returning the exit status.
+ */
+static int assemble_source( char *name ) {
+	boolean	ok;
 
 	/*
-	 *	Process out arguments
+	 *	A server supplies source files from its cache.
 	 */
-	if( !process_flags( &argc, argv )) {
-		log_error( "Error detected in assembler options" );
+	if( serving ) set_source_resolver( server_resolver, NIL( void ));
+	/*
+	 *	Set up output data
+	 */
+	if( BOOL( command_flags & generate_dot_com )) initialise_output( &com_output_api, BOOL( command_flags & generate_hex ));
+	/*
+	 *	If a cache has been requested the results may
+	 *	already be available.
+	 */
+	if( cache_restore( name )) return( run_output( name ));
+	/*
+	 *	Initialise the selected output mechanism and, if
+	 *	requested, the listing which runs alongside it.
+	 */
+	if( !open_file( name )) {
+		log_error( "Unable to initialise output." );
+		return( 1 );
+	}
+	if( BOOL( command_flags & generate_listing ) && !open_listing( name )) {
+		log_error( "Unable to initialise listing." );
+		(void)close_file();
 		return( 1 );
 	}
 	/*
-	 *	We should have just one argument left, the file name.
+	 *	Run all of the assembler passes.
 	 */
-	if( argc != 2 ) {
-		log_error( "Expecting one source file" );
+	ok = assemble_file( name );
+	if( BOOL( command_flags & report_convergence )) write_convergence( report_stream(), name );
+	if( BOOL( command_flags & optimize_size )&& ok ) write_size_savings( report_stream(), name );
+	if( BOOL( command_flags & expand_branches )&& ok ) write_branch_expansions( report_stream(), name );
+	if( BOOL( command_flags & show_statistics )) write_statistics( report_stream(), name, ( stats_format != NIL( char ))&&( strcmp( stats_format, "json" ) == 0 ));
+	if( !ok ) {
+		(void)close_listing();
+		(void)close_file();
 		return( 1 );
 	}
 	/*
-	 *	Set up output data
+	 *	If we get here we have succeeded.
+	 */
+	if( !close_listing()) {
+		log_error( "Unable to finalise listing." );
+		(void)close_file();
+		return( 1 );
+	}
+	if( BOOL( command_flags & generate_map ) && !write_map( name )) {
+		log_error( "Unable to create symbol map." );
+		(void)close_file();
+		return( 1 );
+	}
+	if( BOOL( command_flags & generate_depend ) && !write_depend( name )) {
+		log_error( "Unable to create dependency file." );
+		(void)close_file();
+		return( 1 );
+	}
+	if( !close_file()) {
+		log_error( "Unable to finalise output." );
+		return( 1 );
+	}
+	cache_store( name );
+	return( run_output( name ));
+}
+
+/*
+ *	Assemble the files named in the (already processed)
+ *	arguments, returning the exit status.
+ */
+static int assemble_sources( int argc, char *argv[] ) {
+	char	**names;
+	int	files,
+		status;
+
+	/*
+	 *	Check the output selected is available.
 	 */
 	switch( command_flags & output_selection_mask ) {
-		case generate_dot_com: {
-			initialise_output( &com_output_api, BOOL( command_flags & generate_hex ));
-			break;
-		}
 		case generate_dot_exe: {
 			log_error( ".EXE not implemented" );
 			return( 1 );
@@ -206,43 +512,214 @@ int main( int argc, char *argv[] ) {
 			log_error( ".OBJ not implemented" );
 			return( 1 );
 		}
-		case generate_listing: {
-			initialise_output( &listing_output_api, BOOL( command_flags & generate_hex ));
+		default: {
 			break;
 		}
 	}
 	/*
-	 *	Initialise the selected output mechanism
+	 *	The remaining arguments are the source files (or
+	 *	response files listing them).
 	 */
-	if( !open_file( argv[ 1 ])) {
-		log_error( "Unable to initialise output." );
+	if((( names = gather_sources( argc-1, argv+1, &files )) == NIL( char * ))||( files == 0 )) {
+		log_error( "Expecting source files" );
+		release_sources( names, files, argc-1, argv+1 );
 		return( 1 );
 	}
+	if( BOOL( command_flags & watch_for_changes )) {
+		if( serving ) {
+			log_error( "Option not available through server" );
+			status = 1;
+		}
+		else {
+			/*
+			 *	Source files are held in memory between each
+			 *	assembly, so the cache is not used.
+			 */
+			cache_directory = NIL( char );
+			status = watch_sources( files, names, assemble_source );
+		}
+	}
+	else if( files == 1 ) {
+		status = assemble_source( names[ 0 ]);
+	}
+	else {
+		status = assemble_batch( files, names, ( worker_count != NIL( char ))? atoi( worker_count ): 1, assemble_source );
+	}
 	/*
-	 *	We run the file processing code until the reset_state
-	 *	routine says we have done it enough.
+	 *	A server runs many requests, so tidies up after each.
 	 */
-	count = 0;
-	while( reset_state()) {
-		count++;
-		if( BOOL( command_flags & be_verbose )) printf( "Start PASS %d.\n", count );
-		if( !process_file( argv[ 1 ])) {
-			log_error( "Assembly terminated" );
-			(void)close_file();
-			return( 1 );
+	release_sources( names, files, argc-1, argv+1 );
+	return( status );
+}
+
+/*
+ *	Number of entries (including the end marker) in the table
+ *	of options taking a value.
+ */
+#define VALUE_OPTIONS	(sizeof( possible_option ) / sizeof( possible_option[ 0 ]))
+
+/*
+ *	The files tokenised in advance for earlier requests, kept
+ *	for the requests which follow from the same directory with
+ *	the same options (which can change how a file tokenises).
+ */
+typedef struct _warm_tokens {
+	char			*directory;
+	command_flag		flags;
+	mnemonic_flags		parameters;
+	lexed_file		*files;
+	struct _warm_tokens	*next;
+} warm_tokens;
+
+static warm_tokens *warm_files = NIL( warm_tokens );
+
+/*
+ *	Find (or start) the tokenised files for the current
+ *	directory and options, NIL if the directory is unknown.
+ */
+static warm_tokens *find_warm_tokens( void ) {
+	char		cwd[ PATH_MAX ];
+	warm_tokens	*look;
+
+	if( getcwd( cwd, sizeof( cwd )) == NIL( char )) return( NIL( warm_tokens ));
+	for( look = warm_files; look; look = look->next ) {
+		if(( look->flags == command_flags )&&( look->parameters == assembler_parameters )&&( strcmp( look->directory, cwd ) == 0 )) return( look );
+	}
+	look = NEW( warm_tokens );
+	look->directory = NEW_STRING( cwd );
+	look->flags = command_flags;
+	look->parameters = assembler_parameters;
+	look->files = NIL( lexed_file );
+	look->next = warm_files;
+	warm_files = look;
+	return( look );
+}
+
+/*
+ *	Release all of the tokenised files kept by the server.
+ */
+static void release_warm_tokens( void ) {
+	warm_tokens	*look;
+
+	while(( look = warm_files )) {
+		warm_files = look->next;
+		attach_tokenise( look->files );
+		release_tokenise();
+		FREE( look->directory );
+		FREE( look );
+	}
+}
+
+/*
+ *	Run a single request on behalf of the server in a context
+ *	of its own.  Options given by a request apply only to that
+ *	request: every option taking a value starts at its default,
+ *	bar the cache settings which the server supplies, and all
+ *	are put back once the request is complete.  Reports and
+ *	verbose output are returned with the diagnostics.
+ */
+static int serve_request( int argc, char *argv[], FILE *errors ) {
+	assembler_context	*context,
+				*previous;
+	warm_tokens		*warm;
+	char			*saved[ VALUE_OPTIONS ];
+	int			status,
+				i;
+
+	for( i = 0; possible_option[ i ].option != NIL( char ); i++ ) {
+		saved[ i ] = *( possible_option[ i ].value );
+		if(( possible_option[ i ].value != &cache_directory )&&( possible_option[ i ].value != &cache_size )) *( possible_option[ i ].value ) = NIL( char );
+	}
+	context = new_context();
+	previous = select_context( context );
+	set_error_stream( errors );
+	set_report_stream( errors );
+	if( !process_flags( &argc, argv )) {
+		log_error( "Error detected in assembler options" );
+		status = 1;
+	}
+
+#ifdef MEMORY_ACCOUNTING
+	else if( memory_budget != NIL( char )) {
+		log_error( "Option not available through server" );
+		status = 1;
+	}
+#endif
+
+	else {
+		/*
+		 *	Files are always tokenised in advance, so their
+		 *	tokens can be kept for the next request; any file
+		 *	changed since is tokenised again.
+		 */
+		if( tokenise_threads == NIL( char )) tokenise_threads = "1";
+		if(( warm = find_warm_tokens())) {
+			set_source_resolver( server_resolver, NIL( void ));
+			attach_tokenise( check_lexed( warm->files ));
 		}
-		if( BOOL( command_flags & be_verbose ) && ( this_pass == pass_value_confirmation )) dump_labels();
+		status = assemble_sources( argc, argv );
+		if( warm ) warm->files = detach_tokenise();
 	}
+	delete_context( context );
+	(void)select_context( previous );
 	/*
-	 *	If we get here we have succeeded.
+	 *	Backwards, so where options share a value ("--jobs="
+	 *	and "-j") it is the one saved before clearing that
+	 *	is restored last.
 	 */
-	if( !close_file()) {
-		log_error( "Unable to finalise output." );
+	while( i-- ) *( possible_option[ i ].value ) = saved[ i ];
+	return( status );
+}
+
+/*
+ *	The main entry point for the "i8086" assembler.
+ */
+int main( int argc, char *argv[] ) {
+	int	status;
+
+	/*
+	 *	A client passes its arguments on to a server.
+	 */
+	if(( argc > 1 )&&( strncmp( argv[ 1 ], "--client=", 9 ) == 0 )) return( run_client( argv[ 1 ]+9, argc-2, argv+2 ));
+	/*
+	 *	The flags are gathered into the context of the
+	 *	main thread.
+	 */
+	(void)select_context( new_context());
+	/*
+	 *	Process out arguments
+	 */
+	if( !process_flags( &argc, argv )) {
+		log_error( "Error detected in assembler options" );
 		return( 1 );
 	}
-	return( 0 );
+	if( server_socket != NIL( char )) {
+		/*
+		 *	Each request runs in the client's directory,
+		 *	so the cache must be found independently.
+		 */
+		if(( cache_directory != NIL( char ))&&(( cache_directory = absolute_path( cache_directory )) == NIL( char ))) {
+			log_error( "Unable to find current directory" );
+			return( 1 );
+		}
+		serving = TRUE;
+		status = run_server( server_socket, serve_request );
+		release_warm_tokens();
+		if( cache_directory ) FREE( cache_directory );
+	}
+	else {
+		status = assemble_sources( argc, argv );
+	}
+
+#ifdef MEMORY_ACCOUNTING
+	if( !memory_report( stdout ) && ( status == 0 )) status = 1;
+#endif
+
+	return( status );
 }
 
+#endif
+
 /*
  *	EOF
  */
@@ -23,19 +23,63 @@
  *	System for classification and storage of labels with values.
  */
 
+#define MEMORY_TAG	memory_identifiers
+
 #include "os.h"
 #include "includes.h"
 
 /*
- *	Sabed labels are all located below this variable.
+ *	The identifier state is held in the assembler context.
+ */
+#define label_slabs		(this_context->identifiers.slabs)
+#define label_values		(this_context->identifiers.values)
+#define label_scopes		(this_context->identifiers.scopes)
+#define label_segments		(this_context->identifiers.segments)
+#define segment_table		(this_context->identifiers.segment_table)
+#define group_table		(this_context->identifiers.group_table)
+#define segment_count		(this_context->identifiers.segment_count)
+#define group_count		(this_context->identifiers.group_count)
+#define label_names		(this_context->identifiers.names)
+#define label_site_lists	(this_context->identifiers.sites)
+#define label_site_count	(this_context->identifiers.site_count)
+#define uniqueness		(this_context->identifiers.uniqueness)
+#define saved_label_count	(this_context->identifiers.saved_label_count)
+#define label_slab_count	(this_context->identifiers.slab_count)
+#define label_space		(this_context->identifiers.label_space)
+
+/*
+ *	Return the number of records in a slab; they double in size
+ *	until they reach IDENTIFIER_SLAB_SIZE.
  */
-static id_record *saved_labels = NIL( id_record );
+static int slab_size( int slab ) {
+	int	size;
+
+	for( size = IDENTIFIER_FIRST_SLAB; slab && ( size < IDENTIFIER_SLAB_SIZE ); slab-- ) size <<= 1;
+	return( size );
+}
 
 /*
- *	The 'Uniqueness' number that tracks labels as they are defined
- *	allowing the creation of "localised" labels.
+ *	Locate an index within the slabs, returning its position
+ *	in the slab found.
  */
-static int uniqueness = 0;
+static int label_slot( int index, int *slab ) {
+	int	size;
+
+	for( *slab = 0, size = IDENTIFIER_FIRST_SLAB; ( index >= size )&&( size < IDENTIFIER_SLAB_SIZE ); (*slab)++, size <<= 1 ) index -= size;
+	*slab += index / size;
+	return( index % size );
+}
+
+/*
+ *	Locate a record within the slabs.
+ */
+static id_record *label_at( int index ) {
+	int	slab, at;
+
+	at = label_slot( index, &slab );
+	return( &( label_slabs[ slab ][ at ]));
+}
+#define LABEL_AT(i)		label_at(i)
 
 
 /*
@@ -55,15 +99,216 @@ void restart_identifiers( void ) {
 #define UNIQUENESS_PREFIX	"L%04X_"
 #define MAXIMUM_UNIQUENESS	MAX_UWORD
 
+/*
+ *	Note where a label has been found in the source code.  This
+ *	is only done during the label gathering pass (so each site is
+ *	seen exactly once) and only when a map has been requested.
+ */
+static id_record *note_site( id_record *label, boolean definition ) {
+	id_site_list	*list;
+	id_site		*site;
+
+	if(( this_pass == pass_label_gathering )&& BOOL( command_flags & generate_map )) {
+		/*
+		 *	The site lists are grown to cover all the
+		 *	records as required.
+		 */
+		if(( int )label->index >= label_site_count ) {
+			int	i, size;
+
+			size = ( saved_label_count + IDENTIFIER_SLAB_SIZE ) & ~( IDENTIFIER_SLAB_SIZE-1 );
+			label_site_lists = RESIZE_ARRAY( label_site_lists, id_site_list, size );
+			for( i = label_site_count; i < size; i++ ) {
+				label_site_lists[ i ].first = NIL( id_site );
+				label_site_lists[ i ].last = &( label_site_lists[ i ].first );
+			}
+			/*
+			 *	Lists moved by the resize need their tails
+			 *	pointing into the new array.
+			 */
+			for( i = 0; i < label_site_count; i++ ) {
+				if( label_site_lists[ i ].first == NIL( id_site )) label_site_lists[ i ].last = &( label_site_lists[ i ].first );
+			}
+			label_site_count = size;
+		}
+		list = &( label_site_lists[ label->index ]);
+		site = NEW( id_site );
+		(void)current_line( &( site->file ), &( site->line ));
+		site->definition = definition;
+		site->next = NIL( id_site );
+		*( list->last ) = site;
+		list->last = &( site->next );
+	}
+	return( label );
+}
+
+/*
+ *	Return the sites of a label.
+ */
+id_site *label_sites( id_record *label ) {
+	ASSERT( label != NIL( id_record ));
+
+	return(( (int)label->index < label_site_count )? label_site_lists[ label->index ].first: NIL( id_site ));
+}
+
+/*
+ *	Return the record at an index.
+ */
+id_record *label_record( id_index index ) {
+	ASSERT( (int)index < saved_label_count );
+
+	return( LABEL_AT( index ));
+}
+
+/*
+ *	Fetch the value of a label or constant.
+ */
+void get_label_value( id_record *label, constant_value *value ) {
+	id_index	seg;
+	int		slab, at;
+
+	ASSERT( label != NIL( id_record ));
+	ASSERT( value != NIL( constant_value ));
+
+	at = label_slot( label->index, &slab );
+	value->value = label_values[ slab ][ at ];
+	value->scope = (value_scope)label_scopes[ slab ][ at ];
+	value->segment = ( seg = label_segments[ slab ][ at ])? segment_table[ seg ]: NIL( segment_record );
+}
+
+/*
+ *	Save the value of a label or constant.
+ */
+void set_label_value( id_record *label, constant_value *value ) {
+	int	slab, at;
+
+	ASSERT( label != NIL( id_record ));
+	ASSERT( value != NIL( constant_value ));
+
+	at = label_slot( label->index, &slab );
+	label_values[ slab ][ at ] = value->value;
+	label_scopes[ slab ][ at ] = (byte)value->scope;
+	label_segments[ slab ][ at ] = value->segment? value->segment->number: 0;
+}
+
+/*
+ *	Return the segment index held for a record.
+ */
+static id_index segment_index( id_record *label ) {
+	int	slab, at;
+
+	at = label_slot( label->index, &slab );
+	return( label_segments[ slab ][ at ]);
+}
+
+/*
+ *	Set the segment index held for a record.
+ */
+static void set_segment_index( id_record *label, id_index seg ) {
+	int	slab, at;
+
+	at = label_slot( label->index, &slab );
+	label_segments[ slab ][ at ] = seg;
+}
+
+/*
+ *	Return the segment record of a segment identifier.
+ */
+segment_record *label_segment( id_record *label ) {
+	id_index	seg;
+
+	ASSERT( label != NIL( id_record ));
+	ASSERT( label->type == class_segment );
+
+	seg = segment_index( label );
+
+	ASSERT(( seg > 0 )&&( seg <= (id_index)segment_count ));
+
+	return( segment_table[ seg ]);
+}
+
+/*
+ *	Add a segment record to the table, and note its segment
+ *	index against the identifier.
+ */
+void set_label_segment( id_record *label, segment_record *segment ) {
+	ASSERT( label != NIL( id_record ));
+	ASSERT( segment != NIL( segment_record ));
+
+	segment_table = RESIZE_ARRAY( segment_table, segment_record *, segment_count+2 );
+	segment_table[ ++segment_count ] = segment;
+	segment->number = segment_count;
+	set_segment_index( label, segment_count );
+}
+
+/*
+ *	Return the group record of a group identifier.
+ */
+segment_group *label_group( id_record *label ) {
+	id_index	grp;
+
+	ASSERT( label != NIL( id_record ));
+	ASSERT( label->type == class_group );
+
+	return(( grp = segment_index( label ))? group_table[ grp ]: NIL( segment_group ));
+}
+
+/*
+ *	Add a group record to the table (unless NIL), and note
+ *	its index against the identifier.
+ */
+void set_label_group( id_record *label, segment_group *group ) {
+	ASSERT( label != NIL( id_record ));
+
+	if( group == NIL( segment_group )) {
+		set_segment_index( label, 0 );
+		return;
+	}
+	group_table = RESIZE_ARRAY( group_table, segment_group *, group_count+2 );
+	group_table[ ++group_count ] = group;
+	set_segment_index( label, group_count );
+}
+
+/*
+ *	Save a name in the blocks of names.
+ */
+static char *save_label_name( char *label ) {
+	id_name_block	*block;
+	int		len;
+
+	len = strlen( label ) + 1;
+	if((( block = label_names ) == NIL( id_name_block ))||( block->used + len > block->size )) {
+		int	size = block? block->size << 1: IDENTIFIER_FIRST_NAMES;
+
+		/*
+		 *	Each block is twice the size of the one before,
+		 *	up to IDENTIFIER_NAME_BLOCK.
+		 */
+		if( size > IDENTIFIER_NAME_BLOCK ) size = IDENTIFIER_NAME_BLOCK;
+		if( size < len ) size = len;
+
+		block = (id_name_block *)NEW_ARRAY( byte, sizeof( id_name_block ) + size );
+		block->used = 0;
+		block->size = size;
+		block->next = label_names;
+		label_names = block;
+	}
+	memcpy( block->name + block->used, label, len );
+	block->used += len;
+	return( block->name + block->used - len );
+}
+
 /*
  *	Save/Find a label record.
  */
 id_record *find_label( char *label, boolean definition ) {
-	id_record	**adrs,
-			*look;
+	id_record	*look,
+			*slab;
+	int		i, j, k, n, at, size;
 
 	ASSERT( label != NIL( char ));
 
+	pass_stats.labels++;
 	/*
 	 *	If the label starts with a PERIOD then this is
 	 *	a locally referenced label.
@@ -80,7 +325,7 @@ id_record *find_label( char *label, boolean definition ) {
 		len = strlen( label ) + UNIQUENESS_SIZE + 1;
 		temp = STACK_ARRAY( char, len );
 		sprintf( temp, UNIQUENESS_PREFIX "%s", uniqueness, label+1 );
-		if( BOOL( command_flags & more_verbose )) printf( "Localise %s -> %s\n", label, temp );
+		if( BOOL( command_flags & more_verbose )) fprintf( report_stream(), "Localise %s -> %s\n", label, temp );
 		label = temp;
 	}
 	else if( definition ) {
@@ -97,32 +342,116 @@ id_record *find_label( char *label, boolean definition ) {
 		}
 	}
 	/*
-	 *	Find/Insert the label into the list of all
-	 *	known labels.
+	 *	Find the label amongst all of the known labels,
+	 *	a slab at a time.
 	 */
-	adrs = &( saved_labels );
-	if( BOOL( command_flags & ignore_label_case )) {
-		while(( look = *adrs )) {
-			if( strcasecmp( look->id, label ) == 0 ) {
-				return( look );
-			}
-			adrs = &( look->next );
+	for( i = 0, k = 0; i < saved_label_count; i += size, k++ ) {
+		slab = label_slabs[ k ];
+		size = slab_size( k );
+		n = saved_label_count - i;
+		if( n > size ) n = size;
+		if( BOOL( command_flags & ignore_label_case )) {
+			for( j = 0; j < n; j++ ) if( strcasecmp( slab[ j ].id, label ) == 0 ) return( note_site( &( slab[ j ]), definition ));
 		}
-	}
-	else {
-		while(( look = *adrs )) {
-			if( strcmp( look->id, label ) == 0 ) {
-				return( look );
-			}
-			adrs = &( look->next );
+		else {
+			for( j = 0; j < n; j++ ) if( strcmp( slab[ j ].id, label ) == 0 ) return( note_site( &( slab[ j ]), definition ));
 		}
 	}
-	look = NEW( id_record );
-	look->id = strdup( label );
+	/*
+	 *	Add a new record, starting a new slab if
+	 *	required.
+	 */
+	if( saved_label_count == label_space ) {
+		size = slab_size( label_slab_count );
+		label_slabs = RESIZE_ARRAY( label_slabs, id_record *, label_slab_count+1 );
+		label_values = RESIZE_ARRAY( label_values, integer *, label_slab_count+1 );
+		label_scopes = RESIZE_ARRAY( label_scopes, byte *, label_slab_count+1 );
+		label_segments = RESIZE_ARRAY( label_segments, id_index *, label_slab_count+1 );
+		label_slabs[ label_slab_count ] = NEW_ARRAY( id_record, size );
+		label_values[ label_slab_count ] = NEW_ARRAY( integer, size );
+		label_scopes[ label_slab_count ] = NEW_ARRAY( byte, size );
+		label_segments[ label_slab_count ] = NEW_ARRAY( id_index, size );
+		label_slab_count++;
+		label_space += size;
+	}
+	at = label_slot( saved_label_count, &k );
+	look = &( label_slabs[ k ][ at ]);
+	look->id = save_label_name( label );
 	look->type = class_unknown;
-	look->next = NIL( id_record );
-	*adrs = look;
-	return( look );
+	look->index = saved_label_count++;
+	label_values[ k ][ at ] = 0;
+	label_scopes[ k ][ at ] = scope_none;
+	label_segments[ k ][ at ] = 0;
+	return( note_site( look, definition ));
+}
+
+/*
+ *	Release all of the identifier records (and the segments
+ *	and groups they own), returning the identifier system to
+ *	its initial state.
+ */
+void release_identifiers( void ) {
+	id_name_block	*block;
+	id_site		*site;
+	int		i;
+
+	release_segments();
+	for( i = 1; i <= segment_count; i++ ) FREE( segment_table[ i ]);
+	for( i = 1; i <= group_count; i++ ) FREE( group_table[ i ]);
+	if( segment_table ) FREE( segment_table );
+	if( group_table ) FREE( group_table );
+	for( i = 0; i < label_site_count; i++ ) {
+		while(( site = label_site_lists[ i ].first )) {
+			label_site_lists[ i ].first = site->next;
+			FREE( site );
+		}
+	}
+	for( i = 0; i < label_slab_count; i++ ) {
+		FREE( label_slabs[ i ]);
+		FREE( label_values[ i ]);
+		FREE( label_scopes[ i ]);
+		FREE( label_segments[ i ]);
+	}
+	if( label_slabs ) FREE( label_slabs );
+	if( label_values ) FREE( label_values );
+	if( label_scopes ) FREE( label_scopes );
+	if( label_segments ) FREE( label_segments );
+	if( label_site_lists ) FREE( label_site_lists );
+	while(( block = label_names )) {
+		label_names = block->next;
+		FREE( block );
+	}
+	label_slabs = NIL( id_record * );
+	label_values = NIL( integer * );
+	label_scopes = NIL( byte * );
+	label_segments = NIL( id_index * );
+	segment_table = NIL( segment_record * );
+	group_table = NIL( segment_group * );
+	segment_count = 0;
+	group_count = 0;
+	label_site_lists = NIL( id_site_list );
+	label_site_count = 0;
+	saved_label_count = 0;
+	label_slab_count = 0;
+	label_space = 0;
+	uniqueness = 0;
+}
+
+/*
+ *	Return a freshly allocated array of pointers to all of the
+ *	label records, and the number of records in it.
+ */
+id_record **gather_labels( int *count ) {
+	id_record	**list;
+	int		i;
+
+	ASSERT( count != NIL( int ));
+
+	list = NEW_ARRAY( id_record *, saved_label_count+1 );
+	for( i = 0; i < saved_label_count; i++ ) list[ i ] = LABEL_AT( i );
+	list[ i ] = NIL( id_record );
+	*count = i;
+	return( list );
 }
 
 /*
@@ -130,13 +459,14 @@ id_record *find_label( char *label, boolean definition ) {
  *	as part of the verbose/debug output.
  */
 void dump_value( constant_value *v ) {
+	FILE	*to = report_stream();
 	char	scope[ BUFFER_FOR_SCOPE ];
 
 	ASSERT( v != NIL( constant_value ));
 
-	if( v->segment ) printf( " %s:", v->segment->name );
+	if( v->segment ) fprintf( to, " %s:", v->segment->name );
 	scope[ convert_scope_to_text( FALSE, v->scope, scope, BUFFER_FOR_SCOPE-1 )] = EOS;
-	printf( " %d($%04x)%s", (int)v->value, (unsigned int)v->value, scope );
+	fprintf( to, " %d($%04x)%s", (int)v->value, (unsigned int)v->value, scope );
 }
 
 
@@ -148,52 +478,56 @@ void dump_value( constant_value *v ) {
 void dump_labels( void ) {
 	static char *segment_names[ SEGMENT_REGISTERS ] = { "CS", "DS", "SS", "ES" };
 
+	FILE		*to = report_stream();
 	id_record	*look;
+	constant_value	value;
+	int		i;
 
-	printf( "Symbols:\n" );
-	for( look = saved_labels; look; look = look->next ) {
-		printf( "\t%s: ", look->id );
+	fprintf( to, "Symbols:\n" );
+	for( i = 0; i < saved_label_count; i++ ) {
+		look = LABEL_AT( i );
+		fprintf( to, "\t%s: ", look->id );
 		switch( look->type ) {
 			case class_unknown: {
-				printf( "Undefined.\n" );
+				fprintf( to, "Undefined.\n" );
 				break;
 			}
 			case class_label: {
-				printf( "label:" );
-				dump_value( &( look->var.value ));
-				printf( ".\n" );
+				fprintf( to, "label:" );
+				get_label_value( look, &value );
+				dump_value( &value );
+				fprintf( to, ".\n" );
 				break;
 			}
 			case class_const: {
-				printf( "const:" );
-				dump_value( &( look->var.value ));
-				printf( ".\n" );
+				fprintf( to, "const:" );
+				get_label_value( look, &value );
+				dump_value( &value );
+				fprintf( to, ".\n" );
 				break;
 			}
 			case class_group: {
 				segment_record	*seg;
 
-				ASSERT( look->var.group != NIL( segment_group ));
+				ASSERT( label_group( look ) != NIL( segment_group ));
 
-				printf( "group:" );
-				for( seg = look->var.group->segments; seg; seg = seg->next ) printf( " %s", seg->name );
-				printf( ".\n" );
+				fprintf( to, "group:" );
+				for( seg = label_group( look )->segments; seg; seg = seg->next ) fprintf( to, " %s", seg->name );
+				fprintf( to, ".\n" );
 				break;
 			}
 			case class_segment: {
 				segment_record	*seg;
 
-				ASSERT( look->var.segment != NIL( segment_record ));
-
-				seg = look->var.segment;
-				printf( "segment: " );
+				seg = label_segment( look );
+				fprintf( to, "segment: " );
 				if( seg->seg_reg < SEGMENT_REGISTERS ) {
-					printf( "%s:", segment_names[ seg->seg_reg ]);
+					fprintf( to, "%s:", segment_names[ seg->seg_reg ]);
 				}
 				else {
-					printf( "%d:", seg->seg_reg );
+					fprintf( to, "%d:", seg->seg_reg );
 				}
-				printf( " Start $%04x, Size %d.\n", (unsigned int)seg->start, (int)seg->size );
+				fprintf( to, " Start $%04x, Size %d.\n", (unsigned int)seg->start, (int)seg->size );
 				break;
 			}
 			default: {
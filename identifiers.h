@@ -48,21 +48,82 @@ typedef struct {
 	segment_record	*segment;
 } constant_value;
 
+/*
+ *	A record of where an identifier has been defined or
+ *	referenced in the source code.  These are only gathered
+ *	when a map file has been requested.
+ */
+typedef struct _id_site {
+	char			*file;
+	int			line;
+	boolean			definition;
+	struct _id_site		*next;
+} id_site;
+
 /*
  *	The data structure used to track all identifiers that are
  *	created in the assembly language file.
+ *
+ *	The records are held in dense arrays ("slabs") in the order
+ *	they were created, each knowing its position (index) in
+ *	them, and their names are held together in blocks of names.
+ *	A record never moves once created.
+ *
+ *	The values are held apart from the records as a structure
+ *	of arrays: slabs of values, scopes and segment indices laid
+ *	out in parallel with the record slabs and reached through
+ *	the same index.  A segment index is a position in the table
+ *	of segments (or, for a group, the table of groups) with 0
+ *	meaning none.
  */
+typedef uint32_t id_index;
+
 typedef struct _id_record {
 	char			*id;
 	id_class		type;
-	union {
-		constant_value		value;
-		segment_record		*segment;
-		segment_group		*group;
-	} var;
-	struct _id_record	*next;
+	id_index		index;
 } id_record;
 
+/*
+ *	A block of identifier names.
+ */
+typedef struct _id_name_block {
+	int			used,
+				size;
+	struct _id_name_block	*next;
+	char			name[];
+} id_name_block;
+
+/*
+ *	The definition and reference sites of an identifier.
+ */
+typedef struct {
+	id_site			*first,
+				**last;
+} id_site_list;
+
+/*
+ *	The identifier state held in the assembler context.
+ */
+typedef struct {
+	id_record		**slabs;		/* The records, in slabs growing to IDENTIFIER_SLAB_SIZE */
+	integer			**values;		/* The value of each record, in parallel slabs */
+	byte			**scopes;		/* The value_scope of each record, in parallel slabs */
+	id_index		**segments;		/* The segment index of each record, in parallel slabs */
+	segment_record		**segment_table;	/* The segments by segment index, [0] unused */
+	segment_group		**group_table;		/* The groups by segment index, [0] unused */
+	id_name_block		*names;			/* The names, most recent block first */
+	id_site_list		*sites;			/* Indexed by record, only kept for a map */
+	int			uniqueness,		/* Tracks labels as they are defined allowing */
+							/* the creation of "localised" labels */
+				saved_label_count,	/* Count of the labels saved */
+				slab_count,		/* Count of the slabs allocated */
+				label_space,		/* Records the slabs can hold */
+				site_count,		/* Records covered by the sites array */
+				segment_count,		/* Entries in use in the segment table */
+				group_count;		/* Entries in use in the group table */
+} identifiers_context;
+
 /*
  *	Reset identifier system to "top of input" for the start
  *	of a new pass.
@@ -74,6 +135,49 @@ extern void restart_identifiers( void );
  */
 extern id_record *find_label( char *label, boolean definition );
 
+/*
+ *	Release all of the identifier records, returning the
+ *	identifier system to its initial state.
+ */
+extern void release_identifiers( void );
+
+/*
+ *	Return the identifier record at the index given.
+ */
+extern id_record *label_record( id_index index );
+
+/*
+ *	Fetch or save the value of a label or constant.
+ */
+extern void get_label_value( id_record *label, constant_value *value );
+extern void set_label_value( id_record *label, constant_value *value );
+
+/*
+ *	Return or set the segment record of a segment identifier.
+ */
+extern segment_record *label_segment( id_record *label );
+extern void set_label_segment( id_record *label, segment_record *segment );
+
+/*
+ *	Return or set (NIL for none) the group record of a group
+ *	identifier.
+ */
+extern segment_group *label_group( id_record *label );
+extern void set_label_group( id_record *label, segment_group *group );
+
+/*
+ *	Return the sites at which a label was defined and referenced
+ *	(only gathered when a map has been requested).
+ */
+extern id_site *label_sites( id_record *label );
+
+/*
+ *	Return a freshly allocated array of pointers to all of the
+ *	label records, and the number of records in it.  The caller
+ *	is responsible for releasing the array.
+ */
+extern id_record **gather_labels( int *count );
+
 /*
  *	To support verbose-ness and debugging this routine can be called
  *	to produce a dump of the label held by the assembler at this point
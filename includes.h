@@ -27,8 +27,8 @@
 #define _INCLUDES_H_
 
 #include "verification.h"
-#include "memory.h"
 #include "definitions.h"
+#include "memory.h"
 #include "command_flags.h"
 #include "constants.h"
 #include "errors.h"
@@ -42,17 +42,36 @@
 #include "segments.h"
 #include "identifiers.h"
 #include "state.h"
+#include "stats.h"
 #include "output.h"
 #include "output_listing.h"
+#include "output_map.h"
+#include "output_depend.h"
+#include "cache.h"
 #include "output_com.h"
+#include "output_memory.h"
 #include "stuffing.h"
 #include "opcodes.h"
 #include "dump.h"
+#include "disassemble.h"
+#include "roundtrip.h"
+#include "execute.h"
+#include "concurrency.h"
+#include "benchmark.h"
+#include "microbench.h"
+#include "converge.h"
 #include "token.h"
+#include "tokenise.h"
+#include "pipeline.h"
 #include "evaluation.h"
 #include "assemble.h"
+#include "timing.h"
 #include "directives.h"
 #include "process.h"
+#include "context.h"
+#include "batch.h"
+#include "server.h"
+#include "watch.h"
 
 #endif
 
@@ -0,0 +1,215 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	libi8086
+ *	========
+ *
+ *	Implementation of the library interface to the assembler.
+ *	The source text (and any included files) are supplied from
+ *	memory through the source resolver, the machine code is
+ *	gathered through the memory output API and the symbols are
+ *	copied out of the identifier system.
+ *
+ *	Each assembly is performed in its own assembler context
+ *	which is released before returning, so separate threads
+ *	may assemble at the same time.
+ */
+
+#include "os.h"
+#include "includes.h"
+#include "libi8086.h"
+
+/*
+ *	The details of the assembly in progress, as seen by
+ *	the source resolver.
+ */
+typedef struct {
+	const char	*name,
+			*source;
+	int		len;
+	i8086_include	include;
+	void		*data;
+} library_request;
+
+/*
+ *	Supply the text of a file.
+ */
+static boolean library_resolver( char *name, void *data, char **text, int *len ) {
+	library_request	*req = (library_request *)data;
+	const char	*t;
+
+	if( strcmp( name, req->name ) == 0 ) {
+		*text = (char *)req->source;
+		*len = req->len;
+		return( TRUE );
+	}
+	if(( req->include == NULL )||( !FUNC( req->include )( name, req->data, &t, len ))) return( FALSE );
+	*text = (char *)t;
+	return( TRUE );
+}
+
+/*
+ *	Convert the library options into the command flags
+ *	and assembler parameters.
+ */
+static boolean library_options( unsigned int options ) {
+	switch( options & ( I8086_CPU_8086 | I8086_CPU_80186 | I8086_CPU_80286 )) {
+		case I8086_CPU_8086: {
+			command_flags |= intel_8086;
+			assembler_parameters |= flag_086;
+			break;
+		}
+		case I8086_CPU_80186: {
+			command_flags |= intel_80186;
+			assembler_parameters |= flag_186;
+			break;
+		}
+		case I8086_CPU_80286: {
+			command_flags |= intel_80286;
+			assembler_parameters |= flag_286;
+			break;
+		}
+		default: {
+			log_error( "Target CPU not specified" );
+			return( FALSE );
+		}
+	}
+	if( BOOL( options & I8086_IGNORE_KEYWORD_CASE )) command_flags |= ignore_keyword_case;
+	if( BOOL( options & I8086_IGNORE_LABEL_CASE )) command_flags |= ignore_label_case;
+	if( BOOL( options & I8086_ACCESS_SEGMENTS )) {
+		command_flags |= allow_segment_access;
+		assembler_parameters |= flag_seg;
+	}
+	if( BOOL( options & I8086_POSITION_DEPENDENT )) {
+		command_flags |= allow_position_dependent;
+		assembler_parameters |= flag_abs;
+	}
+	return( TRUE );
+}
+
+/*
+ *	Copy the symbols out of the identifier system.
+ */
+static void library_symbols( i8086_result *result ) {
+	id_record	**list;
+	i8086_symbol	*sym;
+	constant_value	value;
+	int		i;
+
+	list = gather_labels( &( result->symbol_count ));
+	result->symbols = NEW_ARRAY( i8086_symbol, result->symbol_count );
+	for( i = 0; i < result->symbol_count; i++ ) {
+		sym = &( result->symbols[ i ]);
+		sym->name = NEW_STRING( list[ i ]->id );
+		sym->segment = NULL;
+		sym->value = 0;
+		switch( list[ i ]->type ) {
+			case class_label:
+			case class_const: {
+				sym->kind = ( list[ i ]->type == class_label )? i8086_label: i8086_constant;
+				get_label_value( list[ i ], &value );
+				sym->value = value.value;
+				if( value.segment ) sym->segment = NEW_STRING( value.segment->name );
+				break;
+			}
+			case class_segment: {
+				sym->kind = i8086_segment;
+				sym->value = label_segment( list[ i ])->start;
+				break;
+			}
+			case class_group: {
+				sym->kind = i8086_group;
+				break;
+			}
+			default: {
+				sym->kind = i8086_undefined;
+				break;
+			}
+		}
+	}
+	FREE( list );
+}
+
+/*
+ *	Assemble the source text supplied.
+ */
+int i8086_assemble( const char *name, const char *source, int len, unsigned int options, i8086_include include, void *data, i8086_result *result ) {
+	library_request		req;
+	assembler_context	*context,
+				*previous;
+	boolean			ok;
+
+	ASSERT( name != NULL );
+	ASSERT( source != NULL );
+	ASSERT( result != NULL );
+
+	result->code = NULL;
+	result->code_size = 0;
+	result->symbols = NULL;
+	result->symbol_count = 0;
+
+	context = new_context();
+	previous = select_context( context );
+	if( !library_options( options )) {
+		delete_context( context );
+		(void)select_context( previous );
+		return( 1 );
+	}
+	req.name = name;
+	req.source = source;
+	req.len = len;
+	req.include = include;
+	req.data = data;
+	set_source_resolver( library_resolver, &req );
+	initialise_output( &memory_output_api, FALSE );
+	if(( ok = open_file( (char *)name ))) {
+		ok = assemble_file( (char *)name );
+		if( !close_file()) ok = FALSE;
+		result->code = memory_output_result( &( result->code_size ));
+	}
+	library_symbols( result );
+	delete_context( context );
+	(void)select_context( previous );
+	return( ok? 0: 1 );
+}
+
+/*
+ *	Release the memory held by a result.
+ */
+void i8086_release( i8086_result *result ) {
+	int	i;
+
+	ASSERT( result != NULL );
+
+	for( i = 0; i < result->symbol_count; i++ ) {
+		FREE( result->symbols[ i ].name );
+		if( result->symbols[ i ].segment ) FREE( result->symbols[ i ].segment );
+	}
+	if( result->symbols ) FREE( result->symbols );
+	if( result->code ) FREE( result->code );
+	result->code = NULL;
+	result->code_size = 0;
+	result->symbols = NULL;
+	result->symbol_count = 0;
+}
+
+
+/*
+ *	EOF
+ */
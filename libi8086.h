@@ -0,0 +1,104 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	libi8086
+ *	========
+ *
+ *	The public interface to the assembler when built as a
+ *	library rather than as a command.  Compile all of the source
+ *	files with LIBRARY defined (which removes the command line
+ *	'main' routine) and archive the objects as 'libi8086'.
+ *
+ *	This header is self contained; it does not require any of
+ *	the assembler's internal headers.
+ *
+ *	Each call to i8086_assemble() uses its own assembler context
+ *	so separate threads may assemble at the same time.
+ */
+ 
+#ifndef _LIBI8086_H_
+#define _LIBI8086_H_
+
+/*
+ *	Options controlling the assembly.  Exactly one of the CPU
+ *	selections must be included.
+ */
+#define I8086_CPU_8086			0x0001
+#define I8086_CPU_80186			0x0002
+#define I8086_CPU_80286			0x0004
+#define I8086_IGNORE_KEYWORD_CASE	0x0010
+#define I8086_IGNORE_LABEL_CASE		0x0020
+#define I8086_ACCESS_SEGMENTS		0x0040
+#define I8086_POSITION_DEPENDENT	0x0080
+
+/*
+ *	The routine called to find the text of a file named by an
+ *	INCLUDE directive.  It should set *text and *len and return
+ *	non-zero, or return zero if the file is not available.  The
+ *	text must remain valid until the assembly is complete.
+ */
+typedef int (*i8086_include)( const char *name, void *data, const char **text, int *len );
+
+/*
+ *	The kinds of symbol returned.
+ */
+typedef enum {
+	i8086_undefined = 0,
+	i8086_label,
+	i8086_constant,
+	i8086_group,
+	i8086_segment
+} i8086_kind;
+
+typedef struct {
+	char		*name;
+	i8086_kind	kind;
+	char		*segment;	/* Segment holding a label (or NULL) */
+	long		value;		/* Offset, constant value or segment start */
+} i8086_symbol;
+
+/*
+ *	The results of an assembly.
+ */
+typedef struct {
+	unsigned char	*code;		/* Machine code, as it would be in a '.COM' file */
+	int		code_size;
+	i8086_symbol	*symbols;
+	int		symbol_count;
+} i8086_result;
+
+/*
+ *	Assemble the source text supplied (called name for the
+ *	purposes of error messages), returning zero on success.  The
+ *	include routine (and data) may be NULL if the source does
+ *	not include other files.  Errors are reported on stderr.
+ *
+ *	Whether or not the assembly succeeds the result must be
+ *	passed to i8086_release() to free the memory it holds.
+ */
+extern int i8086_assemble( const char *name, const char *source, int len, unsigned int options, i8086_include include, void *data, i8086_result *result );
+extern void i8086_release( i8086_result *result );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */
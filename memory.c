@@ -0,0 +1,191 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	Memory
+ *	======
+ *
+ *	The instrumented allocator used (in place of malloc and
+ *	free) when MEMORY_ACCOUNTING is defined.
+ *
+ *	Each allocation carries a small header recording its
+ *	size and subsystem, so that the bytes live (and the peak
+ *	number of bytes live) can be followed for each subsystem
+ *	and for the program as a whole.  The figures are shared
+ *	by all threads, so they are updated atomically.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+#ifdef MEMORY_ACCOUNTING
+
+/*
+ *	The header placed before each allocation, padded to keep
+ *	the allocation itself suitably aligned.
+ */
+typedef union {
+	struct {
+		size_t		size;
+		memory_tag	tag;
+	} is;
+	max_align_t		align;
+} memory_header;
+
+/*
+ *	The figures kept for each subsystem, and overall.
+ */
+typedef struct {
+	atomic_long		allocs,
+				frees,
+				live,
+				peak;
+} memory_account;
+
+static memory_account accounts[ memory_tags ],
+			overall;
+
+static char *tag_name[ memory_tags ] = {
+	"general", "tokens", "identifiers", "store", "segments", "source", "output", "reports"
+};
+
+/*
+ *	The memory budget (if any).
+ */
+char *memory_budget = NIL( char );
+
+/*
+ *	Raise the peak figure of an account to the live figure
+ *	given, if it is higher.
+ */
+static void raise_peak( memory_account *account, long live ) {
+	long	peak;
+
+	peak = atomic_load( &( account->peak ));
+	while(( live > peak )&& !atomic_compare_exchange_weak( &( account->peak ), &peak, live ));
+}
+
+/*
+ *	Count an allocation in (or out, with a negative size).
+ */
+static void account_for( memory_tag tag, long size ) {
+	memory_account	*account;
+
+	ASSERT( tag < memory_tags );
+
+	account = &( accounts[ tag ]);
+	if( size >= 0 ) {
+		atomic_fetch_add( &( account->allocs ), 1 );
+		atomic_fetch_add( &( overall.allocs ), 1 );
+		raise_peak( account, atomic_fetch_add( &( account->live ), size ) + size );
+		raise_peak( &overall, atomic_fetch_add( &( overall.live ), size ) + size );
+	}
+	else {
+		atomic_fetch_add( &( account->frees ), 1 );
+		atomic_fetch_add( &( overall.frees ), 1 );
+		atomic_fetch_add( &( account->live ), size );
+		atomic_fetch_add( &( overall.live ), size );
+	}
+}
+
+/*
+ *	The allocation routines.
+ */
+void *account_alloc( memory_tag tag, size_t size ) {
+	memory_header	*header;
+
+	if(( header = (memory_header *)malloc( sizeof( memory_header ) + size )) == NIL( memory_header )) return( NIL( void ));
+	header->is.size = size;
+	header->is.tag = tag;
+	account_for( tag, (long)size );
+	return( header + 1 );
+}
+
+void *account_resize( memory_tag tag, void *ptr, size_t size ) {
+	memory_header	*header;
+	size_t		old;
+
+	if( ptr == NIL( void )) return( account_alloc( tag, size ));
+	header = (memory_header *)ptr - 1;
+	tag = header->is.tag;
+	old = header->is.size;
+	/*
+	 *	On failure the original block is left untouched, and
+	 *	still accounted for.
+	 */
+	if(( header = (memory_header *)realloc( header, sizeof( memory_header ) + size )) == NIL( memory_header )) return( NIL( void ));
+	account_for( tag, -(long)old );
+	header->is.size = size;
+	account_for( tag, (long)size );
+	return( header + 1 );
+}
+
+char *account_string( memory_tag tag, const char *string ) {
+	char	*copy;
+	size_t	len;
+
+	len = strlen( string ) + 1;
+	if(( copy = (char *)account_alloc( tag, len ))) memcpy( copy, string, len );
+	return( copy );
+}
+
+void account_free( void *ptr ) {
+	memory_header	*header;
+
+	if( ptr == NIL( void )) return;
+	header = (memory_header *)ptr - 1;
+	account_for( header->is.tag, -(long)( header->is.size ));
+	free( header );
+}
+
+/*
+ *	Write out the allocations.
+ */
+boolean memory_report( FILE *to ) {
+	memory_account	*a;
+	long		budget;
+	char		*end;
+	int		i;
+
+	fprintf( to, "Memory:-\n" );
+	fprintf( to, "    %-12s %10s %10s %12s %12s\n", "Subsystem", "Allocs", "Frees", "Live", "Peak" );
+	for( i = 0; i < memory_tags; i++ ) {
+		a = &( accounts[ i ]);
+		fprintf( to, "    %-12s %10ld %10ld %12ld %12ld\n", tag_name[ i ], atomic_load( &( a->allocs )), atomic_load( &( a->frees )), atomic_load( &( a->live )), atomic_load( &( a->peak )));
+	}
+	fprintf( to, "    %-12s %10ld %10ld %12ld %12ld\n", "total", atomic_load( &( overall.allocs )), atomic_load( &( overall.frees )), atomic_load( &( overall.live )), atomic_load( &( overall.peak )));
+	if( memory_budget == NIL( char )) return( TRUE );
+	/*
+	 *	The budget is in bytes, or in KBytes with a 'K'.
+	 */
+	budget = strtol( memory_budget, &end, 10 );
+	if(( *end == 'k' )||( *end == 'K' )) budget *= 1024;
+	fprintf( to, "    Budget %ld bytes, peak %ld bytes.\n", budget, atomic_load( &( overall.peak )));
+	fflush( to );
+	if( atomic_load( &( overall.peak )) > budget ) {
+		log_error_i( "Memory budget exceeded by", atomic_load( &( overall.peak )) - budget );
+		return( FALSE );
+	}
+	return( TRUE );
+}
+
+#endif
+
+/*
+ *	EOF
+ */
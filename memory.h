@@ -27,14 +27,70 @@
 #ifndef _MEMORY_H_
 #define _MEMORY_H_
 
+/*
+ *	The subsystems allocations are accounted against (when
+ *	MEMORY_ACCOUNTING is defined).  A source file selects its
+ *	subsystem by defining MEMORY_TAG before its includes.
+ */
+typedef enum {
+	memory_general = 0,			/* Anything not listed below */
+	memory_tokens,				/* Token lists and arenas */
+	memory_identifiers,			/* Label records and names */
+	memory_store,				/* Saved data blocks */
+	memory_segments,			/* Segment and group records */
+	memory_source,				/* Source names and text */
+	memory_output,				/* Output, listing and cache data */
+	memory_reports,				/* Statistics and convergence */
+	memory_tags
+} memory_tag;
+
+#ifdef MEMORY_ACCOUNTING
+
+#ifndef MEMORY_TAG
+#define MEMORY_TAG		memory_general
+#endif
+
+/*
+ *	Allocations are counted by subsystem, see memory.c.
+ */
+extern void *account_alloc( memory_tag tag, size_t size );
+extern void *account_resize( memory_tag tag, void *ptr, size_t size );
+extern char *account_string( memory_tag tag, const char *string );
+extern void account_free( void *ptr );
+
+#define NEW(t)			((t *)account_alloc(MEMORY_TAG,sizeof(t)))
+#define NEW_ARRAY(t,n)		((t *)account_alloc(MEMORY_TAG,sizeof(t)*(n)))
+#define RESIZE_ARRAY(p,t,n)	((t *)account_resize(MEMORY_TAG,(p),sizeof(t)*(n)))
+#define NEW_STRING(s)		account_string(MEMORY_TAG,(s))
+
+#define FREE(p)			account_free(p)
+
+/*
+ *	The greatest number of bytes which may be in use at any
+ *	one time (given as text by the command line).
+ */
+extern char *memory_budget;
+
+/*
+ *	Write out the allocations by subsystem, returning FALSE
+ *	if the peak use exceeded the memory budget.
+ */
+extern boolean memory_report( FILE *to );
+
+#else
+
 /*
  *	Wrap up the memory allocation
  */
 #define NEW(t)			((t *)malloc(sizeof(t)))
 #define NEW_ARRAY(t,n)		((t *)malloc(sizeof(t)*(n)))
+#define RESIZE_ARRAY(p,t,n)	((t *)realloc((p),sizeof(t)*(n)))
+#define NEW_STRING(s)		strdup(s)
 
 #define FREE(p)			free(p)
 
+#endif
+
 #define STACK(t)		((t *)alloca(sizeof(t)))
 #define STACK_ARRAY(t,n)	((t *)alloca(sizeof(t)*(n)))
 
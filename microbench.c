@@ -0,0 +1,497 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	microbench
+ *	==========
+ *
+ *	Routines associated with the extended verification mode to
+ *	time the assembler's core lookup and encoding routines in
+ *	isolation.
+ *
+ *	The input for each routine is gathered from a synthetic
+ *	source file (see benchmark.c) which is first assembled in
+ *	the usual way, so the labels, segments and saved blocks
+ *	it defines are all in place.  The instructions are those
+ *	seen by process_opcode() in the code generation pass.
+ *
+ *	Each routine is run across all of its input once per
+ *	repetition, and the time per call of each repetition is
+ *	reported as a set of percentiles:
+ *
+ *		routine calls min-ns p50-ns p90-ns p99-ns
+ *
+ *	followed (when a baseline is given) by the baseline median,
+ *	the percentage change and whether the routine regressed.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+#ifdef VERIFICATION
+
+/*
+ *	The most inputs gathered for any one routine.
+ */
+#define MICRO_SAMPLES		8192
+
+/*
+ *	The (approximate) number of words on a source line.
+ */
+#define MICRO_WORDS		4
+
+/*
+ *	An instruction as identified by process_opcode().
+ */
+typedef struct {
+	opcode		*inst;
+	opcode_prefix	prefs;
+	modifier	mods;
+	component	op;
+	int		args;
+	ea_breakdown	format[ MAX_OPCODE_ARGS+1 ];
+} opcode_sample;
+
+/*
+ *	The input gathered for all of the routines.
+ */
+typedef struct {
+	char		*line[ MICRO_SAMPLES ],		/* Source lines, padded to MAX_LINE_SIZE */
+			*word[ MICRO_SAMPLES ],		/* Identifiers within those lines */
+			*label[ MICRO_SAMPLES ];	/* Label names */
+	component	keyword[ MICRO_SAMPLES ];
+	token_record	*expr[ MICRO_SAMPLES ];
+	int		expr_len[ MICRO_SAMPLES ];
+	opcode_sample	inst[ MICRO_SAMPLES ];
+	byte		*block[ MICRO_SAMPLES ];
+	int		block_len[ MICRO_SAMPLES ];
+	int		lines,
+			words,
+			labels,
+			keywords,
+			exprs,
+			insts,
+			blocks;
+} micro_input;
+
+/*
+ *	A routine being timed; returns the number of calls made.
+ */
+typedef int FUNC( micro_routine )( micro_input *in );
+
+/*
+ *	Somewhere for results to go so that the calls are not
+ *	optimised away.
+ */
+static volatile long micro_sink;
+
+/*
+ *	The input being gathered by the opcode observer.
+ */
+static micro_input *gathering;
+
+/*
+ *	Capture instructions from the code generation pass.
+ */
+static void capture_opcode( opcode *inst, opcode_prefix prefs, modifier mods, component op, int args, ea_breakdown *format ) {
+	opcode_sample	*s;
+
+	if(( this_pass != pass_code_generation )||( gathering->insts == MICRO_SAMPLES )||( args > MAX_OPCODE_ARGS )) return;
+	s = &( gathering->inst[ gathering->insts++ ]);
+	s->inst = inst;
+	s->prefs = prefs;
+	s->mods = mods;
+	s->op = op;
+	s->args = args;
+	memcpy( s->format, format, sizeof( ea_breakdown ) * ( args+1 ));
+}
+
+/*
+ *	Add an expression, tokenised as the argument of a DW so
+ *	that any labels in it are references.
+ */
+static void add_expression( micro_input *in, char *text ) {
+	char		line[ MAX_LINE_SIZE ];
+	token_record	*tokens,
+			*look;
+	int		len;
+
+	if( in->exprs == MICRO_SAMPLES ) return;
+	snprintf( line, MAX_LINE_SIZE, "\tdw\t%s", text );
+	if( !tokenise_line( line, &tokens, NIL( token_arena ))) {
+		delete_tokens( tokens );
+		return;
+	}
+	/*
+	 *	Only labels and constants (not segments or
+	 *	groups) are valid in an expression.
+	 */
+	len = 0;
+	for( look = tokens->next; look->id != end_of_line; look = look->next ) {
+		if(( look->id == tok_label )&&( look->var.label->type != class_const )&&( look->var.label->type != class_label )) {
+			delete_tokens( tokens );
+			return;
+		}
+		len++;
+	}
+	in->expr[ in->exprs ] = tokens;
+	in->expr_len[ in->exprs++ ] = len;
+}
+
+/*
+ *	Gather the words, labels, keywords, expressions and data
+ *	blocks from a line of source.
+ */
+static void gather_line( micro_input *in, char *text ) {
+	char	*line,
+		*ptr,
+		*arg;
+	int	l, t;
+
+	if(( *text == ';' )||( in->lines == MICRO_SAMPLES )) return;
+	/*
+	 *	Lines are padded as the keyword search may look
+	 *	beyond the end of the text.
+	 */
+	line = NEW_ARRAY( char, MAX_LINE_SIZE+1 );
+	memset( line, EOS, MAX_LINE_SIZE+1 );
+	strncpy( line, text, MAX_LINE_SIZE );
+	in->line[ in->lines++ ] = line;
+	for( ptr = line; *ptr != EOS; ptr += l ) {
+		if(( l = match_identifier( ptr )) == 0 ) {
+			l = 1;
+			continue;
+		}
+		if( in->words < MICRO_SAMPLES ) in->word[ in->words++ ] = ptr;
+		if(( t = find_best_keyword( ptr, &( in->keyword[ in->keywords ]))) == l ) {
+			if( in->keywords < MICRO_SAMPLES - 1 ) in->keywords++;
+		}
+		else if(( *ptr != PERIOD )&&( in->labels < MICRO_SAMPLES )) {
+			in->label[ in->labels ] = NEW_ARRAY( char, l+1 );
+			memcpy( in->label[ in->labels ], ptr, l );
+			in->label[ in->labels++ ][ l ] = EOS;
+		}
+	}
+	/*
+	 *	The operands after the last tab (other than the
+	 *	registers) are expressions, DB values are blocks.
+	 */
+	if(( arg = strrchr( line, '\t' )) == NIL( char )) return;
+	arg++;
+	if( strstr( line, "\tdb\t" )) {
+		byte	*data;
+		char	*copy,
+			*item,
+			*save;
+		int	n;
+
+		if( in->blocks == MICRO_SAMPLES ) return;
+		data = NEW_ARRAY( byte, MAX_LINE_SIZE );
+		copy = NEW_STRING( arg );
+		n = 0;
+		for( item = strtok_r( copy, ",", &save ); item; item = strtok_r( NIL( char ), ",", &save )) {
+			add_expression( in, item );
+			data[ n++ ] = (byte)atoi( item );
+		}
+		FREE( copy );
+		in->block[ in->blocks ] = data;
+		in->block_len[ in->blocks++ ] = n;
+		return;
+	}
+	if(( ptr = strrchr( arg, ',' ))) arg = ptr+1;
+	if((( l = match_identifier( arg )) > 0 )&&( find_best_keyword( arg, &( in->keyword[ in->keywords ])) == l )) return;
+	if( *arg != PERIOD ) add_expression( in, arg );
+}
+
+/*
+ *	The routines timed.
+ */
+static int time_find_best_keyword( micro_input *in ) {
+	component	c;
+	int		i;
+
+	for( i = 0; i < in->words; i++ ) micro_sink += find_best_keyword( in->word[ i ], &c );
+	return( in->words );
+}
+
+static int time_find_label( micro_input *in ) {
+	int	i;
+
+	for( i = 0; i < in->labels; i++ ) micro_sink += ( find_label( in->label[ i ], FALSE ) != NIL( id_record ));
+	return( in->labels );
+}
+
+static int time_find_opcode( micro_input *in ) {
+	opcode_sample	*s;
+	int		i;
+
+	for( i = 0; i < in->insts; i++ ) {
+		s = &( in->inst[ i ]);
+		micro_sink += ( find_opcode( s->mods, s->op, s->args, s->format ) != NIL( opcode ));
+	}
+	return( in->insts );
+}
+
+static int time_register_component( micro_input *in ) {
+	int	i;
+
+	for( i = 0; i < in->keywords; i++ ) micro_sink += ( register_component( in->keyword[ i ]) != NIL( register_data ));
+	return( in->keywords );
+}
+
+static int time_evaluate( micro_input *in ) {
+	constant_value	v;
+	int		i, used;
+
+	for( i = 0; i < in->exprs; i++ ) {
+		if( evaluate( in->expr[ i ]->next, in->expr_len[ i ], &used, &v, FALSE )) micro_sink += v.value;
+	}
+	return( in->exprs );
+}
+
+static int time_assemble_inst( micro_input *in ) {
+	opcode_sample	*s;
+	instruction	mc;
+	int		i;
+
+	for( i = 0; i < in->insts; i++ ) {
+		s = &( in->inst[ i ]);
+		if( assemble_inst( s->inst, s->prefs, s->format, &mc )) micro_sink += mc.coded;
+	}
+	return( in->insts );
+}
+
+static int time_save_block( micro_input *in ) {
+	int	i;
+
+	for( i = 0; i < in->blocks; i++ ) micro_sink += ( save_block( in->block[ i ], in->block_len[ i ]) != NIL( byte ));
+	return( in->blocks );
+}
+
+static struct {
+	char		*name;
+	micro_routine	routine;
+} micro_routines[] = {
+	{ "find_best_keyword",	time_find_best_keyword	},
+	{ "find_label",		time_find_label		},
+	{ "find_opcode",	time_find_opcode	},
+	{ "register_component",	time_register_component	},
+	{ "evaluate",		time_evaluate		},
+	{ "assemble_inst",	time_assemble_inst	},
+	{ "save_block",		time_save_block		},
+	{ NIL( char ) }
+};
+
+/*
+ *	Return the time, in nanoseconds, now.
+ */
+static double micro_clock( void ) {
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return((double)now.tv_sec * 1e9 + (double)now.tv_nsec );
+}
+
+static int compare_times( const void *a, const void *b ) {
+	double	x = *(const double *)a,
+		y = *(const double *)b;
+
+	return(( x < y )? -1: (( x > y )? 1: 0 ));
+}
+
+/*
+ *	Return the q'th quantile of the (sorted) times.
+ */
+static double percentile( double *time, int count, double q ) {
+	return( time[ (int)( q * ( count-1 ) + 0.5 )]);
+}
+
+/*
+ *	Find the median for a routine in a baseline file, or
+ *	return a negative value if there is none.
+ */
+static double baseline_median( char *baseline, char *name ) {
+	FILE	*from;
+	char	line[ MAX_LINE_SIZE ],
+		routine[ MAX_LINE_SIZE ];
+	double	median;
+	long	calls;
+	double	best;
+
+	median = -1.0;
+	if(( from = fopen( baseline, "r" )) == NIL( FILE )) return( median );
+	while( fgets( line, MAX_LINE_SIZE, from )) {
+		if( *line == '#' ) continue;
+		if(( sscanf( line, "%s %ld %lf %lf", routine, &calls, &best, &median ) == 4 )&&( strcmp( routine, name ) == 0 )) break;
+		median = -1.0;
+	}
+	fclose( from );
+	return( median );
+}
+
+/*
+ *	Gather the input by assembling the scenario source.
+ */
+static boolean gather_input( micro_input *in, char *directory, bench_scenario *scenario ) {
+	char	*name,
+		line[ MAX_LINE_SIZE ],
+		here[ PATH_MAX ];
+	FILE	*from;
+	boolean	ok;
+	int	len, lines, stride, n;
+
+	name = STACK_ARRAY( char, strlen( scenario->name ) + 8 );
+	sprintf( name, "%s.asm", scenario->name );
+	if(( getcwd( here, PATH_MAX ) == NIL( char ))||( chdir( directory ) != 0 )) {
+		log_error_s( "Unable to change directory", directory );
+		return( FALSE );
+	}
+	ok = FALSE;
+	if(( lines = generate_source( name, scenario )) != ERROR ) {
+		command_flags = intel_8086;
+		assembler_parameters = flag_086;
+		initialise_output( &memory_output_api, FALSE );
+		gathering = in;
+		observe_opcodes( capture_opcode );
+		if(( ok = open_file( name ))) {
+			ok = assemble_file( name );
+			if( !close_file()) ok = FALSE;
+			FREE( memory_output_result( &len ));
+		}
+		observe_opcodes( NIL( void ));
+		/*
+		 *	Lines are picked evenly from across the whole
+		 *	source, each line giving a few words.
+		 */
+		stride = 1 + lines / ( MICRO_SAMPLES / MICRO_WORDS );
+		if(( from = fopen( name, "r" ))) {
+			for( n = 0; fgets( line, MAX_LINE_SIZE, from ); n++ ) {
+				line[ strcspn( line, "\n" )] = EOS;
+				if(( n % stride ) == 0 ) gather_line( in, line );
+			}
+			fclose( from );
+		}
+	}
+	if( chdir( here ) != 0 ) ok = FALSE;
+	return( ok );
+}
+
+/*
+ *	Release the input gathered.
+ */
+static void release_input( micro_input *in ) {
+	int	i;
+
+	for( i = 0; i < in->lines; i++ ) FREE( in->line[ i ]);
+	for( i = 0; i < in->labels; i++ ) FREE( in->label[ i ]);
+	for( i = 0; i < in->exprs; i++ ) delete_tokens( in->expr[ i ]);
+	for( i = 0; i < in->blocks; i++ ) FREE( in->block[ i ]);
+	FREE( in );
+}
+
+/*
+ *	Run the micro-benchmarks.
+ */
+boolean run_micro_benchmarks( char *scenario, int warm_up, int repeat, char *baseline, int threshold ) {
+	char			directory[] = "/tmp/i8086-micro-XXXXXX",
+				*file;
+	bench_scenario		source;
+	assembler_context	*context,
+				*previous;
+	micro_input		*in;
+	double			*time,
+				start,
+				median,
+				before;
+	boolean			ok;
+	int			i, r, calls, d;
+
+	if( repeat < 1 ) repeat = 1;
+	if( !find_scenario(( scenario != NIL( char ))? scenario: "medium", &source )) return( FALSE );
+	if( mkdtemp( directory ) == NIL( char )) {
+		log_error( "Unable to create benchmark directory" );
+		return( FALSE );
+	}
+	context = new_context();
+	previous = select_context( context );
+	in = NEW( micro_input );
+	memset( in, 0, sizeof( micro_input ));
+	ok = gather_input( in, directory, &source );
+	/*
+	 *	Tidy up the files.
+	 */
+	file = STACK_ARRAY( char, strlen( directory ) + strlen( source.name ) + MAX_CONST_SIZE );
+	sprintf( file, "%s/%s.asm", directory, source.name );
+	(void)unlink( file );
+	for( d = 1; d <= source.depth; d++ ) {
+		sprintf( file, "%s/%s_%d.inc", directory, source.name, d );
+		(void)unlink( file );
+	}
+	(void)rmdir( directory );
+	if( !ok ) {
+		log_error_s( "Unable to assemble benchmark scenario", source.name );
+		release_input( in );
+		delete_context( context );
+		(void)select_context( previous );
+		return( FALSE );
+	}
+	/*
+	 *	Instructions are encoded as they would be when
+	 *	verifying the opcode table, without reference to
+	 *	any segment.
+	 */
+	this_pass = data_verification;
+	time = NEW_ARRAY( double, repeat );
+	printf( "# i8086 " PROGRAM_VERSION_NUMBER " micro-benchmark, scenario %s, warm-up %d, repeat %d\n", source.name, warm_up, repeat );
+	printf( "# routine\tcalls\tmin_ns\tp50_ns\tp90_ns\tp99_ns%s\n", baseline? "\tbaseline_ns\tchange\tresult": "" );
+	for( i = 0; micro_routines[ i ].name != NIL( char ); i++ ) {
+		calls = 0;
+		for( r = 0; r < warm_up; r++ ) (void)( *micro_routines[ i ].routine )( in );
+		for( r = 0; r < repeat; r++ ) {
+			start = micro_clock();
+			calls = ( *micro_routines[ i ].routine )( in );
+			time[ r ] = ( micro_clock() - start ) / (( calls > 0 )? calls: 1 );
+		}
+		qsort( time, repeat, sizeof( double ), compare_times );
+		median = percentile( time, repeat, 0.5 );
+		printf( "%s\t%d\t%.1f\t%.1f\t%.1f\t%.1f", micro_routines[ i ].name, calls, time[ 0 ], median, percentile( time, repeat, 0.9 ), percentile( time, repeat, 0.99 ));
+		if( baseline ) {
+			if(( before = baseline_median( baseline, micro_routines[ i ].name )) <= 0.0 ) {
+				printf( "\t-\t-\tnew" );
+			}
+			else {
+				double	change = ( median - before ) * 100.0 / before;
+
+				printf( "\t%.1f\t%+.1f%%\t%s", before, change, ( change > threshold )? "regressed": "ok" );
+				if( change > threshold ) ok = FALSE;
+			}
+		}
+		printf( "\n" );
+	}
+	FREE( time );
+	release_input( in );
+	delete_context( context );
+	(void)select_context( previous );
+	return( ok );
+}
+
+#endif
+
+/*
+ *	EOF
+ */
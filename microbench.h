@@ -0,0 +1,52 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	microbench
+ *	==========
+ *
+ *	Routines associated with the extended verification mode to
+ *	time the assembler's core lookup and encoding routines in
+ *	isolation.
+ */
+ 
+#ifndef _MICROBENCH_H_
+#define _MICROBENCH_H_
+
+#ifdef VERIFICATION
+
+/*
+ *	Time each of the core routines against input gathered from
+ *	the source of the scenario given (see benchmark.h), after
+ *	the number of warm-up runs given, writing the percentiles
+ *	of the repeated runs to stdout.
+ *
+ *	If a baseline file (the output of an earlier run) is given
+ *	then the median time of each routine is compared with it
+ *	and FALSE is returned if any is slower by more than the
+ *	threshold percentage.
+ */
+extern boolean run_micro_benchmarks( char *scenario, int warm_up, int repeat, char *baseline, int threshold );
+
+#endif
+
+#endif
+
+/*
+ *	EOF
+ */
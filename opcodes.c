@@ -196,7 +196,7 @@ opcode_prefix map_segment_prefix( byte segment_reg ) {
 #if defined( VERIFICATION )||defined( DEBUG )
 
 	/*
-	 *	Debugging code to output an AC or EA bit map in text to stdout.
+	 *	Debugging code to output an AC or EA bit map in text.
 	 */
 	typedef struct {
 		arg_component	ac;
@@ -216,18 +216,18 @@ opcode_prefix map_segment_prefix( byte segment_reg ) {
 		{ ac_empty }
 	};
 	
-	void show_ac_bitmap( arg_component ac ) {
+	void show_ac_bitmap( FILE *to, arg_component ac ) {
 		ac_translation *look;
 		char		lead;
 
 		lead = SPACE;
 		for( look = trans_ac; look->ac; look++ ) {
 			if( BOOL( ac & look->ac )) {
-				printf( "%c%s", lead, look->name );
+				fprintf( to, "%c%s", lead, look->name );
 				lead = '|';
 			}
 		}
-		if( lead == SPACE ) printf( " empty" );
+		if( lead == SPACE ) fprintf( to, " empty" );
 	}
 
 	typedef struct {
@@ -256,18 +256,18 @@ opcode_prefix map_segment_prefix( byte segment_reg ) {
 		{ ea_empty }
 	};
 	
-	void show_ea_bitmap( effective_address ea ) {
+	void show_ea_bitmap( FILE *to, effective_address ea ) {
 		ea_translation *look;
 		char		lead;
 
 		lead = SPACE;
 		for( look = trans_ea; look->ea; look++ ) {
 			if( BOOL( ea & look->ea )) {
-				printf( "%c%s", lead, look->name );
+				fprintf( to, "%c%s", lead, look->name );
 				lead = '|';
 			}
 		}
-		if( lead == SPACE ) printf( " empty" );
+		if( lead == SPACE ) fprintf( to, " empty" );
 	}
 
 #endif
@@ -329,20 +329,33 @@ register_data *register_component( component comp ) {
  *	In these CPUs there is often more than a single way of
  *	getting the same result.
  *
+ *	The exception are the sign extended immediate forms, which
+ *	can only be chosen once the value is known.  These follow
+ *	the full width forms, and are only considered when the
+ *	"--optimize-size" option asks for every matching entry to
+ *	be tried and the shortest encoding kept.
+ *
  *	Some machine code instructions have multiple names.
  *
+ *	Each entry closes with the clocks the form takes on each
+ *	CPU (see CLK() in opcodes.h) used for the cycle estimates
+ *	in the listing.  Where the data sheets give a range the
+ *	upper figure is used, and for multiply and divide the byte
+ *	form is recorded (the cost model adding the word penalty).
+ *
  *		Here be dragons (be warned)
  *
  *	If VERIFICATION is defined then this table is accessed
  *	by the "dump" module to facilitate confirmation of the
- *	tables content.
+ *	tables content, and the "disassemble" module (also built
+ *	for EXECUTION) derives its decoder from it.
  *
  *	So, if not defined, then the data is static and is only
  *	accessed by the "find_opcode()" routine.  This, however,
  *	does return a pointer into the table, so the content is
  *	not a secret to the rest of the program.
  */
-#ifndef VERIFICATION
+#if !defined( VERIFICATION )&& !defined( EXECUTION )
 static
 #endif
 
@@ -353,7 +366,7 @@ opcode opcodes[] = {
  *	ASCII Adjust for Addition
  *	0011 0111
  */
-	{ op_aaa,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x37) }},
+	{ op_aaa,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x37) },	CLK(4,0,8,0,3,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 69
@@ -361,7 +374,7 @@ opcode opcodes[] = {
  *	ASCII Adjust for Division
  *	1101 0101, 0000 1010
  */
-	{ op_aad,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			2,	{ SB(0xD5),SB(0x0A) }},
+	{ op_aad,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			2,	{ SB(0xD5),SB(0x0A) },	CLK(60,0,15,0,14,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 70
@@ -369,7 +382,7 @@ opcode opcodes[] = {
  *	ASCII Adjust for Multiply
  *	1101 0100, 0000 1010
  */
-	{ op_aam,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			2,	{ SB(0xD4),SB(0x0A) }},
+	{ op_aam,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			2,	{ SB(0xD4),SB(0x0A) },	CLK(83,0,19,0,16,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 71
@@ -377,7 +390,7 @@ opcode opcodes[] = {
  *	ASCII Adjust for Subtraction
  *	0011 1111
  */
-	{ op_aas,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x3F) }},
+	{ op_aas,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x3F) },	CLK(4,0,7,0,3,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 72
@@ -387,14 +400,16 @@ opcode opcodes[] = {
  * 
  *	Add with Carry immediate Operand to Memory or Register Operand
  * B	1000 00sw, mod 010 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	Add with Carry immediate Operand to Accumulator
  * C	0001 010w, data, data if w =1
  */
-/*C*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x14),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B010,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x10),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x10),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x14),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B010,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x10),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x10),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_adc,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B010,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 73
@@ -404,14 +419,16 @@ opcode opcodes[] = {
  * 
  *	Add immediate Operand to Memory or Register Operand
  * B	1000 00sw, mod 000 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	Add immediate Operand to Accumulator
  * C	0000 010w, data, data if w =1
  */
-/*C*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x04),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x00),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x00),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x04),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x00),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x00),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_add,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B000,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 74,75
@@ -421,14 +438,16 @@ opcode opcodes[] = {
  * 
  *	And immediate Operand to Memory or Register Operand
  * B	1000 00sw, mod 100 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	And immediate Operand to Accumulator
  * C	0010 010w, data, data if w =1
  */
-/*C*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x24),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B100,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x20),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x20),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x24),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B100,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x20),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x20),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_and,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B100,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-53,54
@@ -436,7 +455,7 @@ opcode opcodes[] = {
  *	Bound
  *	0110 0010, mod req r/m
  */
-	{ op_bound,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	4,	{ SB(0x20),SDR(DIRECT_TO_REG,0,1),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) }},
+	{ op_bound,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	4,	{ SB(0x20),SDR(DIRECT_TO_REG,0,1),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) },	CLK(0,0,0,35,0,13,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 76,77
@@ -453,14 +472,14 @@ opcode opcodes[] = {
  * 	Call far (inter segment) indirect
  * D	1111 1111, mod 011 r/m
  */
-/*A*/	{ op_call,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_immediate, ea_empty },		4,	{ SB(0xE8),FDS(DATA_SIZE_NEAR,SIGN_UNSIGNED),VDS(0),REL(0,RANGE_WORD,0,0) }},
-/*B*/	{ op_call,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0xFF),FDS(DATA_SIZE_NEAR,SIGN_UNSIGNED),VDS(0),EAO(B010,0) }},
-/*C*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_far_immediate, ea_empty },		4,	{ SB(0x9A),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),IMM(0) }},
-/*C*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	far_modifier,	1,	{ ea_immediate, ea_empty },		4,	{ SB(0x9A),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),IMM(0) }},
-/*D*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_far_mod_reg_adrs, ea_empty },	4,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),EAO(B011,0) }},
-/*D*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	far_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),EAO(B011,0) }},
-/*C*/	{ op_lcall,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_immediate, ea_empty },		4,	{ SB(0x9A),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),IMM(0) }},
-/*D*/	{ op_lcall,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),EAO(B011,0) }},
+/*A*/	{ op_call,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_immediate, ea_empty },		4,	{ SB(0xE8),FDS(DATA_SIZE_NEAR,SIGN_UNSIGNED),VDS(0),REL(0,RANGE_WORD,0,0) },	CLK(19,0,15,0,7,0,1,0) },
+/*B*/	{ op_call,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0xFF),FDS(DATA_SIZE_NEAR,SIGN_UNSIGNED),VDS(0),EAO(B010,0) },	CLK(16,21,13,19,7,11,1,1) },
+/*C*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_far_immediate, ea_empty },		4,	{ SB(0x9A),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),IMM(0) },	CLK(28,0,23,0,13,0,2,0) },
+/*C*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	far_modifier,	1,	{ ea_immediate, ea_empty },		4,	{ SB(0x9A),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),IMM(0) },	CLK(28,0,23,0,13,0,2,0) },
+/*D*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_far_mod_reg_adrs, ea_empty },	4,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),EAO(B011,0) },	CLK(0,37,0,38,0,16,2,2) },
+/*D*/	{ op_call,	flag_086|flag_abs,lock_n_segments,	far_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),EAO(B011,0) },	CLK(0,37,0,38,0,16,2,2) },
+/*C*/	{ op_lcall,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_immediate, ea_empty },		4,	{ SB(0x9A),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),IMM(0) },	CLK(28,0,23,0,13,0,2,0) },
+/*D*/	{ op_lcall,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),VDS(0),EAO(B011,0) },	CLK(0,37,0,38,0,16,2,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 78
@@ -468,7 +487,7 @@ opcode opcodes[] = {
  *	Convert byte to word
  *	1001 1000
  */
-	{ op_cbw,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x98) }},
+	{ op_cbw,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x98) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 79
@@ -476,7 +495,7 @@ opcode opcodes[] = {
  *	Clear carry flag
  *	1111 1000
  */
-	{ op_clc,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xF8) }},
+	{ op_clc,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xF8) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 80
@@ -484,7 +503,7 @@ opcode opcodes[] = {
  *	Clear Direction flag
  *	1111 1100
  */
-	{ op_cld,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFC) }},
+	{ op_cld,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFC) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 81
@@ -492,7 +511,7 @@ opcode opcodes[] = {
  *	Clear Interrupt enable flag
  *	1111 1010
  */
-	{ op_cli,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFA) }},
+	{ op_cli,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFA) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 82
@@ -500,7 +519,7 @@ opcode opcodes[] = {
  *	Complement carry flag
  *	1111 0101
  */
-	{ op_cmc,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xF5) }},
+	{ op_cmc,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xF5) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 83
@@ -510,14 +529,16 @@ opcode opcodes[] = {
  * 
  *	Compare immediate Operand with Memory or Register Operand
  * B	1000 00sw, mod 111 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	Compare immediate Operand with Accumulator
  * C	0011 110w, data, data if w =1
  */
-/*C*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x3C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B111,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x38),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x38),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x3C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B111,0),IMM(1),SDS(0,0) },	CLK(4,10,4,10,3,6,0,1) },
+/*A*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x38),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,6,0,1) },
+/*A*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x38),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,9,3,10,2,7,0,1) },
+/*B*/	{ op_cmp,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B111,0),SXI(1) },	CLK(4,10,4,10,3,6,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 84
@@ -525,9 +546,9 @@ opcode opcodes[] = {
  *	Compare string (Byte or word)
  *	1010 011w
  */
-	{ op_cmps,	flag_086,	rep_test_prefix,	no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xA6),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_cmps,	flag_086,	rep_test_prefix,	byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xA6),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_cmps,	flag_086,	rep_test_prefix,	word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xA6),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) }},
+	{ op_cmps,	flag_086,	rep_test_prefix,	no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xA6),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(22,22,22,22,8,9,0,2) },
+	{ op_cmps,	flag_086,	rep_test_prefix,	byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xA6),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(22,22,22,22,8,9,0,2) },
+	{ op_cmps,	flag_086,	rep_test_prefix,	word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xA6),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) },	CLK(22,22,22,22,8,9,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 85
@@ -535,7 +556,7 @@ opcode opcodes[] = {
  *	Convert word to double word
  *	1001 1001
  */
-	{ op_cwd,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x99) }},
+	{ op_cwd,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x99) },	CLK(5,0,4,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 86
@@ -543,7 +564,7 @@ opcode opcodes[] = {
  *	Decimal adjust for addition
  *	0010 0111
  */
-	{ op_daa,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x27) }},
+	{ op_daa,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x27) },	CLK(4,0,4,0,3,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 87
@@ -551,7 +572,7 @@ opcode opcodes[] = {
  *	Decimal adjust for subtraction
  *	0010 1111
  */
-	{ op_das,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x2F) }},
+	{ op_das,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x2F) },	CLK(4,0,4,0,3,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 88
@@ -562,8 +583,8 @@ opcode opcodes[] = {
  *	Decrement Register (word)
  * B	0100 1reg
  */
-/*B*/	{ op_dec,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x48),REG(0,0,0) }},
-/*A*/	{ op_dec,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xFE),IDS(0,SIGN_IGNORED),EAO(B001,0),SDS(0,0) }},
+/*B*/	{ op_dec,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x48),REG(0,0,0) },	CLK(2,0,3,0,2,0,0,0) },
+/*A*/	{ op_dec,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xFE),IDS(0,SIGN_IGNORED),EAO(B001,0),SDS(0,0) },	CLK(3,15,3,15,2,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 89,90
@@ -571,7 +592,7 @@ opcode opcodes[] = {
  *	Divide 
  *	1111 011w, mod 110 r/m, 2 to 4 data bytes
  */
-	{ op_div,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B110,0),SDS(0,0) }},
+	{ op_div,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B110,0),SDS(0,0) },	CLK(90,96,29,35,14,17,0,1) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-71,72
@@ -579,7 +600,7 @@ opcode opcodes[] = {
  *	Enter
  *	1100 1000, data-low, data-high
  */
-	{ op_enter,	flag_186,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xC8),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) }},
+	{ op_enter,	flag_186,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xC8),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) },	CLK(0,0,15,0,11,0,1,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 91
@@ -587,7 +608,7 @@ opcode opcodes[] = {
  *	Escape 
  *	1101 1xxx, mod xxx r/m
  */
-	{ op_esc,	flag_086,	segment_prefixes,	no_modifier,	2,	{ ea_immediate, ea_mem_mod_adrs },	4,	{ SB(0xD8),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),EAO(B000,1),ESC(0) }},
+	{ op_esc,	flag_086,	segment_prefixes,	no_modifier,	2,	{ ea_immediate, ea_mem_mod_adrs },	4,	{ SB(0xD8),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),EAO(B000,1),ESC(0) },	CLK(0,8,0,6,0,9,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 92
@@ -595,7 +616,7 @@ opcode opcodes[] = {
  *	Halt 
  *	1111 0100
  */
-	{ op_hlt,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xF4) }},
+	{ op_hlt,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xF4) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 93,94
@@ -603,7 +624,7 @@ opcode opcodes[] = {
  *	Interger divide 
  *	1111 011w, mod 111 r/m
  */
-	{ op_idiv,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B111,0),SDS(0,0) }},
+	{ op_idiv,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B111,0),SDS(0,0) },	CLK(112,118,52,58,17,20,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 95
@@ -611,7 +632,7 @@ opcode opcodes[] = {
  *	Interger multiply 
  *	1111 011w, mod 101 r/m
  */
-	{ op_imul,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B101,0),SDS(0,0) }},
+	{ op_imul,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B101,0),SDS(0,0) },	CLK(98,104,28,34,13,16,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 96
@@ -622,8 +643,8 @@ opcode opcodes[] = {
  *	Input byte or word (indirect port, DX)
  * B	1110 110w
  */
-/*B*/	{ op_in,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_accumulators, ea_empty },		3,	{ SB(0xEC),IDS(0,SIGN_IGNORED),SDS(0,0) }},
-/*A*/	{ op_in,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_accumulators, ea_immediate },	5,	{ SB(0xE4),IDS(0,SIGN_IGNORED),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*B*/	{ op_in,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_accumulators, ea_empty },		3,	{ SB(0xEC),IDS(0,SIGN_IGNORED),SDS(0,0) },	CLK(8,0,8,0,5,0,0,1) },
+/*A*/	{ op_in,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_accumulators, ea_immediate },	5,	{ SB(0xE4),IDS(0,SIGN_IGNORED),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(10,0,10,0,5,0,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 97
@@ -634,8 +655,8 @@ opcode opcodes[] = {
  *	Increment Register (word)
  * B	0100 0reg
  */
-/*B*/	{ op_inc,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x40),REG(0,0,0) }},
-/*A*/	{ op_inc,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xFE),IDS(0,SIGN_IGNORED),EAO(B000,0),SDS(0,0) }},
+/*B*/	{ op_inc,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x40),REG(0,0,0) },	CLK(2,0,3,0,2,0,0,0) },
+/*A*/	{ op_inc,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xFE),IDS(0,SIGN_IGNORED),EAO(B000,0),SDS(0,0) },	CLK(3,15,3,15,2,7,0,2) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-80
@@ -643,9 +664,9 @@ opcode opcodes[] = {
  *	Input string (bytes or words)
  *	0110 110w
  */
-	{ op_ins,	flag_186,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6C),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_ins,	flag_186,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6C),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_ins,	flag_186,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6C),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) }},
+	{ op_ins,	flag_186,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6C),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(0,0,14,8,5,4,0,1) },
+	{ op_ins,	flag_186,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6C),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(0,0,14,8,5,4,0,1) },
+	{ op_ins,	flag_186,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6C),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) },	CLK(0,0,14,8,5,4,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 98
@@ -656,8 +677,8 @@ opcode opcodes[] = {
  *	General interrupt
  * B	1100 1101, number
  */
-/*A*/	{ op_break,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCC) }},
-/*B*/	{ op_int,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xCD),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(0) }},
+/*A*/	{ op_break,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCC) },	CLK(52,0,45,0,23,0,5,0) },
+/*B*/	{ op_int,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xCD),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(0) },	CLK(51,0,47,0,23,0,5,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 99
@@ -665,7 +686,7 @@ opcode opcodes[] = {
  *	Interrupt on overflow 
  *	1100 1110
  */
-	{ op_into,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCE) }},
+	{ op_into,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCE) },	CLK(53,4,48,4,24,3,5,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 100
@@ -673,7 +694,7 @@ opcode opcodes[] = {
  *	Return from interrupt 
  *	1100 1111
  */
-	{ op_iret,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCF) }},
+	{ op_iret,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCF) },	CLK(24,0,28,0,17,0,3,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 101
@@ -682,8 +703,8 @@ opcode opcodes[] = {
  * 	Jump on Not Below or Equal 
  *	0111 0111, disp
  */
-	{ op_ja,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x77),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnbe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x77),REL(0,RANGE_BYTE,0,0) }},
+	{ op_ja,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x77),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnbe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x77),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 102
@@ -692,8 +713,8 @@ opcode opcodes[] = {
  * 	Jump on Not Below 
  *	0111 0011, disp
  */
-	{ op_jae,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x73),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnb,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x73),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jae,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x73),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnb,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x73),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 103
@@ -702,8 +723,8 @@ opcode opcodes[] = {
  * 	Jump on Not Above or Equal 
  *	0111 0010, disp
  */
-	{ op_jb,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x72),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnae,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x72),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jb,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x72),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnae,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x72),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 104
@@ -712,8 +733,8 @@ opcode opcodes[] = {
  * 	Jump on Not Above 
  *	0111 0110, disp
  */
-	{ op_jbe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x76),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jna,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x76),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jbe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x76),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jna,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x76),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 105
@@ -721,7 +742,7 @@ opcode opcodes[] = {
  *	Jump on Carry
  *	0111 0010, disp
  */
-	{ op_jc,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x72),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jc,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x72),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 106
@@ -729,7 +750,7 @@ opcode opcodes[] = {
  *	Jump on CX is Zero
  *	1110 0011, disp
  */
-	{ op_jcxz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE3),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jcxz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE3),REL(0,RANGE_BYTE,0,0) },	CLK(18,6,16,5,8,4,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 107
@@ -738,8 +759,8 @@ opcode opcodes[] = {
  * 	Jump on Zero 
  *	0111 0100, disp
  */
-	{ op_je,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x74),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x74),REL(0,RANGE_BYTE,0,0) }},
+	{ op_je,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x74),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x74),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 108
@@ -748,8 +769,8 @@ opcode opcodes[] = {
  * 	Jump on Not Less than or Equal 
  *	0111 1111, disp
  */
-	{ op_jg,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7F),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnle,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7F),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jg,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7F),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnle,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7F),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 109
@@ -758,8 +779,8 @@ opcode opcodes[] = {
  * 	Jump on Not Less than 
  *	0111 1101, disp
  */
-	{ op_jge,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7D),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnl,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7D),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jge,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7D),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnl,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7D),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 110
@@ -768,8 +789,8 @@ opcode opcodes[] = {
  * 	Jump on Not Greater than or Equal
  *	0111 1100, disp
  */
-	{ op_jl,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7C),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnge,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7C),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jl,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7C),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnge,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7C),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 111
@@ -778,8 +799,8 @@ opcode opcodes[] = {
  * 	Jump on Not Greater than
  *	0111 1110, disp
  */
-	{ op_jle,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7E),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jng,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7E),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jle,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7E),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jng,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7E),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 
 /* "Programming the 8086 8088" (Sybex 1983)
@@ -800,15 +821,15 @@ opcode opcodes[] = {
  * 	Jump far indirect (absolute 16 offset and 16 bit segment page)
  * E	1111 1111, mod 101 r/m
  */
-/*B*/	{ op_jmp,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xEB),REL(0,RANGE_BOTH,0,1) }},
-/*B*/	{ op_jmp,	flag_086,	no_prefix,		near_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xEB),REL(0,RANGE_BOTH,0,1) }},
-/*D*/	{ op_jmp,	flag_086|flag_abs,no_prefix,		no_modifier,	1,	{ ea_far_immediate, ea_empty },		3,	{ SB(0xEA),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),IMM(0) }},
-/*D*/	{ op_jmp,	flag_086|flag_abs,no_prefix,		far_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xEA),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),IMM(0) }},
-/*C*/	{ op_jmp,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		3,	{ SB(0xFF),FDS(DATA_SIZE_NEAR,SIGN_UNSIGNED),EAO(B100,0) }},
-/*E*/	{ op_jmp,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_far_mod_reg_adrs, ea_empty },	3,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),EAO(B101,0) }},
-/*E*/	{ op_jmp,	flag_086|flag_abs,lock_n_segments,	far_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		3,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),EAO(B101,0) }},
-/*D*/	{ op_ljmp,	flag_086|flag_abs,no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xEA),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),IMM(0) }},
-/*E*/	{ op_ljmp,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		3,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),EAO(B101,0) }},
+/*B*/	{ op_jmp,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xEB),REL(0,RANGE_BOTH,0,1) },	CLK(15,0,14,0,7,0,0,0) },
+/*B*/	{ op_jmp,	flag_086,	no_prefix,		near_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xEB),REL(0,RANGE_BOTH,0,1) },	CLK(15,0,14,0,7,0,0,0) },
+/*D*/	{ op_jmp,	flag_086|flag_abs,no_prefix,		no_modifier,	1,	{ ea_far_immediate, ea_empty },		3,	{ SB(0xEA),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),IMM(0) },	CLK(15,0,14,0,11,0,0,0) },
+/*D*/	{ op_jmp,	flag_086|flag_abs,no_prefix,		far_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xEA),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),IMM(0) },	CLK(15,0,14,0,11,0,0,0) },
+/*C*/	{ op_jmp,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		3,	{ SB(0xFF),FDS(DATA_SIZE_NEAR,SIGN_UNSIGNED),EAO(B100,0) },	CLK(11,18,11,17,7,11,0,1) },
+/*E*/	{ op_jmp,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_far_mod_reg_adrs, ea_empty },	3,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),EAO(B101,0) },	CLK(0,24,0,26,0,15,0,2) },
+/*E*/	{ op_jmp,	flag_086|flag_abs,lock_n_segments,	far_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		3,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),EAO(B101,0) },	CLK(0,24,0,26,0,15,0,2) },
+/*D*/	{ op_ljmp,	flag_086|flag_abs,no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xEA),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),IMM(0) },	CLK(15,0,14,0,11,0,0,0) },
+/*E*/	{ op_ljmp,	flag_086|flag_abs,lock_n_segments,	no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		3,	{ SB(0xFF),FDS(DATA_SIZE_FAR,SIGN_UNSIGNED),EAO(B101,0) },	CLK(0,24,0,26,0,15,0,2) },
 
 
 /* "Programming the 8086 8088" (Sybex 1983)
@@ -817,7 +838,7 @@ opcode opcodes[] = {
  *	Jump on Not Carry
  *	0111 0011, disp
  */
-	{ op_jnc,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x73),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jnc,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x73),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 115
@@ -826,8 +847,8 @@ opcode opcodes[] = {
  * 	Jump on Not Zero
  *	0111 0101, disp
  */
-	{ op_jne,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x75),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jnz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x75),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jne,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x75),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jnz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x75),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 116
@@ -835,7 +856,7 @@ opcode opcodes[] = {
  *	Jump on Not Overflow
  *	0111 0001, disp
  */
-	{ op_jno,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x71),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jno,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x71),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 117
@@ -843,7 +864,7 @@ opcode opcodes[] = {
  *	Jump on Not Sign
  *	0111 1001, disp
  */
-	{ op_jns,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x79),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jns,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x79),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 118
@@ -852,8 +873,8 @@ opcode opcodes[] = {
  *	Jump on Parity Odd
  *	0111 1011, disp
  */
-	{ op_jnp,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7B),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jpo,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7B),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jnp,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7B),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jpo,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7B),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 119
@@ -861,7 +882,7 @@ opcode opcodes[] = {
  *	Jump on Overflow
  *	0111 0000, disp
  */
-	{ op_jo,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x70),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jo,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x70),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 120
@@ -870,8 +891,8 @@ opcode opcodes[] = {
  *	Jump on Parity Equal
  *	0111 1010, disp
  */
-	{ op_jp,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7A),REL(0,RANGE_BYTE,0,0) }},
-	{ op_jpe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7A),REL(0,RANGE_BYTE,0,0) }},
+	{ op_jp,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7A),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
+	{ op_jpe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x7A),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 121
@@ -879,7 +900,7 @@ opcode opcodes[] = {
  *	Jump on Sign
  *	0111 1000, disp
  */
-	{ op_js,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x78),REL(0,RANGE_BYTE,0,0) }},
+	{ op_js,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0x78),REL(0,RANGE_BYTE,0,0) },	CLK(16,4,13,4,7,3,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 122
@@ -887,7 +908,7 @@ opcode opcodes[] = {
  *	Load register AH from flags
  *	1001 1111
  */
-	{ op_lahf,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAF) }},
+	{ op_lahf,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAF) },	CLK(4,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 123
@@ -896,7 +917,7 @@ opcode opcodes[] = {
  * 	Load DS from memory+2,3
  *	1100 0101, mod reg r/m
  */
-	{ op_lds,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_word_registers, ea_mem_mod_adrs },	2,	{ SB(0xC5),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) }},
+	{ op_lds,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_word_registers, ea_mem_mod_adrs },	2,	{ SB(0xC5),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) },	CLK(0,16,0,18,0,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 124
@@ -904,7 +925,7 @@ opcode opcodes[] = {
  *	Load reg (16-bit) with offset of memory argument
  *	1000 1101, mod reg r/m
  */
-	{ op_lea,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_word_registers, ea_mem_mod_adrs },	2,	{ SB(0x8D),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) }},
+	{ op_lea,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_word_registers, ea_mem_mod_adrs },	2,	{ SB(0x8D),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) },	CLK(0,2,0,6,0,3,0,0) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-109
@@ -912,7 +933,7 @@ opcode opcodes[] = {
  *	Return from subroutine deallocating the stack frame
  *	1100 1001
  */
-	{ op_leave,	flag_186,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xC9),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) }},
+	{ op_leave,	flag_186,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xC9),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) },	CLK(0,0,8,0,5,0,1,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 125
@@ -921,7 +942,7 @@ opcode opcodes[] = {
  * 	Load ES from memory+2,3
  *	1100 0100, mod reg r/m
  */
-	{ op_les,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_word_registers, ea_mem_mod_adrs },	2,	{ SB(0xC4),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) }},
+	{ op_les,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_word_registers, ea_mem_mod_adrs },	2,	{ SB(0xC4),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1) },	CLK(0,16,0,18,0,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 127
@@ -929,9 +950,9 @@ opcode opcodes[] = {
  *	Load String (Byte or word)
  *	1010 110w
  */
-	{ op_lods,	flag_086,	repeat_n_segments,	no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAC) }},
-	{ op_lods,	flag_086,	repeat_n_segments,	byte_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAC) }},
-	{ op_lods,	flag_086,	repeat_n_segments,	word_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAD) }},
+	{ op_lods,	flag_086,	repeat_n_segments,	no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAC) },	CLK(12,13,10,11,5,4,0,1) },
+	{ op_lods,	flag_086,	repeat_n_segments,	byte_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAC) },	CLK(12,13,10,11,5,4,0,1) },
+	{ op_lods,	flag_086,	repeat_n_segments,	word_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xAD) },	CLK(12,13,10,11,5,4,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 128
@@ -939,7 +960,7 @@ opcode opcodes[] = {
  *	Decrement CX, Loop if CX != 0
  *	1110 0010, disp
  */
-	{ op_loop,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE2),REL(0,RANGE_BYTE,0,0) }},
+	{ op_loop,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE2),REL(0,RANGE_BYTE,0,0) },	CLK(17,5,15,5,8,4,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 129
@@ -947,8 +968,8 @@ opcode opcodes[] = {
  *	Decrement CX, Loop if ( CX != 0 )&&( ZF == 1 )
  *	1110 0010, disp
  */
-	{ op_looppe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE1),REL(0,RANGE_BYTE,0,0) }},
-	{ op_looppz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE1),REL(0,RANGE_BYTE,0,0) }},
+	{ op_looppe,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE1),REL(0,RANGE_BYTE,0,0) },	CLK(18,6,16,6,8,4,0,0) },
+	{ op_looppz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE1),REL(0,RANGE_BYTE,0,0) },	CLK(18,6,16,6,8,4,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 130
@@ -956,8 +977,8 @@ opcode opcodes[] = {
  *	Decrement CX, Loop if ( CX != 0 )&&( ZF == 0 )
  *	1110 0010, disp
  */
-	{ op_loopne,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE0),REL(0,RANGE_BYTE,0,0) }},
-	{ op_loopnz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE0),REL(0,RANGE_BYTE,0,0) }},
+	{ op_loopne,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE0),REL(0,RANGE_BYTE,0,0) },	CLK(19,5,16,5,8,4,0,0) },
+	{ op_loopnz,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		2,	{ SB(0xE0),REL(0,RANGE_BYTE,0,0) },	CLK(19,5,16,5,8,4,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 131,132
@@ -983,14 +1004,14 @@ opcode opcodes[] = {
  *	Move segment Register to Memory or Register Operand
  * G	1000 1100, mod 0+reg r/m
  */
-/*C*/	{ op_mov,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_all_reg, ea_immediate },		5,	{ SB(0xB0),IDS(0,SIGN_IGNORED),REG(0,0,0),IMM(1),SDS(0,3) }},
-/*B*/	{ op_mov,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0xC6),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) }},
-/*D*/	{ op_mov,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_accumulators, ea_indirect },	4,	{ SB(0xA0),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*E*/	{ op_mov,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_indirect, ea_accumulators },	4,	{ SB(0xA0),IDS(1,SIGN_IGNORED),IMM(0),SDS(0,0) }},
-/*A*/	{ op_mov,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x88),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_mov,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x88),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
-/*F*/	{ op_mov,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_segment_reg, ea_mod_wreg_adrs },	3,	{ SB(0x8E),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),EA(0,1) }},
-/*G*/	{ op_mov,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_segment_reg },	3,	{ SB(0x8C),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),EA(1,0) }},
+/*C*/	{ op_mov,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_all_reg, ea_immediate },		5,	{ SB(0xB0),IDS(0,SIGN_IGNORED),REG(0,0,0),IMM(1),SDS(0,3) },	CLK(4,0,4,0,2,0,0,0) },
+/*B*/	{ op_mov,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0xC6),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) },	CLK(4,10,4,12,2,3,0,1) },
+/*D*/	{ op_mov,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_accumulators, ea_indirect },	4,	{ SB(0xA0),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(0,4,0,8,0,5,0,1) },
+/*E*/	{ op_mov,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_indirect, ea_accumulators },	4,	{ SB(0xA0),IDS(1,SIGN_IGNORED),IMM(0),SDS(0,0) },	CLK(0,4,0,9,0,3,0,1) },
+/*A*/	{ op_mov,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x88),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(2,8,2,9,2,5,0,1) },
+/*A*/	{ op_mov,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x88),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(2,9,2,12,2,3,0,1) },
+/*F*/	{ op_mov,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_segment_reg, ea_mod_wreg_adrs },	3,	{ SB(0x8E),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),EA(0,1) },	CLK(2,8,2,9,2,5,0,1) },
+/*G*/	{ op_mov,	flag_086|flag_abs,lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_segment_reg },	3,	{ SB(0x8C),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),EA(1,0) },	CLK(2,9,2,11,2,3,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 133
@@ -998,9 +1019,9 @@ opcode opcodes[] = {
  * 	MOVe String (from SI to DI)
  *	1010 010w
  */
-	{ op_movs,	flag_086,	repeat_n_segments,	no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xA4) }},
-	{ op_movs,	flag_086,	repeat_n_segments,	byte_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xA4) }},
-	{ op_movs,	flag_086,	repeat_n_segments,	word_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xA5) }},
+	{ op_movs,	flag_086,	repeat_n_segments,	no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xA4) },	CLK(18,17,9,8,5,4,0,2) },
+	{ op_movs,	flag_086,	repeat_n_segments,	byte_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xA4) },	CLK(18,17,9,8,5,4,0,2) },
+	{ op_movs,	flag_086,	repeat_n_segments,	word_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xA5) },	CLK(18,17,9,8,5,4,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 134
@@ -1008,7 +1029,7 @@ opcode opcodes[] = {
  * 	MULtiply source
  *	1111 011w, mod 100 r/m
  */
-	{ op_mul,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_UNSIGNED),EAO(B100,0),SDS(0,0) }},
+	{ op_mul,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_UNSIGNED),EAO(B100,0),SDS(0,0) },	CLK(77,83,28,34,13,16,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 135
@@ -1016,7 +1037,7 @@ opcode opcodes[] = {
  * 	NEGate distination (2s complement)
  *	1111 011w, mod 011 r/m
  */
-	{ op_neg,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B011,0),SDS(0,0) }},
+	{ op_neg,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B011,0),SDS(0,0) },	CLK(3,16,3,13,2,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 136
@@ -1024,7 +1045,7 @@ opcode opcodes[] = {
  * 	No OPeration
  *	1001 0000
  */
-	{ op_nop,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x90) }},
+	{ op_nop,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x90) },	CLK(3,0,3,0,3,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Pages 137
@@ -1032,7 +1053,7 @@ opcode opcodes[] = {
  * 	NOT distination (1s complement)
  *	1111 011w, mod 010 r/m
  */
-	{ op_neg,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B010,0),SDS(0,0) }},
+	{ op_neg,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B010,0),SDS(0,0) },	CLK(3,16,3,13,2,7,0,2) },
 
 
 /* "Programming the 8086 8088" (Sybex 1983)
@@ -1043,14 +1064,16 @@ opcode opcodes[] = {
  * 
  *	Or immediate Operand to Memory or Register Operand
  * B	1000 00sw, mod 001 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	Or immediate Operand to Accumulator
  * C	0000 110w, data, data if w =1
  */
-/*C*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x0C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B001,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x08),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x08),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x0C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B001,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x08),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x08),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_or,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B001,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 140
@@ -1061,8 +1084,8 @@ opcode opcodes[] = {
  *	Output byte or word (indirect port, DX)
  * B	1110 111w
  */
-/*B*/	{ op_out,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_accumulators, ea_empty },		3,	{ SB(0xEE),IDS(0,SIGN_IGNORED),SDS(0,0) }},
-/*A*/	{ op_out,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_immediate, ea_accumulators },	5,	{ SB(0xE6),IDS(1,SIGN_UNSIGNED),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(0) }},
+/*B*/	{ op_out,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_accumulators, ea_empty },		3,	{ SB(0xEE),IDS(0,SIGN_IGNORED),SDS(0,0) },	CLK(8,0,7,0,3,0,0,1) },
+/*A*/	{ op_out,	flag_086,	no_prefix,		no_modifier,	2,	{ ea_immediate, ea_accumulators },	5,	{ SB(0xE6),IDS(1,SIGN_UNSIGNED),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(0) },	CLK(10,0,9,0,3,0,0,1) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-126
@@ -1070,9 +1093,9 @@ opcode opcodes[] = {
  *	Output string (bytes or words)
  *	0110 111w
  */
-	{ op_outs,	flag_186,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6E),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_outs,	flag_186,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6E),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_outs,	flag_186,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6E),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) }},
+	{ op_outs,	flag_186,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6E),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(0,0,14,8,5,4,0,1) },
+	{ op_outs,	flag_186,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6E),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(0,0,14,8,5,4,0,1) },
+	{ op_outs,	flag_186,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0x6E),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) },	CLK(0,0,14,8,5,4,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 141
@@ -1086,9 +1109,9 @@ opcode opcodes[] = {
  * C	Pop segment register (except CS)
  * 	000r eg111
  */
-/*C*/	{ op_pop,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_segment_reg, ea_empty },		3,	{ SB(0x07),TER(0,MATCH_FALSE,REG_CS),REG(0,0,3) }},
-/*B*/	{ op_pop,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x58),REG(0,0,0) }},
-/*A*/	{ op_pop,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		2,	{ SB(0x8F),EAO(B000,0) }},
+/*C*/	{ op_pop,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_segment_reg, ea_empty },		3,	{ SB(0x07),TER(0,MATCH_FALSE,REG_CS),REG(0,0,3) },	CLK(8,0,8,0,5,0,1,0) },
+/*B*/	{ op_pop,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x58),REG(0,0,0) },	CLK(8,0,10,0,5,0,1,0) },
+/*A*/	{ op_pop,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		2,	{ SB(0x8F),EAO(B000,0) },	CLK(8,17,10,20,5,5,1,1) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-129,130
@@ -1096,7 +1119,7 @@ opcode opcodes[] = {
  *	Pop all registers
  *	0110 0001
  */
-	{ op_popa,	flag_186,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x61) }},
+	{ op_popa,	flag_186,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x61) },	CLK(0,0,51,0,19,0,8,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 141
@@ -1106,7 +1129,7 @@ opcode opcodes[] = {
  *	Pop flags
  *	1001 1101
  */
-	{ op_popf,	flag_086,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9D) }},
+	{ op_popf,	flag_086,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9D) },	CLK(8,0,8,0,5,0,1,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 143
@@ -1120,9 +1143,9 @@ opcode opcodes[] = {
  * C	Push segment register
  * 	000r eg110
  */
-/*C*/	{ op_push,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_segment_reg, ea_empty },		2,	{ SB(0x06),REG(0,0,3) }},
-/*B*/	{ op_push,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x50),REG(0,0,0) }},
-/*A*/	{ op_push,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		2,	{ SB(0xFF),EAO(B110,0) }},
+/*C*/	{ op_push,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_segment_reg, ea_empty },		2,	{ SB(0x06),REG(0,0,3) },	CLK(10,0,9,0,3,0,1,0) },
+/*B*/	{ op_push,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_word_registers, ea_empty },	2,	{ SB(0x50),REG(0,0,0) },	CLK(11,0,10,0,3,0,1,0) },
+/*A*/	{ op_push,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		2,	{ SB(0xFF),EAO(B110,0) },	CLK(11,16,10,16,3,5,1,1) },
 
 /* "iAPX86 88 186 188 Programmers_Reference" (Intel 1983)
  * Page 3-134,135
@@ -1130,7 +1153,7 @@ opcode opcodes[] = {
  *	Push all registers
  *	0110 0000
  */
-	{ op_pusha,	flag_186,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x60) }},
+	{ op_pusha,	flag_186,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x60) },	CLK(0,0,36,0,17,0,8,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 144
@@ -1140,7 +1163,7 @@ opcode opcodes[] = {
  *	Pop flags
  *	1001 1100
  */
-	{ op_popf,	flag_086,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9C) }},
+	{ op_popf,	flag_086,	pref_lock,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9C) },	CLK(10,0,9,0,3,0,1,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 145
@@ -1158,9 +1181,9 @@ opcode opcodes[] = {
  * C	1100 000w, mod 010 r/m, imm8
  *	
  */
-/*A*/	{ op_rcl,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B010,0),SDS(0,0) }},
-/*B*/	{ op_rcl,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B010,0),SDS(0,0) }},
-/*C*/	{ op_rcl,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B010,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_rcl,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B010,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_rcl,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B010,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_rcl,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B010,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 146
@@ -1178,9 +1201,9 @@ opcode opcodes[] = {
  * C	1100 000w, mod 011 r/m, imm8
  *	
  */
-/*A*/	{ op_rcr,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B011,0),SDS(0,0) }},
-/*B*/	{ op_rcr,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B011,0),SDS(0,0) }},
-/*C*/	{ op_rcr,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B011,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_rcr,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B011,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_rcr,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B011,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_rcr,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B011,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 149,150
@@ -1197,12 +1220,12 @@ opcode opcodes[] = {
  *	Return from subroutine (far) with 16-bit stack correction
  * D	1100 1010, imm-l, imm-h
  */
-/*B*/	{ op_ret,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xC2),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) }},
-/*A*/	{ op_ret,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xC3) }},
-/*D*/	{ op_ret,	flag_086|flag_abs,no_prefix,		far_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xCA),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) }},
-/*C*/	{ op_ret,	flag_086|flag_abs,no_prefix,		far_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCB) }},
-/*D*/	{ op_lret,	flag_086|flag_abs,no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xCA),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) }},
-/*C*/	{ op_lret,	flag_086|flag_abs,no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCB) }},
+/*B*/	{ op_ret,	flag_086,	no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xC2),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) },	CLK(12,0,18,0,11,0,1,0) },
+/*A*/	{ op_ret,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xC3) },	CLK(8,0,16,0,11,0,1,0) },
+/*D*/	{ op_ret,	flag_086|flag_abs,no_prefix,		far_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xCA),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) },	CLK(17,0,25,0,15,0,2,0) },
+/*C*/	{ op_ret,	flag_086|flag_abs,no_prefix,		far_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCB) },	CLK(18,0,22,0,15,0,2,0) },
+/*D*/	{ op_lret,	flag_086|flag_abs,no_prefix,		no_modifier,	1,	{ ea_immediate, ea_empty },		3,	{ SB(0xCA),FDS(DATA_SIZE_WORD,SIGN_UNSIGNED),IMM(0) },	CLK(17,0,25,0,15,0,2,0) },
+/*C*/	{ op_lret,	flag_086|flag_abs,no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xCB) },	CLK(18,0,22,0,15,0,2,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 151
@@ -1220,9 +1243,9 @@ opcode opcodes[] = {
  * C	1100 000w, mod 010 r/m, imm8
  *	
  */
-/*A*/	{ op_rol,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B000,0),SDS(0,0) }},
-/*B*/	{ op_rol,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B000,0),SDS(0,0) }},
-/*C*/	{ op_rol,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B000,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_rol,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B000,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_rol,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B000,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_rol,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B000,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 152
@@ -1240,9 +1263,9 @@ opcode opcodes[] = {
  * C	1100 000w, mod 011 r/m, imm8
  *	
  */
-/*A*/	{ op_ror,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B001,0),SDS(0,0) }},
-/*B*/	{ op_ror,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B001,0),SDS(0,0) }},
-/*C*/	{ op_ror,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B001,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_ror,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B001,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_ror,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B001,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_ror,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B001,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 153
@@ -1250,7 +1273,7 @@ opcode opcodes[] = {
  *	Store AH to F (bits 7,6,4,2 and 0 only)
  *	1001 1110
  */
-	{ op_sahf,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9E) }},
+	{ op_sahf,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9E) },	CLK(4,0,3,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 154,155
@@ -1265,12 +1288,12 @@ opcode opcodes[] = {
  *
  * C	1100 000w, mod 100 r/m, imm8	Shift imm8 bits
  */
-/*A*/	{ op_sal,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0) }},
-/*B*/	{ op_sal,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B100,0),SDS(0,0) }},
-/*C*/	{ op_sal,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
-/*A*/	{ op_shl,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0) }},
-/*B*/	{ op_shl,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B100,0),SDS(0,0) }},
-/*C*/	{ op_shl,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_sal,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_sal,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B100,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_sal,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
+/*A*/	{ op_shl,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_shl,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B100,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_shl,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 156,157
@@ -1284,9 +1307,9 @@ opcode opcodes[] = {
  *
  * C	1100 000w, mod 111 r/m, imm8	Shift imm8 bits
  */
-/*A*/	{ op_sar,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0) }},
-/*B*/	{ op_sar,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B100,0),SDS(0,0) }},
-/*C*/	{ op_sar,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_sar,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_sar,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B100,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_sar,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B100,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 158
@@ -1296,14 +1319,16 @@ opcode opcodes[] = {
  * 
  *	Subtract with Borrow immediate Operand to Memory or Register Operand
  * B	1000 00sw, mod 011 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	Subtract with Borrow immediate Operand to Accumulator
  * C	0001 110w, data, data if w =1
  */
-/*C*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x1C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B011,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x18),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x18),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x1C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B011,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x18),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x18),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_sbb,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B011,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 159
@@ -1311,9 +1336,9 @@ opcode opcodes[] = {
  *	SCAn String (Byte or words)
  *	1010 111w
  */
-	{ op_scas,	flag_086,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAE),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_scas,	flag_086,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAE),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_scas,	flag_086,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAE),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) }},
+	{ op_scas,	flag_086,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAE),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(15,15,15,15,7,8,0,1) },
+	{ op_scas,	flag_086,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAE),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(15,15,15,15,7,8,0,1) },
+	{ op_scas,	flag_086,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAE),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) },	CLK(15,15,15,15,7,8,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 160,161
@@ -1327,9 +1352,9 @@ opcode opcodes[] = {
  *
  * C	1100 000w, mod 101 r/m, imm8	Shift imm8 bits
  */
-/*A*/	{ op_shr,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B101,0),SDS(0,0) }},
-/*B*/	{ op_shr,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B101,0),SDS(0,0) }},
-/*C*/	{ op_shr,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B101,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) }},
+/*A*/	{ op_shr,	flag_086,	lock_n_segments,	no_modifier,	1,	{ ea_mod_reg_adrs, ea_empty },		4,	{ SB(0xD0),IDS(0,SIGN_IGNORED),EAO(B101,0),SDS(0,0) },	CLK(2,15,2,15,2,7,0,2) },
+/*B*/	{ op_shr,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_byte_reg },	5,	{ SB(0xD2),IDS(0,SIGN_IGNORED),TER(1,MATCH_TRUE,REG_CL),EAO(B101,0),SDS(0,0) },	CLK(8,20,5,17,5,8,0,2) },
+/*C*/	{ op_shr,	flag_186,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	6,	{ SB(0xC0),IDS(0,SIGN_IGNORED),EAO(B101,0),SDS(0,0),FDS(DATA_SIZE_BYTE,SIGN_UNSIGNED),IMM(1) },	CLK(0,0,5,17,5,8,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 162
@@ -1337,7 +1362,7 @@ opcode opcodes[] = {
  *	Set Carry Flag
  *	1111 1001
  */
-	{ op_stc,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFA) }},
+	{ op_stc,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFA) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 163
@@ -1345,7 +1370,7 @@ opcode opcodes[] = {
  *	Set Direction Flag
  *	1111 1101
  */
-	{ op_std,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFD) }},
+	{ op_std,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFD) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 164
@@ -1353,7 +1378,7 @@ opcode opcodes[] = {
  *	Set Interrupt enable Flag
  *	1111 1011
  */
-	{ op_sti,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFB) }},
+	{ op_sti,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xFB) },	CLK(2,0,2,0,2,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 165
@@ -1361,9 +1386,9 @@ opcode opcodes[] = {
  *	STOre String (Byte or words)
  *	1010 101w
  */
-	{ op_stos,	flag_086,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAA),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_stos,	flag_086,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAA),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) }},
-	{ op_stos,	flag_086,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAA),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) }},
+	{ op_stos,	flag_086,	rep_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAA),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(11,10,10,9,3,3,0,1) },
+	{ op_stos,	flag_086,	rep_prefix,		byte_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAA),FDS(DATA_SIZE_BYTE,SIGN_IGNORED),SDS(0,0) },	CLK(11,10,10,9,3,3,0,1) },
+	{ op_stos,	flag_086,	rep_prefix,		word_modifier,	0,	{ ea_empty, ea_empty },			3,	{ SB(0xAA),FDS(DATA_SIZE_WORD,SIGN_IGNORED),SDS(0,0) },	CLK(11,10,10,9,3,3,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 166
@@ -1373,14 +1398,16 @@ opcode opcodes[] = {
  * 
  *	Subtract immediate Operand to Memory or Register Operand
  * B	1000 00sw, mod 101 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
  *
  *	Subtract immediate Operand to Accumulator
  * C	0010 110w, data, data if w =1
  */
-/*C*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x2C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B101,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x28),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x28),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x2C),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B101,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x28),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x28),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_sub,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B101,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 167
@@ -1396,10 +1423,10 @@ opcode opcodes[] = {
  *	Immediate Operand with Accumulator
  * C	1010 100w, data, data (ifw=1)
  */
-/*C*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0xA8),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x84),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x84),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0xA8),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0xF6),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) },	CLK(5,11,4,10,3,6,0,1) },
+/*A*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x84),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,6,0,1) },
+/*A*/	{ op_test,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x84),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,9,3,10,2,6,0,1) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 169
@@ -1407,7 +1434,7 @@ opcode opcodes[] = {
  *	Wait
  *	1001 1011
  */
-	{ op_wait,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9B) }},
+	{ op_wait,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0x9B) },	CLK(3,0,6,0,3,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 170
@@ -1420,9 +1447,9 @@ opcode opcodes[] = {
  *	Exchange accumulator (AX) with register
  * B	1001 0reg
  */
-/*B*/	{ op_xchg,	flag_086,	lock_n_segments,	no_modifier,	0,	{ ea_word_acc, ea_word_registers },	1,	{ SB(0x90),FDS(DATA_SIZE_WORD,SIGN_IGNORED),VDS(1),REG(1,0,0) }},
-/*A*/	{ op_xchg,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	5,	{ SB(0x86),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_xchg,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	5,	{ SB(0x86),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*B*/	{ op_xchg,	flag_086,	lock_n_segments,	no_modifier,	0,	{ ea_word_acc, ea_word_registers },	1,	{ SB(0x90),FDS(DATA_SIZE_WORD,SIGN_IGNORED),VDS(1),REG(1,0,0) },	CLK(3,0,3,0,3,0,0,0) },
+/*A*/	{ op_xchg,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	5,	{ SB(0x86),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(4,17,4,17,3,5,0,2) },
+/*A*/	{ op_xchg,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	5,	{ SB(0x86),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(4,17,4,17,3,5,0,2) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 171
@@ -1430,7 +1457,7 @@ opcode opcodes[] = {
  *	Translate
  *	1101 0111
  */
-	{ op_xlat,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xD7) }},
+	{ op_xlat,	flag_086,	no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			1,	{ SB(0xD7) },	CLK(11,0,11,0,5,0,0,0) },
 
 /* "Programming the 8086 8088" (Sybex 1983)
  * Page 172,173
@@ -1441,15 +1468,18 @@ opcode opcodes[] = {
  * A	0011 00dw, mod reg r/m
  *
  *	Immediate Operand with Memory or Register Operand
- * B	1000 000w, mod 000 r/m, data, data (ifw=1)
+ * B	1000 00sw, mod 110 r/m, data, data if sw = 01
+ *		(sw = 11 sign extends a single byte of data)
+ *		(the book shows mod 000 r/m, which is ADD)
  *
  *	Immediate Operand with Accumulator
  * C	0011 010w, data, data (ifw=1)
  */
-/*C*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x34),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) }},
-/*B*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B000,0),IMM(1),SDS(0,0) }},
-/*A*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x30),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) }},
-/*A*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x30),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) }},
+/*C*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_accumulators, ea_immediate },	4,	{ SB(0x34),IDS(0,SIGN_IGNORED),IMM(1),SDS(0,0) },	CLK(4,0,4,0,3,0,0,0) },
+/*B*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_immediate },	5,	{ SB(0x80),IDS(0,SIGN_IGNORED),EAO(B110,0),IMM(1),SDS(0,0) },	CLK(4,17,4,16,3,7,0,2) },
+/*A*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_all_reg, ea_mod_reg_adrs },	6,	{ SB(0x30),SDR(DIRECT_TO_REG,0,1),IDS(0,SIGN_IGNORED),EA(0,1),SDS(0,0),VDS(1) },	CLK(3,9,3,10,2,7,0,1) },
+/*A*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_reg_adrs, ea_all_reg },	6,	{ SB(0x30),SDR(DIRECT_TO_EA,0,1),IDS(1,SIGN_IGNORED),EA(1,0),SDS(0,0),VDS(0) },	CLK(3,16,3,10,2,7,0,2) },
+/*B*/	{ op_xor,	flag_086,	lock_n_segments,	no_modifier,	2,	{ ea_mod_wreg_adrs, ea_immediate },	4,	{ SB(0x83),IDS(0,SIGN_IGNORED),EAO(B110,0),SXI(1) },	CLK(4,17,4,16,3,7,0,2) },
 
 /*
  * "80286 and 80287 Programmer's Reference Manula" (Intel 1987)
@@ -1490,21 +1520,21 @@ opcode opcodes[] = {
  *	Opcode		Instruction	Clocks		Description
  *	63 /r		ARPL ew,rw	10,mem=11	Adjust RPL of EA word not less than RPL of rw
  */
-	{ op_arpl,	flag_286|flag_priv, no_prefix,		no_modifier,	2,	{ ea_mod_wreg_adrs, ea_word_registers }, 4,	{ SB(0x63),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(1,0),VDS(0) }},
+	{ op_arpl,	flag_286|flag_priv, no_prefix,		no_modifier,	2,	{ ea_mod_wreg_adrs, ea_word_registers }, 4,	{ SB(0x63),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(1,0),VDS(0) },	CLK(0,0,0,0,10,11,0,0) },
 
 /*
  *	CLTS - Clear Task Switched Flag
  *	Opcode		Instruction	Clocks		Description
  *	0F 06		CLTS		2		Clear task switched flag
  */
-	{ op_clts,	flag_286|flag_priv, no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			2,	{ SB(0x0F),SB(0x06) }},
+	{ op_clts,	flag_286|flag_priv, no_prefix,		no_modifier,	0,	{ ea_empty, ea_empty },			2,	{ SB(0x0F),SB(0x06) },	CLK(0,0,0,0,2,0,0,0) },
 
 /*
  *	LAR - Load Access Rights Byte
  *	Opcode		Instruction	Clocks		Description
  *	0F 02 /r	LAR rw,ew	14,mem=16	Load: high(rw)= Access Rights byte, selector ew
  */
-	{ op_lar,	flag_286|flag_priv, no_prefix,		no_modifier,	2,	{ ea_word_registers, ea_mod_wreg_adrs }, 5,	{ SB(0x0F),SB(0x02),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1),VDS(1) }},
+	{ op_lar,	flag_286|flag_priv, no_prefix,		no_modifier,	2,	{ ea_word_registers, ea_mod_wreg_adrs }, 5,	{ SB(0x0F),SB(0x02),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1),VDS(1) },	CLK(0,0,0,0,14,16,0,0) },
 
 /*
  *	LGDT LIDT - Load Global/Interrupt Descriptor Table Register
@@ -1512,36 +1542,36 @@ opcode opcodes[] = {
  *	0F 01 /2	LGDT m		11		Load m into Global Descriptor Table reg
  *	0F 01 /3	LIDT m		12		Load m into Interrupt Descriptor Table reg
  */
-	{ op_lgdt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B010,0) }},
-	{ op_lidt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B011,0) }},
+	{ op_lgdt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B010,0) },	CLK(0,0,0,0,0,11,0,0) },
+	{ op_lidt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B011,0) },	CLK(0,0,0,0,0,12,0,0) },
 
 /*
  *	LLDT - Load Local Descriptor Table Register
  *	Opcode		Instruction	Clocks		Description
  *	0F 00 /2	LLDT ew		17,mem=19	Load selector ew into Local Descriptor Table register
  */
-	{ op_lldt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B010,0) }},
+	{ op_lldt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B010,0) },	CLK(0,0,0,0,17,19,0,0) },
 
 /*
  *	LMSW - Load Machine Status Word
  *	Opcode		Instruction	Clocks		Description
  *	0F 01 /6	LMSW ew		3,mem=6		Load EA word into Machine Status Word
  */
-	{ op_lmsw,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B110,0) }},
+	{ op_lmsw,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B110,0) },	CLK(0,0,0,0,3,6,0,0) },
 
 /*
  *	LSL - Load Segment Limit
  *	Opcode		Instruction	Clocks		Description
  *	0F 03 /r	LSL rw,ew	14,mem=16	Load: rw = Segment Limit, selector ew
  */
-	{ op_lsl,	flag_286|flag_priv, no_prefix,		no_modifier,	2,	{ ea_word_registers, ea_mod_wreg_adrs }, 5,	{ SB(0x0F),SB(0x03),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1),VDS(1) }},
+	{ op_lsl,	flag_286|flag_priv, no_prefix,		no_modifier,	2,	{ ea_word_registers, ea_mod_wreg_adrs }, 5,	{ SB(0x0F),SB(0x03),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EA(0,1),VDS(1) },	CLK(0,0,0,0,14,16,0,0) },
 
 /*
  *	LTR - Load Task Register
  *	Opcode		Instruction	Clocks		Description
  *	0F 00 /3	LTR ew		17,mem=19	Load EA word into Task Register
  */
-	{ op_ltr,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B011,0) }},
+	{ op_ltr,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B011,0) },	CLK(0,0,0,0,17,19,0,0) },
 
 /*
  *	SGDT / SIDT - Store Global/Interrupt Descriptor Table Register
@@ -1549,29 +1579,29 @@ opcode opcodes[] = {
  *	0F 01 /0	SGDT m		11		Store Global Descriptor Table register to m
  *	0F 01 /1	SIDT m		12		Store Interrupt Descriptor Table register to m
  */
-	{ op_sgdt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B000,0) }},
-	{ op_sidt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B001,0) }},
+	{ op_sgdt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B000,0) },	CLK(0,0,0,0,0,11,0,0) },
+	{ op_sidt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mem_mod_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B001,0) },	CLK(0,0,0,0,0,12,0,0) },
 
 /*
  *	SLDT - Store Local Descriptor Table Register
  *	Opcode		Instruction	Clocks		Description
  *	0F 00 /0	SLDT ew		2,mem=3		Store Local Descriptor Table register to EA word
  */
-	{ op_sldt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B000,0) }},
+	{ op_sldt,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B000,0) },	CLK(0,0,0,0,2,3,0,0) },
 
 /*
  *	SMSW - Store Machine Status Word
  *	Opcode		Instruction	Clocks		Description
  *	0F 01 /4	SMSW ew		2,mem=3		Store Machine Status Word to EA word
  */
-	{ op_smsw,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B100,0) }},
+	{ op_smsw,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x01),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B100,0) },	CLK(0,0,0,0,2,3,0,0) },
 
 /*
  *	STR - Store Task Register
  *	Opcode		Instruction	Clocks		Description
  *	0F 00 /1	STR ew		2,mem=3		Store Task Register to EA word
  */
-	{ op_str,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B001,0) }},
+	{ op_str,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B001,0) },	CLK(0,0,0,0,2,3,0,0) },
 
 /*
  *	VERR / VERW - Verify a Segment for Reading or Writing
@@ -1579,8 +1609,8 @@ opcode opcodes[] = {
  *	0F 00 /4	VERR ew		14,mem=16	Set ZF=1 if seg. can be read, selector ew
  *	0F 00 /5	VERW ew		14,mem=16	Set ZF=1 if seg. can be written, selector ew
  */
-	{ op_verr,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B100,0) }},
-	{ op_verw,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B101,0) }},
+	{ op_verr,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B100,0) },	CLK(0,0,0,0,14,16,0,0) },
+	{ op_verw,	flag_286|flag_priv, no_prefix,		no_modifier,	1,	{ ea_mod_wreg_adrs, ea_empty },		4,	{ SB(0x0F),SB(0x00),FDS(DATA_SIZE_WORD,SIGN_IGNORED),EAO(B101,0) },	CLK(0,0,0,0,14,16,0,0) },
 
 
 
@@ -1592,13 +1622,27 @@ opcode opcodes[] = {
 
 
 
+/*
+ *	Scan the table from the definition given for one matching
+ *	the details provided.
+ */
+static opcode *scan_opcodes( opcode *search, modifier mods, component op, int args, ea_breakdown *format ) {
+	int	a;
+
+	for( ; search->op != nothing; search++ ) {
+		pass_stats.candidates++;
+		if(( search->op == op )&&( search->args == args )&&( search->mods == mods )) {
+			for( a = 0; a < args; a++ ) if(( search->arg[ a ] & format[ a ].ea ) != format[ a ].ea ) break;
+			if( a == args ) return( search );
+		}
+	}
+	return( NIL( opcode ));
+}
+
 /*
  *	Look for an instruction definition given the details provided.
  */
 opcode *find_opcode( modifier mods, component op, int args, ea_breakdown *format ) {
-	opcode	*search;
-	int	a;
-	
 	/*
 	 *	So .. at this point we have gathered everything together
 	 *	all the bits and pieces which will allow us to identify
@@ -1606,13 +1650,18 @@ opcode *find_opcode( modifier mods, component op, int args, ea_breakdown *format
 	 *
 	 *	In theory.
 	 */
-	for( search = opcodes; search->op != nothing; search++ ) {
-		if(( search->op == op )&&( search->args == args )&&( search->mods == mods )) {
-			for( a = 0; a < args; a++ ) if(( search->arg[ a ] & format[ a ].ea ) != format[ a ].ea ) break;
-			if( a == args ) return( search );
-		}
-	}
-	return( NIL( opcode ));
+	pass_stats.opcodes++;
+	return( scan_opcodes( opcodes, mods, op, args, format ));
+}
+
+/*
+ *	Look for any further definitions which match.
+ */
+opcode *next_opcode( opcode *last, modifier mods, component op, int args, ea_breakdown *format ) {
+	ASSERT( last != NIL( opcode ));
+	ASSERT( last->op != nothing );
+
+	return( scan_opcodes( last+1, mods, op, args, format ));
 }
 
 
@@ -340,10 +340,10 @@ typedef enum {
 #if defined( VERIFICATION )||defined( DEBUG )
 
 	/*
-	 *	Debugging code to output an AC or EA bit map in text to stdout.
+	 *	Debugging code to output an AC or EA bit map in text.
 	 */
-	extern void show_ac_bitmap( arg_component ac );
-	extern void show_ea_bitmap( effective_address ea );
+	extern void show_ac_bitmap( FILE *to, arg_component ac );
+	extern void show_ea_bitmap( FILE *to, effective_address ea );
 
 #endif
 
@@ -396,6 +396,53 @@ typedef struct {
 	constant_value		immediate_arg;		/* Any numerical constant value */
 } ea_breakdown;
 
+/*
+ *	The CPUs for which instruction timings are held.  The 8088
+ *	and 80188 are timed as the 8086 and 80186 plus a penalty
+ *	for each word moved across their byte wide data bus.
+ */
+#define TIMING_8086		0
+#define TIMING_80186		1
+#define TIMING_80286		2
+#define TIMED_CPUS		3
+
+/*
+ *	The clocks taken by an instruction form, from the Intel
+ *	data sheets, for each of the timed CPUs:
+ *
+ *	reg	With register (or no) operands.  For a conditional
+ *		transfer this is the time when the branch is taken
+ *		and for a string instruction a single execution.
+ *
+ *	mem	With a memory operand.  On the 8086 this excludes
+ *		the effective address calculation (which is added
+ *		by the cost model), the later CPUs including it.
+ *		For a conditional transfer this is the time when
+ *		the branch is not taken and for a string instruction
+ *		each repetition under a repeat prefix.
+ *
+ *	A zero indicates the form is not available on that CPU.
+ *
+ *	The number of word transfers is recorded for the 8-bit
+ *	bus penalty: 'fixed' transfers (the stack) are always
+ *	words while 'operand' transfers only count when the data
+ *	is a word and is in memory (or the form has no choice
+ *	of operand, as with the string and port instructions).
+ */
+typedef struct {
+	byte		reg[ TIMED_CPUS ],
+			mem[ TIMED_CPUS ],
+			fixed,
+			operand;
+} opcode_timing;
+
+/*
+ *	Timing entries are given as CPU pairs of register and
+ *	memory clocks (8086, 80186 then 80286) followed by the
+ *	fixed and operand transfers.
+ */
+#define CLK(r0,m0,r1,m1,r2,m2,f,o)	{{(r0),(r1),(r2)},{(m0),(m1),(m2)},(f),(o)}
+
 /*
  *	Define the structures which are used to hold the machine code
  *	definitions allowing the assembler to build the output instructions.
@@ -415,6 +462,10 @@ typedef struct _opcode {
 	 */
 	int			encoded;
 	word			encode[ MAX_OPCODE_ENCODING ];
+	/*
+	 *	Timing components:
+	 */
+	opcode_timing		clocks;
 } opcode;
 
 
@@ -722,7 +773,26 @@ typedef struct _opcode {
 #define REL_BIT(w)	EXTRACT((w),REL_BIT_BITS,REL_BIT_LSB)
 
 /*
- *	TEst Register (Action 11)
+ *	Sign eXtended Immediate (Action 11)
+ *
+ *	Encode immediate data as a single byte which the CPU sign
+ *	extends to a word.  The form only applies to word data
+ *	with a value (not an address) which survives the extension;
+ *	otherwise it is quietly declined, leaving the full width
+ *	form to be used.
+ *
+ *	SXI(a)		a = Argument number of immediate data
+ */
+#define SXI_ACT		11
+#define SXI_ARG_LSB	0
+#define SXI_ARG_BITS	3
+
+#define SXI(a)		(ACT(SXI_ACT)|VALUE((a),SXI_ARG_BITS,SXI_ARG_LSB))
+
+#define SXI_ARG(w)	EXTRACT((w),SXI_ARG_BITS,SXI_ARG_LSB)
+
+/*
+ *	TEst Register (Action 13)
  *
  *	Check that the argument specified is, (or is not) a specified
  *	register.
@@ -767,16 +837,22 @@ typedef struct _opcode {
  */
 extern opcode *find_opcode( modifier mods, component op, int args, ea_breakdown *format );
 
+/*
+ *	Continue the search from the definition given, returning
+ *	the next which also matches (or NIL if there are no more).
+ */
+extern opcode *next_opcode( opcode *last, modifier mods, component op, int args, ea_breakdown *format );
+
 
 
 /************************************************************************
 ************************************************************************/
 
-#ifdef VERIFICATION
+#if defined( VERIFICATION )||defined( EXECUTION )
 
 /*
- *	If the VERIFICATION macro has been defined then we will
- *	allow direct access to the opcode data.
+ *	If the VERIFICATION (or EXECUTION) macro has been defined
+ *	then we will allow direct access to the opcode data.
  */
 extern opcode opcodes[];
 	
@@ -29,10 +29,30 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <ctype.h>
 #include <string.h>
+#include <errno.h>
 #include <malloc.h>
 #include <alloca.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
 
 #endif
 
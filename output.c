@@ -28,25 +28,16 @@
 #include "includes.h"
 
 /*
- *	We will default to the testing API for the moment so that
- *	the output remains clearly available.
+ *	The output selection is held in the assembler
+ *	context (see output.h).
  *
  *	TODO: Sort out the output selection and file open/close
  *	code.
  */
-static output_api *target_api = NIL( output_api );
-
-/*
- *	The file handle where the output is being directed.
- */
-static FILE *target_file = NIL( FILE );
-
-/*
- *	Flag that controls the output of the binary
- *	files as either raw binary data or cooked ASCII
- *	hexadecimal data dump.
- */
-static boolean target_hex = FALSE;
+#define target_api		(this_context->output.target_api)
+#define target_file		(this_context->output.target_file)
+#define target_hex		(this_context->output.target_hex)
+#define target_writer		(this_context->output.target_writer)
 
 
 /*
@@ -71,32 +62,62 @@ void initialise_output( output_api *api, boolean hex ) {
 
 boolean open_file( char *name ) {
 
-	ASSERT( target_api != NIL( output_api ));
 	ASSERT( target_file == NIL( FILE ));
 
-	return( FUNC( target_api->open_file )( &target_file, target_hex, name ));
+	/*
+	 *	No target API is valid; this is a listing only
+	 *	assembly and the output will go nowhere.
+	 */
+	if( target_api == NIL( output_api )) return( TRUE );
+	if( !FUNC( target_api->open_file )( &target_file, target_hex, name )) return( FALSE );
+	/*
+	 *	Optionally pass the output to a thread of its own.
+	 */
+	if( BOOL( command_flags & pipeline_stages )) target_writer = start_writer( target_api, target_file, target_hex );
+	return( TRUE );
 }
 
 boolean close_file( void ) {
+	boolean	ret;
+
+	if( target_api == NIL( output_api )) return( TRUE );
 
-	ASSERT( target_api != NIL( output_api ));
 	ASSERT( target_file != NIL( FILE ));
 	
-	return( FUNC( target_api->close_file )( target_file, target_hex ));
+	ret = TRUE;
+	if( target_writer ) {
+		ret = stop_writer( target_writer );
+		target_writer = NIL( output_writer );
+	}
+	if( !FUNC( target_api->close_file )( target_file, target_hex )) ret = FALSE;
+	if( fclose( target_file )) ret = FALSE;
+	target_file = NIL( FILE );
+	return( ret );
 }
 
 boolean output_data( byte *data, int len ) {
 	boolean	ret;
 	
-	ASSERT( target_api != NIL( output_api ));
-	ASSERT( target_file != NIL( FILE ));
-	
 	ASSERT( this_segment != NIL( segment_record ));
 	ASSERT( data != NIL( byte ));
 	ASSERT( len >= 0 );
 
-	ret = ( this_segment == codegen_segment )? FUNC( target_api->output_data )( target_file, target_hex, data, len ): TRUE;
-	
+	ret = TRUE;
+	if( this_segment == codegen_segment ) {
+		pass_stats.bytes += len;
+		listing_data( data, len );
+		if( target_api ) {
+
+			ASSERT( target_file != NIL( FILE ));
+
+			if( target_writer ) {
+				write_piped_data( target_writer, data, len );
+			}
+			else {
+				ret = FUNC( target_api->output_data )( target_file, target_hex, data, len );
+			}
+		}
+	}
 	this_segment->posn += len;
 	return( ret );
 }
@@ -104,18 +125,70 @@ boolean output_data( byte *data, int len ) {
 boolean output_space( int count ) {
 	boolean	ret;
 	
-	ASSERT( target_api != NIL( output_api ));
-	ASSERT( target_file != NIL( FILE ));
-	
 	ASSERT( this_segment != NIL( segment_record ));
 	ASSERT( count >= 0 );
 
-	ret = ( this_segment == codegen_segment )? FUNC( target_api->output_space )( target_file, target_hex, count ): TRUE;
-	
+	ret = TRUE;
+	if( this_segment == codegen_segment ) {
+		pass_stats.bytes += count;
+		listing_space( count );
+		if( target_api ) {
+
+			ASSERT( target_file != NIL( FILE ));
+
+			if( target_writer ) {
+				write_piped_space( target_writer, count );
+			}
+			else {
+				ret = FUNC( target_api->output_space )( target_file, target_hex, count );
+			}
+		}
+	}
 	this_segment->posn += count;
 	return( ret );
 }
 
+/*
+ *	Abandon any output in progress and deselect the
+ *	output API.
+ */
+void release_output( void ) {
+	if( target_writer ) (void)stop_writer( target_writer );
+	target_writer = NIL( output_writer );
+	if( target_file != NIL( FILE )) fclose( target_file );
+	target_file = NIL( FILE );
+	target_api = NIL( output_api );
+	target_hex = FALSE;
+}
+
+/*
+ *	Return the file extension of the selected output.
+ */
+char *output_extension( void ) {
+	if( target_api == NIL( output_api )) return( NIL( char ));
+	return( target_api->extension );
+}
+
+/*
+ *	Open an additional output file named after the source file
+ *	with its extension replaced by the one supplied (which
+ *	includes the leading period).
+ */
+FILE *open_output_file( char *name, char *ext, char *mode ) {
+	char	*s, *t;
+	FILE	*f;
+
+	ASSERT( name != NIL( char ));
+	ASSERT( ext != NIL( char ));
+
+	s = strcpy( STACK_ARRAY( char, strlen( name ) + strlen( ext ) + 1 ), name );
+	if(( t = strrchr( s, PERIOD ))) *t = EOS;
+	strcat( s, ext );
+
+	if(( f = fopen( s, mode )) == NIL( FILE )) log_error_s( "Failed to open file for write", s );
+	return( f );
+}
+
 
 /*
  *	EOF
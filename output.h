@@ -37,8 +37,19 @@ typedef struct {
 	boolean	FUNC( close_file )( FILE *file, boolean hex );
 	boolean	FUNC( output_data )( FILE *file, boolean hex, byte *data, int len );
 	boolean	FUNC( output_space )( FILE *file, boolean hex, int count );
+	char	*extension;
 } output_api;
 
+/*
+ *	The output selection held in the assembler context.
+ */
+typedef struct {
+	output_api	*target_api;		/* The output selected */
+	FILE		*target_file;		/* Where the output is being directed */
+	boolean		target_hex;		/* Output binary files as ASCII hexadecimal */
+	struct _output_writer	*target_writer;	/* Pipeline writer, see pipeline.h */
+} output_context;
+
 /*
  *	Generic Output API
  *	==================
@@ -61,6 +72,25 @@ extern boolean close_file( void );
 extern boolean output_data( byte *data, int len );
 extern boolean output_space( int count );
 
+/*
+ *	Abandon any output in progress and deselect the
+ *	output API.
+ */
+extern void release_output( void );
+
+/*
+ *	Return the file extension of the selected output, or
+ *	NIL if no output has been selected.
+ */
+extern char *output_extension( void );
+
+/*
+ *	Open an additional output file named after the source file
+ *	with its extension replaced by the one supplied (which
+ *	includes the leading period).
+ */
+extern FILE *open_output_file( char *name, char *ext, char *mode );
+
 
 
 
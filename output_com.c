@@ -98,7 +98,7 @@ static boolean com_api_output_space( FILE *file, boolean hex, int count ) {
  *	This is the external presentation of this API
  */
 output_api com_output_api = {
-	com_api_openfile, com_api_closefile, com_api_output_data, com_api_output_space
+	com_api_openfile, com_api_closefile, com_api_output_data, com_api_output_space, ".com"
 };
 
 
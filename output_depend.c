@@ -0,0 +1,68 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	output_depend
+ *	=============
+ *
+ *	Generation of a make style dependency file.  The file
+ *	contains a single rule naming the primary output of the
+ *	assembly as the target and every file opened while it was
+ *	assembled as a prerequisite:
+ *
+ *		name.com: name.asm file.inc ...
+ *
+ *	which is acceptable to both make and ninja.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	Write the '.d' file for the source file named.
+ */
+boolean write_depend( char *name ) {
+	FILE	*to;
+	char	*ext,
+		*s, *t;
+	boolean	ret;
+
+	ASSERT( name != NIL( char ));
+
+	/*
+	 *	The target is the binary output, or (where none has
+	 *	been selected) the listing or map file.
+	 */
+	if(( ext = output_extension()) == NIL( char )) ext = BOOL( command_flags & generate_listing )? ".lst": ".map";
+	s = strcpy( STACK_ARRAY( char, strlen( name ) + strlen( ext ) + 1 ), name );
+	if(( t = strrchr( s, PERIOD ))) *t = EOS;
+	strcat( s, ext );
+
+	if(( to = open_output_file( name, ".d", "w" )) == NIL( FILE )) return( FALSE );
+	fprintf( to, "%s:", s );
+	ret = write_dependencies( to );
+	fprintf( to, "\n" );
+	if( ferror( to )) ret = FALSE;
+	if( fclose( to )) ret = FALSE;
+	return( ret );
+}
+
+
+/*
+ *	EOF
+ */
@@ -20,56 +20,301 @@
  *	output_listing
  *	==============
  *
- *	An output format for listing purposes.
+ *	Generation of the assembly listing file.  This runs alongside
+ *	whichever output format has been selected, capturing the bytes
+ *	generated by each source line during the code generation passes
+ *	and interleaving them with the source text.
+ *
+ *	As the code generation passes are performed once per segment
+ *	(in memory order) the listing presents the source one segment
+ *	at a time, in the order the segments will appear in memory.
+ *
+ *	With '--clocks' the estimated clocks for each instruction are
+ *	shown ahead of the line number and the total for each block
+ *	of code following a label is given after the block.
  */
  
+#define MEMORY_TAG	memory_output
+
 #include "os.h"
 #include "includes.h"
 
+/*
+ *	Space which must be available in the buffer before a
+ *	single line of the listing is formatted into it.
+ */
+#define LISTING_ROW_SPACE	(MAX_LINE_SIZE+HEX_DUMP_COLS+64)
 
 /*
- *	Listing Output API
- * 	==================
+ *	The listing state is held in the assembler context
+ *	(see output_listing.h).
  */
-static boolean listing_api_openfile( FILE **file, boolean hex, char *name ) {
-	return( TRUE );
+#define listing_file		(this_context->listing.listing_file)
+#define listing_buffer		(this_context->listing.listing_buffer)
+#define listing_used		(this_context->listing.listing_used)
+#define line_active		(this_context->listing.line_active)
+#define line_shown		(this_context->listing.line_shown)
+#define line_text		(this_context->listing.line_text)
+#define line_name		(this_context->listing.line_name)
+#define last_name		(this_context->listing.last_name)
+#define line_number		(this_context->listing.line_number)
+#define row_data		(this_context->listing.row_data)
+#define row_count		(this_context->listing.row_count)
+#define row_posn		(this_context->listing.row_posn)
+#define lead_segment		(this_context->listing.lead_segment)
+#define line_clocks		(this_context->listing.line_clocks)
+#define block_name		(this_context->listing.block_name)
+#define block_clocks		(this_context->listing.block_clocks)
+#define block_open_ended	(this_context->listing.block_open_ended)
+#define block_segment		(this_context->listing.block_segment)
+#define line_note		(this_context->listing.line_note)
+
+/*
+ *	Write out the buffered listing text.
+ */
+static boolean flush_listing( void ) {
+	boolean	ret;
+
+	ASSERT( listing_file != NIL( FILE ));
+
+	ret = TRUE;
+	if( listing_used ) {
+		if( fwrite( listing_buffer, 1, listing_used, listing_file ) != (size_t)listing_used ) {
+			log_error( "Failed to write listing file" );
+			ret = FALSE;
+		}
+		listing_used = 0;
+	}
+	return( ret );
 }
 
-static boolean listing_api_closefile( FILE *file, boolean hex ) {
-	return( TRUE );
+/*
+ *	Return the address in the buffer where the next line
+ *	of the listing can be placed.
+ */
+static char *listing_space_for_row( void ) {
+	if(( LISTING_BUFFER_SIZE - listing_used ) < LISTING_ROW_SPACE ) (void)flush_listing();
+	return( listing_buffer + listing_used );
+}
+
+/*
+ *	Output a single row of the listing.  The address is
+ *	only shown if posn is not ERROR and the source text
+ *	is appended if it has not been shown already.
+ */
+static void list_row( integer posn, char *bytes ) {
+	char	*buf;
+	int	len;
+
+	buf = listing_space_for_row();
+	if(( last_name == NIL( char ))||( strcmp( line_name, last_name ) != 0 )) {
+		listing_used += sprintf( buf, "%*s; %.*s\n", HEX_DUMP_COLS+10, "", MAX_LINE_SIZE, line_name );
+		buf = listing_space_for_row();
+		last_name = line_name;
+	}
+	if(( posn != ERROR )&&( this_segment != NIL( segment_record ))) {
+		len = sprintf( buf, "%04X:%04X ", (unsigned int)( this_segment->group? this_segment->group->page: 0 ), (unsigned int)( posn & 0xFFFF ));
+	}
+	else {
+		len = sprintf( buf, "%10s", "" );
+	}
+	if( line_shown ) {
+		len += sprintf( buf+len, "%s\n", bytes );
+	}
+	else {
+		int	l;
+
+		for( l = strlen( line_text ); ( l > 0 )&&(( line_text[ l-1 ] == NL )||( line_text[ l-1 ] == '\r' )); l-- );
+		if( BOOL( command_flags & list_clocks )) {
+			len += sprintf( buf+len, "%-*s%*s%5d  %.*s\n", HEX_DUMP_COLS, bytes, LISTING_CLOCK_COLS, line_clocks, line_number, l, line_text );
+		}
+		else {
+			len += sprintf( buf+len, "%-*s%5d  %.*s\n", HEX_DUMP_COLS, bytes, line_number, l, line_text );
+		}
+		line_shown = TRUE;
+	}
+	listing_used += len;
+}
+
+/*
+ *	Output any bytes gathered in the current row.
+ */
+static void flush_row( void ) {
+	char	bytes[ HEX_DUMP_COLS+1 ];
+	int	i;
+
+	if( row_count == 0 ) return;
+	for( i = 0; i < row_count; i++ ) sprintf( bytes+( i*3 ), "%02X ", row_data[ i ]);
+	list_row( row_posn, bytes );
+	row_count = 0;
+}
+
+/*
+ *	Output a run of identical bytes as a single row.
+ */
+static void list_repeat( integer posn, int count, byte value ) {
+	char	bytes[ MAX_CONST_SIZE+16 ];
+
+	flush_row();
+	sprintf( bytes, "%04Xh DUP(%02X)", (unsigned int)count, (unsigned int)value );
+	list_row( posn, bytes );
+}
+
+/*
+ *	Output the total for the block of code being closed.
+ */
+static void flush_block( void ) {
+	char	*buf;
+
+	if(( block_name != NIL( char ))&&( block_clocks > 0 )) {
+		buf = listing_space_for_row();
+		listing_used += sprintf( buf, "%*s; %.*s: %ld%s clocks\n", HEX_DUMP_COLS+10, "", MAX_LINE_SIZE, block_name, block_clocks, block_open_ended? "+": "" );
+	}
+	block_name = NIL( char );
+	block_clocks = 0;
+	block_open_ended = FALSE;
 }
 
-static boolean listing_api_output_data( FILE *file, boolean hex, byte *data, int len ) {
-	printf( "%04x", this_segment->posn );
-	while( len-- ) printf( " %02x", (unsigned int)( *data++ ));
-	printf( "\n" );
+/*
+ *	Open/close the listing file.
+ */
+boolean open_listing( char *name ) {
+
+	ASSERT( listing_file == NIL( FILE ));
+
+	if(( listing_file = open_output_file( name, ".lst", "w" )) == NIL( FILE )) return( FALSE );
+	listing_buffer = NEW_ARRAY( char, LISTING_BUFFER_SIZE );
+	listing_used = 0;
+	last_name = NIL( char );
+	lead_segment = NIL( segment_record );
+	block_name = NIL( char );
+	block_clocks = 0;
+	block_open_ended = FALSE;
+	block_segment = NIL( segment_record );
 	return( TRUE );
 }
 
-static boolean listing_api_output_space( FILE *file, boolean hex, int count ) {
-	if( count > 0 ) {
-		word	here;
-		int	i;
-
-		here = this_segment->posn;
-		for( i = 0; i < count; i++ ) {
-			if( !BOOL( i & 0x000f )) {
-				if( i ) printf( "\n" );
-				printf( "%04x", here );
-			}
-			here++;
-			printf( " 00" );
+boolean close_listing( void ) {
+	boolean	ret;
+
+	if( listing_file == NIL( FILE )) return( TRUE );
+	flush_block();
+	ret = flush_listing();
+	if( fclose( listing_file )) ret = FALSE;
+	FREE( listing_buffer );
+	listing_file = NIL( FILE );
+	listing_buffer = NIL( char );
+	return( ret );
+}
+
+/*
+ *	Mark the start and end of a source line.  Only lines
+ *	read during the code generation passes are listed.
+ */
+void listing_start_line( void ) {
+	if(( listing_file == NIL( FILE ))||( this_pass != pass_code_generation )) {
+		line_active = FALSE;
+		return;
+	}
+	if( lead_segment == NIL( segment_record )) lead_segment = codegen_segment;
+	/*
+	 *	A block of code ends with its segment.
+	 */
+	if( block_segment != codegen_segment ) {
+		flush_block();
+		block_segment = codegen_segment;
+	}
+	line_text = current_line( &line_name, &line_number );
+	line_active = TRUE;
+	line_shown = FALSE;
+	line_clocks[ 0 ] = EOS;
+	line_note[ 0 ] = EOS;
+	row_count = 0;
+}
+
+void listing_end_line( void ) {
+	if( !line_active ) return;
+	flush_row();
+	/*
+	 *	Lines which generated nothing are listed against the
+	 *	segment they leave selected.
+	 */
+	if( !line_shown ) {
+		if( this_segment == codegen_segment ) {
+			list_row( this_segment->posn, "" );
+		}
+		else if(( this_segment == NIL( segment_record ))&&( codegen_segment == lead_segment )) {
+			list_row( ERROR, "" );
 		}
-		printf( "\n" );
 	}
-	return( TRUE );
+	if( line_note[ 0 ] != EOS ) {
+		char	*buf;
+
+		buf = listing_space_for_row();
+		listing_used += sprintf( buf, "%*s; %s\n", HEX_DUMP_COLS+10, "", line_note );
+	}
+	line_active = FALSE;
 }
 
+/*
+ *	Capture the data generated by the current line.  These are
+ *	called before the segment position is updated.
+ */
+void listing_data( byte *data, int len ) {
+	int	i;
+
+	if( !line_active ) return;
+	if( len >= LISTING_DUP_MINIMUM ) {
+		for( i = 1; ( i < len )&&( data[ i ] == data[ 0 ]); i++ );
+		if( i == len ) {
+			list_repeat( this_segment->posn, len, data[ 0 ]);
+			return;
+		}
+	}
+	for( i = 0; i < len; i++ ) {
+		if( row_count == 0 ) row_posn = this_segment->posn + i;
+		row_data[ row_count++ ] = data[ i ];
+		if( row_count == LISTING_ROW_BYTES ) flush_row();
+	}
+}
+
+void listing_space( int count ) {
+	static byte zero[ LISTING_DUP_MINIMUM ];
+
+	if( !line_active ) return;
+	if( count < LISTING_DUP_MINIMUM ) {
+		listing_data( zero, count );
+	}
+	else {
+		list_repeat( this_segment->posn, count, 0 );
+	}
+}
+
+/*
+ *	Clock estimates.
+ */
+void listing_clocks( char *text, int clocks, boolean open_ended ) {
+	if( !line_active ) return;
+	strncpy( line_clocks, text, LISTING_CLOCK_COLS-1 );
+	line_clocks[ LISTING_CLOCK_COLS-1 ] = EOS;
+	block_clocks += clocks;
+	if( open_ended ) block_open_ended = TRUE;
+}
 
+void listing_label( char *name ) {
+	if( !line_active || !BOOL( command_flags & list_clocks )||( this_segment != codegen_segment )) return;
+	flush_block();
+	block_name = name;
+}
 
-output_api listing_output_api = {
-	listing_api_openfile, listing_api_closefile, listing_api_output_data, listing_api_output_space
-};
+/*
+ *	Notes.
+ */
+void listing_note( char *text ) {
+	if( !line_active ||( this_segment != codegen_segment )) return;
+	strncpy( line_note, text, LISTING_NOTE_SIZE-1 );
+	line_note[ LISTING_NOTE_SIZE-1 ] = EOS;
+}
 
 
 /*
@@ -20,14 +20,107 @@
  *	output_listing
  *	==============
  *
- *	An output format for listing purposes.
+ *	Generation of the assembly listing file.
  */
  
 #ifndef _OUTPUT_LISTING_H_
 #define _OUTPUT_LISTING_H_
 
+/*
+ *	Number of bytes shown on each line of the listing.
+ */
+#define LISTING_ROW_BYTES	(HEX_DUMP_COLS/3)
 
-extern output_api listing_output_api;
+/*
+ *	Width of the clock estimate column (when selected).
+ */
+#define LISTING_CLOCK_COLS	10
+
+/*
+ *	Space for a note listed after the current line.
+ */
+#define LISTING_NOTE_SIZE	80
+
+/*
+ *	The listing state held in the assembler context.
+ */
+typedef struct {
+	/*
+	 *	The listing file and the buffer the text is gathered in.
+	 */
+	FILE		*listing_file;
+	char		*listing_buffer;
+	int		listing_used;
+	/*
+	 *	Details of the source line currently being listed.
+	 */
+	boolean		line_active,		/* Line is being listed */
+			line_shown;		/* Source text has been output */
+	char		*line_text,
+			*line_name,
+			*last_name;
+	int		line_number;
+	/*
+	 *	The row of bytes waiting to be output.
+	 */
+	byte		row_data[ LISTING_ROW_BYTES ];
+	int		row_count;
+	integer		row_posn;
+	/*
+	 *	The segment targeted by the first code generation pass.
+	 *	Lines outside of any segment are listed in that pass.
+	 */
+	segment_record	*lead_segment;
+	/*
+	 *	Clock estimates for the current line and the total for
+	 *	the block of code following the last label (open ended
+	 *	if any part depends on a count only known at run time).
+	 */
+	char		line_clocks[ LISTING_CLOCK_COLS ];
+	char		*block_name;
+	long		block_clocks;
+	boolean		block_open_ended;
+	segment_record	*block_segment;
+	/*
+	 *	Note on how the current line was assembled.
+	 */
+	char		line_note[ LISTING_NOTE_SIZE ];
+} listing_context;
+
+/*
+ *	Open/close the listing file.  The name supplied is that
+ *	of the source file, the listing takes the '.lst' extension.
+ */
+extern boolean open_listing( char *name );
+extern boolean close_listing( void );
+
+/*
+ *	Mark the start and end of a source line.  Only lines
+ *	read during the code generation passes are listed.
+ */
+extern void listing_start_line( void );
+extern void listing_end_line( void );
+
+/*
+ *	Capture the data generated by the current line.  These are
+ *	called before the segment position is updated.
+ */
+extern void listing_data( byte *data, int len );
+extern void listing_space( int count );
+
+/*
+ *	Record the clock estimate for the current line (as text)
+ *	adding the clocks to the current block, and start a new
+ *	block at the label named.
+ */
+extern void listing_clocks( char *text, int clocks, boolean open_ended );
+extern void listing_label( char *name );
+
+/*
+ *	Record a note, listed as a comment following the current
+ *	line, on how it was assembled.
+ */
+extern void listing_note( char *text );
 
 
 #endif
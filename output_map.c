@@ -0,0 +1,226 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	output_map
+ *	==========
+ *
+ *	Generation of the symbol map and cross reference files.
+ *
+ *	The definition and reference sites of each identifier are
+ *	gathered by the identifier system during the label gathering
+ *	pass.  Once assembly is complete the symbols are collected
+ *	into a flat array which is sorted (by address and then by
+ *	name) to produce the output.
+ */
+ 
+#define MEMORY_TAG	memory_output
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	Number of source references placed on each line of the
+ *	cross reference file.
+ */
+#define XREF_SITES_PER_LINE	4
+
+/*
+ *	Return the printable name of an identifier class.
+ */
+static char *class_name( id_class type ) {
+	switch( type ) {
+		case class_label:	return( "label" );
+		case class_const:	return( "const" );
+		case class_group:	return( "group" );
+		case class_segment:	return( "segment" );
+		default:		break;
+	}
+	return( "undefined" );
+}
+
+/*
+ *	Return the paragraph page for a segment.
+ */
+static integer segment_page( segment_record *seg ) {
+	if(( seg == NIL( segment_record ))||( seg->group == NIL( segment_group ))) return( 0 );
+	return( seg->group->page );
+}
+
+/*
+ *	Find the address of an identifier.  Returns FALSE if the
+ *	identifier has no position in memory.
+ */
+static boolean symbol_address( id_record *id, integer *page, integer *offset ) {
+	switch( id->type ) {
+		case class_label:
+		case class_const: {
+			constant_value	value;
+
+			get_label_value( id, &value );
+			if( value.segment == NIL( segment_record )) return( FALSE );
+			*page = segment_page( value.segment );
+			*offset = value.value;
+			return( TRUE );
+		}
+		case class_segment: {
+			*page = segment_page( label_segment( id ));
+			*offset = label_segment( id )->start;
+			return( TRUE );
+		}
+		default: {
+			break;
+		}
+	}
+	return( FALSE );
+}
+
+/*
+ *	The sorting comparison routines.
+ */
+static int compare_names( const void *a, const void *b ) {
+	id_record	*l = *(id_record **)a,
+			*r = *(id_record **)b;
+
+	if( BOOL( command_flags & ignore_label_case )) return( strcasecmp( l->id, r->id ));
+	return( strcmp( l->id, r->id ));
+}
+
+static int compare_addresses( const void *a, const void *b ) {
+	id_record	*l = *(id_record **)a,
+			*r = *(id_record **)b;
+	integer		lp, lo,
+			rp, ro;
+
+	/*
+	 *	Those without an address sort to the end.
+	 */
+	if( !symbol_address( l, &lp, &lo )) {
+		if( symbol_address( r, &rp, &ro )) return( 1 );
+		return( compare_names( a, b ));
+	}
+	if( !symbol_address( r, &rp, &ro )) return( -1 );
+	if( lp != rp ) return(( lp < rp )? -1: 1 );
+	if( lo != ro ) return(( lo < ro )? -1: 1 );
+	return( compare_names( a, b ));
+}
+
+/*
+ *	Output a single symbol entry in the map.
+ */
+static void map_symbol( FILE *to, id_record *id ) {
+	integer	page, offset;
+
+	if( symbol_address( id, &page, &offset )) {
+		fprintf( to, "\t%04X:%04X  %-8s %s\n", (unsigned int)page, (unsigned int)( offset & 0xFFFF ), class_name( id->type ), id->id );
+	}
+	else if( id->type == class_const ) {
+		constant_value	value;
+
+		get_label_value( id, &value );
+		fprintf( to, "\t     %04X  %-8s %s\n", (unsigned int)( value.value & 0xFFFF ), class_name( id->type ), id->id );
+	}
+	else {
+		fprintf( to, "\t           %-8s %s\n", class_name( id->type ), id->id );
+	}
+}
+
+/*
+ *	Write the map file.  The list supplied is re-sorted
+ *	by this routine.
+ */
+static boolean write_map_file( char *name, id_record **list, int count ) {
+	FILE		*to;
+	segment_group	*grp;
+	segment_record	*seg;
+	boolean		ret;
+	int		i;
+
+	if(( to = open_output_file( name, ".map", "w" )) == NIL( FILE )) return( FALSE );
+	fprintf( to, "Symbol map of '%s'\n\n", name );
+	fprintf( to, "Segments:\n" );
+	for( grp = all_groups; grp; grp = grp->next ) {
+		for( seg = grp->segments; seg; seg = seg->next ) {
+			fprintf( to, "\t%04X:%04X  %04X  %-12s (%s)\n", (unsigned int)grp->page, (unsigned int)seg->start, (unsigned int)seg->size, seg->name, grp->name );
+		}
+	}
+	for( seg = loose_segments; seg; seg = seg->next ) {
+		fprintf( to, "\t%04X:%04X  %04X  %s\n", 0, (unsigned int)seg->start, (unsigned int)seg->size, seg->name );
+	}
+	qsort( list, count, sizeof( id_record * ), compare_addresses );
+	fprintf( to, "\nSymbols by address:\n" );
+	for( i = 0; i < count; i++ ) if( list[ i ]->type != class_unknown ) map_symbol( to, list[ i ]);
+	qsort( list, count, sizeof( id_record * ), compare_names );
+	fprintf( to, "\nSymbols by name:\n" );
+	for( i = 0; i < count; i++ ) if( list[ i ]->type != class_unknown ) map_symbol( to, list[ i ]);
+	ret = !ferror( to );
+	if( fclose( to )) ret = FALSE;
+	return( ret );
+}
+
+/*
+ *	Write the cross reference file.  This expects the list
+ *	to have been sorted by name.
+ */
+static boolean write_xref_file( char *name, id_record **list, int count ) {
+	FILE		*to;
+	id_site		*site;
+	boolean		ret;
+	int		i, n;
+
+	if(( to = open_output_file( name, ".xrf", "w" )) == NIL( FILE )) return( FALSE );
+	fprintf( to, "Cross reference of '%s' (definitions marked '#')\n\n", name );
+	for( i = 0; i < count; i++ ) {
+		fprintf( to, "%-24s %-9s", list[ i ]->id, class_name( list[ i ]->type ));
+		n = 0;
+		for( site = label_sites( list[ i ]); site; site = site->next ) {
+			if( n == XREF_SITES_PER_LINE ) {
+				fprintf( to, "\n%34s", "" );
+				n = 0;
+			}
+			fprintf( to, " %s:%d%s", site->file? site->file: "?", site->line, site->definition? "#": "" );
+			n++;
+		}
+		fprintf( to, "\n" );
+	}
+	ret = !ferror( to );
+	if( fclose( to )) ret = FALSE;
+	return( ret );
+}
+
+/*
+ *	Write the '.map' and '.xrf' files for the source file
+ *	named.
+ */
+boolean write_map( char *name ) {
+	id_record	**list;
+	int		count;
+	boolean		ret;
+
+	ASSERT( name != NIL( char ));
+
+	list = gather_labels( &count );
+	ret = write_map_file( name, list, count ) && write_xref_file( name, list, count );
+	FREE( list );
+	return( ret );
+}
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,127 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	output_memory
+ * 	=============
+ *
+ *	An output API which gathers the generated machine code
+ *	in memory through a memory stream.  The data is laid out
+ *	exactly as it would be in a '.COM' file.
+ */
+
+#define MEMORY_TAG	memory_output
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The memory being written into by the stream is
+ *	held in the assembler context (and is released with
+ *	free() as it is allocated by the stream).
+ */
+#define memory_data		(this_context->memory.memory_data)
+#define memory_size		(this_context->memory.memory_size)
+
+
+static boolean memory_api_openfile( FILE **file, boolean hex, char *name ) {
+
+	ASSERT( file != NIL( FILE * ));
+	ASSERT( *file == NIL( FILE ));
+
+	if( memory_data ) free( memory_data );
+	memory_data = NIL( char );
+	memory_size = 0;
+	if(( *file = open_memstream( &memory_data, &memory_size )) == NIL( FILE )) {
+		log_error_s( "Failed to open memory for write", name );
+		return( FALSE );
+	}
+	return( TRUE );
+}
+
+static boolean memory_api_closefile( FILE *file, boolean hex ) {
+	
+	ASSERT( file != NIL( FILE ));
+
+	return( TRUE );
+}
+
+static boolean memory_api_output_data( FILE *file, boolean hex, byte *data, int len ) {
+	
+	ASSERT( file != NIL( FILE ));
+	ASSERT( data != NIL( byte ));
+	ASSERT( len >= 0 );
+	
+	return( fwrite( data, 1, len, file ) == (size_t)len );
+}
+
+static boolean memory_api_output_space( FILE *file, boolean hex, int count ) {
+	
+	ASSERT( file != NIL( FILE ));
+	
+	while( count-- > 0 ) if( fputc( 0, file ) == EOF ) return( FALSE );
+	return( TRUE );
+}
+
+/*
+ *	Hand over the memory gathered.
+ */
+byte *memory_output_result( int *len ) {
+	byte	*data;
+
+	ASSERT( len != NIL( int ));
+
+#ifdef MEMORY_ACCOUNTING
+	/*
+	 *	The stream's memory does not come from NEW, so it is
+	 *	copied into memory which the caller can FREE.
+	 */
+	data = NIL( byte );
+	if( memory_data ) {
+		if(( data = NEW_ARRAY( byte, memory_size+1 ))) memcpy( data, memory_data, memory_size );
+		free( memory_data );
+	}
+#else
+	data = (byte *)memory_data;
+#endif
+	*len = memory_size;
+	memory_data = NIL( char );
+	memory_size = 0;
+	return( data );
+}
+
+/*
+ *	Release any memory gathered but not handed over.
+ */
+void release_memory_output( void ) {
+	if( memory_data ) free( memory_data );
+	memory_data = NIL( char );
+	memory_size = 0;
+}
+
+/*
+ *	This is the external presentation of this API
+ */
+output_api memory_output_api = {
+	memory_api_openfile, memory_api_closefile, memory_api_output_data, memory_api_output_space, ".bin"
+};
+
+
+/*
+ *	EOF
+ */
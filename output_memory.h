@@ -0,0 +1,60 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	output_memory
+ * 	=============
+ *
+ *	An output API which gathers the generated machine code
+ *	in memory.
+ */
+ 
+#ifndef _OUTPUT_MEMORY_H_
+#define _OUTPUT_MEMORY_H_
+
+/*
+ *	The memory being written into, held in the
+ *	assembler context.
+ */
+typedef struct {
+	char		*memory_data;
+	size_t		memory_size;
+} memory_context;
+
+
+extern output_api memory_output_api;
+
+/*
+ *	Once the output has been closed, hand over the memory
+ *	gathered to the caller (who becomes responsible for
+ *	releasing it).
+ */
+extern byte *memory_output_result( int *len );
+
+/*
+ *	Release any memory gathered but not handed over.
+ */
+extern void release_memory_output( void );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,369 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	pipeline
+ *	========
+ *
+ *	Running the reading (and tokenising) of source files and
+ *	the writing of output on threads of their own, connected
+ *	to the assembler by bounded single producer, single consumer
+ *	queues.
+ *
+ *	The assembler itself remains on one thread: labels are still
+ *	bound as each line is processed, so everything depending on
+ *	the order of the source is unchanged.  A line which fails to
+ *	tokenise on the reader is tokenised again by the assembler so
+ *	that errors are reported in order, and errors reported by the
+ *	writer are passed on when the output is closed.
+ */
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The Queue
+ *	=========
+ *
+ *	The head is only changed by the consumer and the tail only
+ *	by the producer; each reads the other with acquire ordering
+ *	so the record content is seen complete.
+ */
+
+/*
+ *	Wait for the other side of a queue.  A short spin is
+ *	followed by sleeping so a stalled pipeline is not left
+ *	burning a processor.
+ */
+static void queue_wait( int *tries ) {
+	if( ++( *tries ) < PIPELINE_SPIN ) {
+		sched_yield();
+	}
+	else {
+		usleep( PIPELINE_SLEEP );
+	}
+}
+
+/*
+ *	Create a queue for count records (rounded up to a power
+ *	of two) each of record bytes.
+ */
+void init_queue( spsc_queue *queue, int record, int count ) {
+	int	size;
+
+	for( size = 1; size < count; size <<= 1 );
+	queue->ring = NEW_ARRAY( byte, record * size );
+	queue->record = record;
+	queue->mask = size-1;
+	atomic_init( &( queue->head ), 0 );
+	atomic_init( &( queue->tail ), 0 );
+	atomic_init( &( queue->stop ), FALSE );
+}
+
+/*
+ *	Add a record, waiting for space.  Returns FALSE (without
+ *	adding the record) if the consumer has stopped.
+ */
+boolean push_queue( spsc_queue *queue, void *record ) {
+	unsigned int	tail;
+	int		tries;
+
+	tail = atomic_load_explicit( &( queue->tail ), memory_order_relaxed );
+	tries = 0;
+	while( tail - atomic_load_explicit( &( queue->head ), memory_order_acquire ) > (unsigned int)queue->mask ) {
+		if( atomic_load_explicit( &( queue->stop ), memory_order_relaxed )) return( FALSE );
+		queue_wait( &tries );
+	}
+	memcpy( queue->ring + ( tail & queue->mask ) * queue->record, record, queue->record );
+	atomic_store_explicit( &( queue->tail ), tail+1, memory_order_release );
+	return( TRUE );
+}
+
+/*
+ *	Remove a record if one is waiting.
+ */
+boolean poll_queue( spsc_queue *queue, void *record ) {
+	unsigned int	head;
+
+	head = atomic_load_explicit( &( queue->head ), memory_order_relaxed );
+	if( head == atomic_load_explicit( &( queue->tail ), memory_order_acquire )) return( FALSE );
+	memcpy( record, queue->ring + ( head & queue->mask ) * queue->record, queue->record );
+	atomic_store_explicit( &( queue->head ), head+1, memory_order_release );
+	return( TRUE );
+}
+
+/*
+ *	Remove a record, waiting for one to arrive.
+ */
+void pop_queue( spsc_queue *queue, void *record ) {
+	int	tries;
+
+	tries = 0;
+	while( !poll_queue( queue, record )) queue_wait( &tries );
+}
+
+/*
+ *	Release the space held by a queue.
+ */
+void release_queue( spsc_queue *queue ) {
+	FREE( queue->ring );
+	queue->ring = NIL( byte );
+}
+
+/*
+ *	The Reader
+ *	==========
+ */
+
+/*
+ *	Read and tokenise the lines of a file in a context of
+ *	its own.  Any errors are discarded.
+ */
+static void *reader_thread( void *data ) {
+	source_reader		*reader = (source_reader *)data;
+	assembler_context	*context;
+	char			buffer[ MAX_LINE_SIZE+1 ],
+				*discard;
+	size_t			size;
+	FILE			*errors;
+	piped_line		line;
+
+	context = new_context();
+	(void)select_context( context );
+	command_flags = reader->flags;
+	assembler_parameters = reader->parameters;
+	discard = NIL( char );
+	size = 0;
+	if(( errors = open_memstream( &discard, &size ))) set_error_stream( errors );
+	line.end = FALSE;
+	while( fgets( line.text, MAX_LINE_SIZE, reader->fd ) != NIL( char )) {
+		line.text[ MAX_LINE_SIZE-1 ] = EOS;
+		strcpy( buffer, line.text );
+		if( !( line.ok = tokenise_line( buffer, &( line.tokens ), &( reader->arena )))) {
+			delete_tokens( line.tokens );
+			line.tokens = NIL( token_record );
+		}
+		if( !push_queue( &( reader->queue ), &line )) {
+			delete_tokens( line.tokens );
+			break;
+		}
+	}
+	line.end = TRUE;
+	line.ok = FALSE;
+	line.tokens = NIL( token_record );
+	(void)push_queue( &( reader->queue ), &line );
+	delete_context( context );
+	if( errors ) fclose( errors );
+	if( discard ) free( discard );	/* From open_memstream() */
+	return( NIL( void ));
+}
+
+/*
+ *	Start reading a file.
+ */
+source_reader *start_reader( FILE *fd ) {
+	source_reader	*reader;
+
+	reader = NEW( source_reader );
+	reader->fd = fd;
+	memset( &( reader->arena ), 0, sizeof( token_arena ));
+	init_queue( &( reader->queue ), sizeof( piped_line ), PIPELINE_LINES );
+	reader->flags = command_flags;
+	reader->parameters = assembler_parameters;
+	reader->current.end = FALSE;
+	reader->current.ok = FALSE;
+	reader->current.tokens = NIL( token_record );
+	if( pthread_create( &( reader->thread ), NULL, reader_thread, reader ) != 0 ) {
+		release_queue( &( reader->queue ));
+		FREE( reader );
+		return( NIL( source_reader ));
+	}
+	return( reader );
+}
+
+/*
+ *	Return the next line read.
+ */
+boolean read_piped_line( source_reader *reader, char *buffer, int len ) {
+	delete_tokens( reader->current.tokens );
+	reader->current.tokens = NIL( token_record );
+	if( reader->current.end ) return( FALSE );
+	pop_queue( &( reader->queue ), &( reader->current ));
+	if( reader->current.end ) return( FALSE );
+	strncpy( buffer, reader->current.text, len );
+	buffer[ len-1 ] = EOS;
+	return( TRUE );
+}
+
+/*
+ *	Return the unbound tokens of the line most recently
+ *	returned, or NIL if it must be tokenised again.
+ */
+token_record *piped_tokens( source_reader *reader ) {
+	return( reader->current.ok? reader->current.tokens: NIL( token_record ));
+}
+
+/*
+ *	Stop reading a file.  The file itself is left open.
+ */
+void stop_reader( source_reader *reader ) {
+	piped_line		line;
+	arena_block_record	*look;
+
+	atomic_store( &( reader->queue.stop ), TRUE );
+	pthread_join( reader->thread, NULL );
+	delete_tokens( reader->current.tokens );
+	while( poll_queue( &( reader->queue ), &line )) delete_tokens( line.tokens );
+	release_queue( &( reader->queue ));
+	while(( look = reader->arena.blocks )) {
+		reader->arena.blocks = look->next;
+		FREE( look->data );
+		FREE( look );
+	}
+	FREE( reader );
+}
+
+/*
+ *	The Writer
+ *	==========
+ */
+
+/*
+ *	Pass the output blocks to the output API until the end
+ *	of the output is seen.
+ */
+static void *writer_thread( void *data ) {
+	output_writer		*writer = (output_writer *)data;
+	assembler_context	*context;
+	FILE			*errors;
+	piped_output		block;
+
+	context = new_context();
+	(void)select_context( context );
+	if(( errors = open_memstream( &( writer->diagnostics ), &( writer->size )))) set_error_stream( errors );
+	while( TRUE ) {
+		pop_queue( &( writer->queue ), &block );
+		if( block.len < 0 ) break;
+		if( block.space ) {
+			if( !FUNC( writer->api->output_space )( writer->file, writer->hex, block.len )) writer->ok = FALSE;
+		}
+		else {
+			if( !FUNC( writer->api->output_data )( writer->file, writer->hex, block.data, block.len )) writer->ok = FALSE;
+		}
+	}
+	delete_context( context );
+	if( errors ) fclose( errors );
+	return( NIL( void ));
+}
+
+/*
+ *	Start writing output.
+ */
+output_writer *start_writer( output_api *api, FILE *file, boolean hex ) {
+	output_writer	*writer;
+
+	writer = NEW( output_writer );
+	writer->api = api;
+	writer->file = file;
+	writer->hex = hex;
+	writer->ok = TRUE;
+	writer->diagnostics = NIL( char );
+	writer->size = 0;
+	writer->pending.space = FALSE;
+	writer->pending.len = 0;
+	init_queue( &( writer->queue ), sizeof( piped_output ), PIPELINE_BLOCKS );
+	if( pthread_create( &( writer->thread ), NULL, writer_thread, writer ) != 0 ) {
+		release_queue( &( writer->queue ));
+		FREE( writer );
+		return( NIL( output_writer ));
+	}
+	return( writer );
+}
+
+/*
+ *	Pass the data gathered so far to the writer.
+ */
+static void flush_writer( output_writer *writer ) {
+	if( writer->pending.len > 0 ) {
+		(void)push_queue( &( writer->queue ), &( writer->pending ));
+		writer->pending.len = 0;
+	}
+}
+
+/*
+ *	Pass data to the writer, gathered into blocks.
+ */
+void write_piped_data( output_writer *writer, byte *data, int len ) {
+	int	l;
+
+	/*
+	 *	The layout of hexadecimal output follows the calls
+	 *	made, so each call is kept in blocks of its own.
+	 */
+	if( writer->hex ) flush_writer( writer );
+	while( len > 0 ) {
+		if(( l = PIPELINE_BLOCK_SIZE - writer->pending.len ) > len ) l = len;
+		memcpy( writer->pending.data + writer->pending.len, data, l );
+		writer->pending.len += l;
+		data += l;
+		len -= l;
+		if( writer->pending.len == PIPELINE_BLOCK_SIZE ) flush_writer( writer );
+	}
+	if( writer->hex ) flush_writer( writer );
+}
+
+/*
+ *	Pass space to the writer.
+ */
+void write_piped_space( output_writer *writer, int count ) {
+	piped_output	block;
+
+	if( count > 0 ) {
+		flush_writer( writer );
+		block.space = TRUE;
+		block.len = count;
+		(void)push_queue( &( writer->queue ), &block );
+	}
+}
+
+/*
+ *	Stop writing, waiting for all of the output to be written.
+ */
+boolean stop_writer( output_writer *writer ) {
+	piped_output	block;
+	boolean		ok;
+
+	flush_writer( writer );
+	block.space = FALSE;
+	block.len = -1;
+	(void)push_queue( &( writer->queue ), &block );
+	pthread_join( writer->thread, NULL );
+	release_queue( &( writer->queue ));
+	if( writer->diagnostics ) {
+		if( writer->size ) log_text( writer->diagnostics, writer->size );
+		free( writer->diagnostics );	/* From open_memstream() */
+	}
+	ok = writer->ok;
+	FREE( writer );
+	return( ok );
+}
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,128 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	pipeline
+ *	========
+ *
+ *	Running the reading (and tokenising) of source files and
+ *	the writing of output on threads of their own, connected
+ *	to the assembler by bounded single producer, single consumer
+ *	queues.
+ */
+
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+/*
+ *	A bounded queue of fixed size records with one thread
+ *	adding records and another removing them.  A full queue
+ *	holds up the producer and an empty queue the consumer.
+ */
+typedef struct {
+	byte			*ring;
+	int			record,
+				mask;
+	atomic_uint		head,		/* Next record to remove */
+				tail;		/* Next record to add */
+	atomic_bool		stop;		/* Consumer has given up */
+} spsc_queue;
+
+extern void init_queue( spsc_queue *queue, int record, int count );
+extern boolean push_queue( spsc_queue *queue, void *record );
+extern void pop_queue( spsc_queue *queue, void *record );
+extern boolean poll_queue( spsc_queue *queue, void *record );
+extern void release_queue( spsc_queue *queue );
+
+/*
+ *	A line read (and tokenised, with labels unbound) from a
+ *	source file ahead of the assembler.
+ */
+typedef struct {
+	char			text[ MAX_LINE_SIZE+1 ];
+	boolean			end,		/* No more lines */
+				ok;		/* Tokenised without error */
+	token_record		*tokens;
+} piped_line;
+
+/*
+ *	The reader of a single source file.
+ */
+typedef struct _source_reader {
+	FILE			*fd;
+	spsc_queue		queue;
+	token_arena		arena;
+	pthread_t		thread;
+	command_flag		flags;
+	mnemonic_flags		parameters;
+	piped_line		current;
+} source_reader;
+
+/*
+ *	Start reading lines from an open source file on a thread
+ *	of its own (NIL if the thread cannot be started), return
+ *	the next line (FALSE at the end of the file) and stop the
+ *	thread (releasing everything not yet read).
+ */
+extern source_reader *start_reader( FILE *fd );
+extern boolean read_piped_line( source_reader *reader, char *buffer, int len );
+extern token_record *piped_tokens( source_reader *reader );
+extern void stop_reader( source_reader *reader );
+
+/*
+ *	A block of output passed to the writer.
+ */
+typedef struct {
+	int			len;		/* -1 marks the end of output */
+	boolean			space;
+	byte			data[ PIPELINE_BLOCK_SIZE ];
+} piped_output;
+
+/*
+ *	The writer of an output file.
+ */
+typedef struct _output_writer {
+	output_api		*api;
+	FILE			*file;
+	boolean			hex,
+				ok;
+	spsc_queue		queue;
+	pthread_t		thread;
+	piped_output		pending;
+	char			*diagnostics;
+	size_t			size;
+} output_writer;
+
+/*
+ *	Start writing output through the API supplied on a thread
+ *	of its own (NIL if the thread cannot be started), pass data
+ *	(gathered into blocks) or space to it, and stop it returning FALSE if any of the
+ *	output failed.  Any errors the output API reported are then
+ *	passed on to the error stream of the calling thread.
+ */
+extern output_writer *start_writer( output_api *api, FILE *file, boolean hex );
+extern void write_piped_data( output_writer *writer, byte *data, int len );
+extern void write_piped_space( output_writer *writer, int count );
+extern boolean stop_writer( output_writer *writer );
+
+
+#endif
+
+/*
+ *	EOF
+ */
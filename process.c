@@ -178,202 +178,17 @@ static boolean process_tokens( token_record *list ) {
 		else {
 			r = TRUE;
 		}
-		return( process_opcode( prefs, mods, op_dir, args, arg, len ) && r );
-	}
-	return( process_directive( label, op_dir, args, arg, len ));
-}
-
-/*
- *	Handle the source code on a "per line" basis
- */
-static boolean process_line( char *ptr, token_record **tokens ) {
-	char		token[ MAX_TOKEN_SIZE+1 ];
-	int		l, t;
-	integer		value;
-	component	tok;
-	token_record	*head,
-			**tail,
-			*rec;
-	boolean		errors,
-			first;
+		if( BOOL( command_flags & report_convergence )&&( this_segment != NIL( segment_record ))) {
+			segment_record	*seg = this_segment;
+			integer		posn = seg->posn;
 
-	/*
-	 *	We loop along the input line taking off tokens
-	 *	one by one.
-	 */
-	errors = FALSE;
-	head = NIL( token_record );
-	tail = &head;
-	first = TRUE;
-	while( *ptr != EOS ) {
-		/*
-		 *	Drop any leading space characters
-		 */
-		while( isspace( *ptr )) ptr++;
-		/*
-		 *	Now we step through the generic classes of token
-		 *	to find what we have to deal with.
-		 */
-		if(( l = string_constant( QUOTE, ptr, token, MAX_TOKEN_SIZE, &t, &errors ))) {
-			/*
-			 *	A character constant, error if not just a single character.
-			 *
-			 *	Remember l is the number of source characters used; t is
-			 *	the actual number of data bytes place in the token area.
-			 *
-			 *	errors will be TRUE if errors were detected in the parsed
-			 *	string value.
-			 */
-			if( errors ) return( FALSE );
-			if( t != 1 ) {
-				log_error( "Invalid character constant size" );
-				return( FALSE );
-			}
-			/*
-			 *	Create record.
-			 */
-			rec = NEW( token_record );
-			rec->id = tok_immediate;
-			rec->var.constant.value = token[ 0 ];
-			rec->var.constant.scope = scope_ubyte;
-			rec->var.constant.segment = NIL( segment_record );
-			rec->next = NIL( token_record );
-			*tail = rec;
-			tail = &( rec->next );
-			/*
-			 *	Skip character token representation
-			 */
-			ptr += l;
-			first = FALSE;
-		}
-		else if(( l = string_constant( QUOTES, ptr, token, MAX_TOKEN_SIZE, &t, &errors ))) {
-			/*
-			 *	A string constant.  The length of the string
-			 *	(once parsed) is in t, and will be shorter than
-			 *	the return value l.
-			 */
-			if( errors ) return( FALSE );
-			rec = NEW( token_record );
-			rec->id = tok_string;
-			rec->var.block.len = t;
-			rec->var.block.ptr = save_block( (byte *)token, t );
-			rec->next = NIL( token_record );
-			*tail = rec;
-			tail = &( rec->next );
-			/*
-			 *	Skip string token representation
-			 */
-			ptr += l;
-			first = FALSE;
-		}
-		else if(( l = match_constant( ptr, &value, &errors ))) {
-			/*
-			 *	A numeric constant
-			 */
-			rec = NEW( token_record );
-			rec->id = tok_immediate;
-			rec->var.constant.value = value;
-			rec->var.constant.scope = get_scope( value );
-			rec->var.constant.segment = NIL( segment_record );
-			rec->next = NIL( token_record );
-			*tail = rec;
-			tail = &( rec->next );
-			/*
-			 *	Skip numeric token representation
-			 */
-			ptr += l;
-			first = FALSE;
-		}
-		else if(( l = match_identifier( ptr ))) {
-			/*
-			 *	An identifier but possibly a keyword
-			 */
-			t = find_best_keyword( ptr, &tok );
-			if( t == l ) {
-				/*
-				 *	Definitely a keyword of some sort.
-				 */
-				rec = NEW( token_record );
-				rec->id = tok;
-			}
-			else {
-				/*
-				 *	Just a label of some sort.
-				 */
-				if( l > MAX_TOKEN_SIZE ) {
-					strncpy( token, ptr, MAX_TOKEN_SIZE );
-					token[ MAX_TOKEN_SIZE ] = EOS;
-					log_error_s( "Identifier truncated to", token );
-					errors = TRUE;
-				}
-				else {
-					strncpy( token, ptr, l );
-					token[ l ] = EOS;
-				}
-				rec = NEW( token_record );
-				rec->id = tok_label;
-				rec->var.label = find_label( token, first );
-			}
-			rec->next = NIL( token_record );
-			*tail = rec;
-			tail = &( rec->next );
-			/*
-			 *	Skip numeric token representation
-			 */
-			ptr += l;
-			first = FALSE;
-		}
-		else if(( l = find_best_symbol( ptr, &tok ))) {
-			/*
-			 *	Definitely a symbol
-			 */
-			if( tok == tok_semicolon ) {
-				/*
-				 *	This is the start of a comment,
-				 *	so we artifically truncate the
-				 *	line here to force the logic to
-				 *	unroll normally.
-				 */
-				*ptr = EOS;
-			}
-			else {
-				/*
-				 *	Save the symbol as a token
-				 */
-				rec = NEW( token_record );
-				rec->id = tok;
-				rec->next = NIL( token_record );
-				*tail = rec;
-				tail = &( rec->next );
-				/*
-				 *	Skip numeric token representation
-				 */
-				ptr += l;
-				first = FALSE;
-			}
-		}
-		else if( *ptr != EOS ) {
-			/*
-			 *	Unrecognised token in data stream.
-			 */
-			log_error_c( "Unrecognised symbol", *ptr++ );
-			errors = TRUE;
-			first = FALSE;
+			r = process_opcode( prefs, mods, op_dir, args, arg, len ) && r;
+			if( this_segment == seg ) note_instruction_size( seg->posn - posn );
+			return( r );
 		}
+		return( process_opcode( prefs, mods, op_dir, args, arg, len ) && r );
 	}
-	/*
-	 *	Explicitly mark end of line.
-	 */
-	rec = NEW( token_record );
-	rec->id = end_of_line;
-	rec->next = NIL( token_record );
-	*tail = rec;
-	/*
-	 *	Return tokens and error condition (TRUE if line content
-	 *	parsed all correct).
-	 */
-	*tokens = head;
-	return( !errors );
+	return( process_directive( label, op_dir, args, arg, len ));
 }
 
 /*
@@ -395,7 +210,12 @@ boolean process_file( char *source ) {
 	 */
 	ret = TRUE;
 	while( next_line( buffer, MAX_LINE_SIZE )) {
-		if( process_line( buffer, &tokens )) {
+		listing_start_line();
+		pass_stats.lines++;
+		if( prepared_line( buffer, &tokens ) || tokenise_line( buffer, &tokens, NIL( token_arena ))) {
+			token_record	*look;
+
+			for( look = tokens; look; look = look->next ) pass_stats.tokens++;
 			if( !process_tokens( tokens )) {
 				log_error( "Interpretation error" );
 				ret = FALSE;
@@ -405,11 +225,39 @@ boolean process_file( char *source ) {
 			log_error( "Tokenisation error" );
 			ret = FALSE;
 		}
+		listing_end_line();
 		delete_tokens( tokens );
 	}
 	return( ret );
 }
 
+/*
+ *	Run all of the passes required to assemble a source
+ *	file, in the current context.  The passes are run until
+ *	the reset_state routine says we have done it enough; if
+ *	it stops because of an error the assembler will not have
+ *	returned to "no_pass".
+ */
+boolean assemble_file( char *source ) {
+	int	count;
+
+	count = 0;
+	while( reset_state()) {
+		count++;
+		if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Start PASS %d.\n", count );
+		start_pass_statistics();
+		if( BOOL( command_flags & report_convergence )) start_convergence_pass();
+		if( !process_file( source )) {
+			end_pass_statistics();
+			log_error( "Assembly terminated" );
+			return( FALSE );
+		}
+		end_pass_statistics();
+		if( BOOL( command_flags & be_verbose ) && ( this_pass == pass_value_confirmation )) dump_labels();
+	}
+	return( this_pass == no_pass );
+}
+
 /*
  *	EOF
  */
@@ -33,6 +33,11 @@
  */
 extern boolean process_file( char *source );
 
+/*
+ *	Run all of the passes required to assemble a source file.
+ */
+extern boolean assemble_file( char *source );
+
 #endif
 
 /*
@@ -0,0 +1,887 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	roundtrip
+ *	=========
+ *
+ *	Routines associated with the extended verification mode to
+ *	check that every form of every instruction survives being
+ *	assembled and then disassembled.
+ *
+ *	The forms of each table entry are those walked by the opcode
+ *	dump (see init_ea_state() and next_ea_state() in dump.c) with
+ *	the displacements, immediate values and segment overrides
+ *	chosen at random.  Forms the table itself will not encode are
+ *	dropped, the rest are written as lines of source, each with
+ *	a label of its own, and assembled ROUND_TRIP_BATCH at a time
+ *	through the usual passes (so through process_opcode()).  The
+ *	labels then show where each form's machine code is, and that
+ *	is decoded (see disassemble.c) and compared with the form.
+ *
+ *	A batch which does not assemble is split in two until the
+ *	form(s) at fault are found.  A failing form is then reduced
+ *	(dropping segment overrides and simplifying values for as
+ *	long as it still fails the same way) before it is reported.
+ *
+ *	Only the first failing form of each table entry is reported,
+ *	first being the order the forms are generated in (whichever
+ *	thread generates them), and the reports are written in the
+ *	order of the table once all of the threads have finished so
+ *	that a run with a given seed is repeatable.
+ */
+
+#include "os.h"
+#include "includes.h"
+
+#ifdef VERIFICATION
+
+/*
+ *	The forms assembled at a time, and the most text any one
+ *	line (or label) takes.
+ */
+#define ROUND_TRIP_BATCH	256
+#define ROUND_TRIP_LINE		128
+#define ROUND_TRIP_LABEL	16
+
+/*
+ *	Relative branches (and near addresses) are aimed at a form
+ *	at most this many lines away so a byte displacement fits.
+ */
+#define ROUND_TRIP_REACH	4
+
+/*
+ *	The address the forms are assembled from.
+ */
+#define ROUND_TRIP_ORIGIN	0x100
+
+/*
+ *	A single form of an instruction; an argument which is an
+ *	address (a relative branch target or a near or far immediate)
+ *	names the form it refers to by its distance in lines.
+ */
+typedef struct {
+	opcode		*op;
+	ea_breakdown	arg[ MAX_OPCODE_ARGS ];
+	boolean		address[ MAX_OPCODE_ARGS ];
+	int		target[ MAX_OPCODE_ARGS ];
+	int		item,			/* The entry (for a round) generating it */
+			seq;			/* and its place amongst that entry's forms */
+} rt_form;
+
+/*
+ *	The outcome of a form.
+ */
+typedef enum {
+	rt_verified,
+	rt_refused,			/* Encoded by the table, but did not assemble */
+	rt_mismatched			/* Did not decode to what was assembled */
+} rt_result;
+
+/*
+ *	What was found for a form which failed.
+ */
+typedef struct {
+	byte		code[ MAX_PREFIX_BYTES + MAX_CODE_BYTES ];
+	int		coded;
+	char		text[ ROUND_TRIP_LINE ];
+} rt_failure;
+
+/*
+ *	The report held for a table entry, from the first of its
+ *	forms to fail (item is -1 until then).
+ */
+typedef struct {
+	int		item,
+			seq;
+	char		*text;
+	size_t		len;
+} rt_report;
+
+/*
+ *	The state shared by the threads.
+ */
+typedef struct {
+	int		entries,
+			items;
+	atomic_int	next;
+	dword		seed;
+	mnemonic_flags	cpus;
+	command_flag	flags;
+	mnemonic_flags	parameters;
+	pthread_mutex_t	lock;
+	rt_report	*report;		/* Indexed by table entry */
+} rt_state;
+
+/*
+ *	Each thread's own details.
+ */
+typedef struct {
+	rt_state		*state;
+	dword			random;
+	FILE			*errors;
+	char			*discard;
+	size_t			discarded;
+	rt_form			*form;
+	int			forms,
+				item,			/* The entry being generated */
+				seq;			/* and the forms it has so far */
+	long			verified,
+				refused,
+				mismatched;
+} rt_worker;
+
+/*
+ *	The source text being assembled, as seen by the source
+ *	resolver.
+ */
+typedef struct {
+	char		*text;
+	int		len;
+} rt_source;
+
+/*
+ *	The name the source is assembled as.
+ */
+static char rt_name[] = "round-trip";
+
+/*
+ *	The segment registers indexed by their number.
+ */
+static component segment_name[ SEGMENT_REGISTERS ];
+
+/*
+ *	A simple (xorshift) random number generator, each thread
+ *	has its own, reseeded for each item of work so the forms
+ *	of an item do not depend on the thread doing it.
+ */
+static dword rt_random( rt_worker *w ) {
+	dword	x = w->random;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return( w->random = x );
+}
+
+/*
+ *	Mark the arguments of an entry which are addresses and
+ *	those which are escape values.
+ */
+static void classify_arguments( opcode *op, boolean *address, boolean *escape ) {
+	boolean	addressing;
+	word	e;
+	int	i;
+
+	for( i = 0; i < MAX_OPCODE_ARGS; i++ ) {
+		address[ i ] = FALSE;
+		escape[ i ] = FALSE;
+	}
+	addressing = FALSE;
+	for( i = 0; i < op->encoded; i++ ) {
+		e = op->encode[ i ];
+		switch( GET_ACT( e )) {
+			case FDS_ACT: {
+				if(( FDS_SIZE( e ) == DATA_SIZE_NEAR )||( FDS_SIZE( e ) == DATA_SIZE_FAR )) addressing = TRUE;
+				break;
+			}
+			case IMM_ACT: {
+				if( addressing && ( IMM_ARG( e ) < MAX_OPCODE_ARGS )) address[ IMM_ARG( e )] = TRUE;
+				break;
+			}
+			case REL_ACT: {
+				if( REL_ARG( e ) < MAX_OPCODE_ARGS ) address[ REL_ARG( e )] = TRUE;
+				break;
+			}
+			case ESC_ACT: {
+				if( ESC_ARG( e ) < MAX_OPCODE_ARGS ) escape[ ESC_ARG( e )] = TRUE;
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+}
+
+/*
+ *	Fill in the random parts of an example argument, returning
+ *	FALSE if the example is not wanted (the dump's examples of
+ *	immediate values are offered in byte, word and address
+ *	forms, only some of which make sense for each argument).
+ */
+static boolean randomise_argument( rt_worker *w, rt_form *f, int a, boolean escape ) {
+	ea_breakdown	*arg = &( f->arg[ a ]);
+	integer		v;
+
+	f->target[ a ] = 0;
+	/*
+	 *	A far address is itself a modifier, so cannot also
+	 *	be given a size.
+	 */
+	if( BOOL( arg->ea & ea_far_mod_reg_adrs )&&( arg->mod != no_modifier )) return( FALSE );
+	switch( arg->ea ) {
+		case ea_immediate:
+		case ea_far_immediate: {
+			if( f->address[ a ]) {
+				if( arg->immediate_arg.scope != scope_address ) return( FALSE );
+				f->target[ a ] = (int)( rt_random( w ) % ( 2 * ROUND_TRIP_REACH + 1 )) - ROUND_TRIP_REACH;
+				v = ROUND_TRIP_ORIGIN;
+				arg->immediate_arg.value = v;
+				arg->immediate_arg.scope = get_scope( v ) | scope_address;
+				return( TRUE );
+			}
+			if( arg->immediate_arg.scope == scope_byte_only ) {
+				v = rt_random( w ) & ( escape? 0x3F: 0x7F );
+			}
+			else if(( arg->immediate_arg.scope == scope_word_only )&& !escape ) {
+				v = 0x100 + rt_random( w ) % 0x7F00;
+			}
+			else {
+				return( FALSE );
+			}
+			arg->immediate_arg.value = v;
+			arg->immediate_arg.scope = get_scope( v );
+			return( TRUE );
+		}
+		case ea_indirect:
+		case ea_far_indirect: {
+			v = 1 + rt_random( w ) % 0xFFFF;
+			break;
+		}
+		case ea_base_disp:
+		case ea_far_base_disp:
+		case ea_index_disp:
+		case ea_far_index_disp:
+		case ea_base_index_disp:
+		case ea_far_base_index_disp: {
+			if( arg->immediate_arg.scope == scope_byte_only ) {
+				do {
+					v = (integer)( rt_random( w ) & 0xFF ) - 0x80;
+				} while( v == 0 );
+			}
+			else {
+				v = 0x80 + rt_random( w ) % 0x7F80;
+			}
+			break;
+		}
+		case ea_pointer_reg:
+		case ea_far_pointer_reg: {
+			v = 0;
+			break;
+		}
+		default: {
+			/*
+			 *	Registers are taken as they are.
+			 */
+			return( TRUE );
+		}
+	}
+	arg->immediate_arg.value = v;
+	arg->immediate_arg.scope = get_scope( v );
+	if(( rt_random( w ) & 3 ) == 0 ) arg->segment_override = rt_random( w ) % SEGMENT_REGISTERS;
+	return( TRUE );
+}
+
+/*
+ *	The line a form's address argument refers to, kept within
+ *	the forms being assembled.
+ */
+static int target_line( rt_form *f, int a, int n, int lo, int hi ) {
+	n += f->target[ a ];
+	if( n < lo ) n = lo;
+	if( n >= hi ) n = hi-1;
+	return( n );
+}
+
+/*
+ *	Write a form as a line of source.
+ */
+static void write_form( FILE *to, rt_form *form, int n, int lo, int hi ) {
+	rt_form		*f = &( form[ n ]);
+	component	mods[ MAXIMUM_MODIFIERS ], *m;
+	ea_breakdown	*arg;
+	integer		v;
+	int		a, r;
+
+	fprintf( to, "f%d:\t", n );
+	expand_modifier( f->op->mods, mods, MAXIMUM_MODIFIERS );
+	for( m = mods; *m != nothing; m++ ) fprintf( to, "%s ", component_text( *m ));
+	fprintf( to, "%s", component_text( f->op->op ));
+	for( a = 0; a < f->op->args; a++ ) {
+		arg = &( f->arg[ a ]);
+		fputc( a? ',': '\t', to );
+		expand_modifier( arg->mod, mods, MAXIMUM_MODIFIERS );
+		for( m = mods; *m != nothing; m++ ) fprintf( to, "%s ", component_text( *m ));
+		if( BOOL( arg->ea & ( ea_far_immediate | ea_far_mod_reg_adrs ))) fprintf( to, "far " );
+		v = arg->immediate_arg.value;
+		if( BOOL( arg->ea & ( ea_all_reg | ea_segment_reg ))) {
+			fprintf( to, "%s", component_text( arg->reg[ 0 ]->comp ));
+		}
+		else if( BOOL( arg->ea & ( ea_immediate | ea_far_immediate ))) {
+			if( f->address[ a ]) {
+				fprintf( to, "f%d", target_line( f, a, n, lo, hi ));
+			}
+			else {
+				fprintf( to, "0x%X", (unsigned int)v );
+			}
+		}
+		else {
+			fputc( '[', to );
+			if( arg->segment_override != UNKNOWN_SEG ) fprintf( to, "%s:", component_text( segment_name[ arg->segment_override ]));
+			for( r = 0; r < arg->registers; r++ ) fprintf( to, "%s%s", r? "+": "", component_text( arg->reg[ r ]->comp ));
+			if( arg->registers == 0 ) {
+				fprintf( to, "0x%X", (unsigned int)v );
+			}
+			else if( v < 0 ) {
+				fprintf( to, "-0x%X", (unsigned int)-v );
+			}
+			else if( v > 0 ) {
+				fprintf( to, "+0x%X", (unsigned int)v );
+			}
+			fputc( ']', to );
+		}
+	}
+	fputc( NL, to );
+}
+
+/*
+ *	Supply the source text being assembled.
+ */
+static boolean rt_resolver( char *name, void *data, char **text, int *len ) {
+	rt_source	*source = (rt_source *)data;
+
+	if( strcmp( name, rt_name ) != 0 ) return( FALSE );
+	*text = source->text;
+	*len = source->len;
+	return( TRUE );
+}
+
+/*
+ *	Assemble the forms lo to hi-1 in an assembler context of
+ *	their own, returning the machine code (to be released with
+ *	FREE) and the address of each form, or NIL if the forms
+ *	did not assemble.
+ */
+static byte *assemble_forms( rt_worker *w, rt_form *form, int lo, int hi, word *posn, int *size ) {
+	assembler_context	*context,
+				*previous;
+	rt_source		source;
+	size_t			len;
+	FILE			*to;
+	byte			*code;
+	boolean			ok;
+	int			n;
+
+	source.text = NIL( char );
+	len = 0;
+	if(( to = open_memstream( &( source.text ), &len )) == NIL( FILE )) return( NIL( byte ));
+	fprintf( to, "code\tsegment\tcs,\"code\"\nprog\tgroup\tcode\n\tsegment\tcode\n\torg\t%d\n", ROUND_TRIP_ORIGIN );
+	for( n = lo; n < hi; n++ ) write_form( to, form, n, lo, hi );
+	fclose( to );
+	source.len = (int)len;
+
+	context = new_context();
+	previous = select_context( context );
+	command_flags = w->state->flags;
+	assembler_parameters = w->state->parameters;
+	fseek( w->errors, 0, SEEK_SET );
+	set_error_stream( w->errors );
+	set_source_resolver( rt_resolver, &source );
+	initialise_output( &memory_output_api, FALSE );
+	code = NIL( byte );
+	*size = 0;
+	if( open_file( rt_name )) {
+		ok = assemble_file( rt_name );
+		if( !close_file()) ok = FALSE;
+		code = memory_output_result( size );
+		/*
+		 *	Find where each form was put.
+		 */
+		for( n = lo; ok && ( n < hi ); n++ ) {
+			char		label[ ROUND_TRIP_LABEL ];
+			id_record	*id;
+			constant_value	value;
+
+			sprintf( label, "f%d", n );
+			if((( id = find_label( label, FALSE )) == NIL( id_record ))||( id->type != class_label )) {
+				ok = FALSE;
+			}
+			else {
+				get_label_value( id, &value );
+				posn[ n ] = (word)value.value;
+			}
+		}
+		if( !ok && code ) {
+			FREE( code );
+			code = NIL( byte );
+		}
+	}
+	delete_context( context );
+	(void)select_context( previous );
+	free( source.text );		/* From open_memstream() */
+	return( code );
+}
+
+/*
+ *	Do two entries of the table produce the same instruction?
+ *	Entries for alternative mnemonics of one instruction have
+ *	the same encoding.
+ */
+static boolean same_instruction( opcode *a, opcode *b ) {
+	if(( a->op == b->op )&&( a->args == b->args )) return( TRUE );
+	return(( a->args == b->args )&&( a->encoded == b->encoded )&&( memcmp( a->encode, b->encode, a->encoded * sizeof( word )) == 0 ));
+}
+
+/*
+ *	Does a decoded argument match the form's, where an address
+ *	is expected to be that given?
+ */
+static boolean same_argument( ea_breakdown *want, boolean address, word expect, ea_breakdown *got ) {
+	int	r;
+
+	if( BOOL( want->ea & ( ea_all_reg | ea_segment_reg ))) {
+		return( BOOL( got->ea & ( ea_all_reg | ea_segment_reg ))&&( got->reg[ 0 ]->comp == want->reg[ 0 ]->comp ));
+	}
+	if( BOOL( want->ea & ( ea_immediate | ea_far_immediate ))) {
+		if( !BOOL( got->ea & ( ea_immediate | ea_far_immediate ))) return( FALSE );
+		return((word)got->immediate_arg.value == ( address? expect: (word)want->immediate_arg.value ));
+	}
+	if( !BOOL( got->ea & ( ea_mem_mod_adrs | ea_far_mod_reg_adrs ))) return( FALSE );
+	if( BOOL( want->ea & ea_far_mod_reg_adrs ) != BOOL( got->ea & ea_far_mod_reg_adrs )) return( FALSE );
+	if(( got->registers != want->registers )||( got->segment_override != want->segment_override )) return( FALSE );
+	for( r = 0; r < want->registers; r++ ) if( got->reg[ r ]->comp != want->reg[ r ]->comp ) return( FALSE );
+	return((word)got->immediate_arg.value == (word)want->immediate_arg.value );
+}
+
+/*
+ *	Decode the machine code of form n (of the forms lo to hi-1
+ *	assembled) and compare it with the form.
+ */
+static rt_result check_form( rt_form *form, int n, int lo, int hi, word *posn, byte *code, int size, rt_failure *fail ) {
+	rt_form		*f = &( form[ n ]);
+	decoded_inst	inst;
+	int		at,
+			len,
+			a;
+
+	at = posn[ n ] - ROUND_TRIP_ORIGIN;
+	len = (( n+1 < hi )? ( posn[ n+1 ] - ROUND_TRIP_ORIGIN ): size ) - at;
+	fail->coded = 0;
+	fail->text[ 0 ] = EOS;
+	if(( at < 0 )||( len <= 0 )||( at + len > size )) return( rt_mismatched );
+	fail->coded = ( len > MAX_PREFIX_BYTES + MAX_CODE_BYTES )? ( MAX_PREFIX_BYTES + MAX_CODE_BYTES ): len;
+	memcpy( fail->code, code + at, fail->coded );
+	if( decode_inst( code + at, len, posn[ n ], &inst ) != len ) return( rt_mismatched );
+	(void)format_inst( &inst, fail->text, ROUND_TRIP_LINE );
+	if( !same_instruction( f->op, inst.op )) return( rt_mismatched );
+	for( a = 0; a < f->op->args; a++ ) {
+		if( !same_argument( &( f->arg[ a ]), f->address[ a ], f->address[ a ]? posn[ target_line( f, a, n, lo, hi )]: 0, &( inst.arg[ a ]))) return( rt_mismatched );
+	}
+	return( rt_verified );
+}
+
+/*
+ *	Assemble and check a single form on its own.
+ */
+static rt_result try_form( rt_worker *w, rt_form *f, rt_failure *fail ) {
+	word		posn[ 1 ];
+	byte		*code;
+	rt_result	r;
+	int		size;
+
+	if(( code = assemble_forms( w, f, 0, 1, posn, &size )) == NIL( byte )) {
+		fail->coded = 0;
+		fail->text[ 0 ] = EOS;
+		return( rt_refused );
+	}
+	r = check_form( f, 0, 0, 1, posn, code, size, fail );
+	FREE( code );
+	return( r );
+}
+
+/*
+ *	Simplify part of a form: the segment override of, or the
+ *	value in, an argument.  Returns FALSE if there is nothing
+ *	to simplify.
+ */
+static boolean simplify_form( rt_form *f, int a, int how ) {
+	ea_breakdown	*arg = &( f->arg[ a ]);
+	integer		v;
+
+	if( BOOL( arg->ea & ( ea_all_reg | ea_segment_reg ))|| f->address[ a ]) return( FALSE );
+	if( how == 0 ) {
+		if( arg->segment_override == UNKNOWN_SEG ) return( FALSE );
+		arg->segment_override = UNKNOWN_SEG;
+		return( TRUE );
+	}
+	if( BOOL( arg->ea & ( ea_pointer_reg | ea_far_pointer_reg ))) return( FALSE );
+	v = BOOL( arg->immediate_arg.scope & scope_byte )? 1: 0x100;
+	if( arg->immediate_arg.value == v ) return( FALSE );
+	arg->immediate_arg.value = v;
+	arg->immediate_arg.scope = get_scope( v );
+	return( TRUE );
+}
+
+/*
+ *	Return TRUE if a form comes before the one reported (if
+ *	any) for its entry.  Called with the state locked.
+ */
+static boolean earlier_form( rt_report *report, rt_form *form ) {
+	if( report->item < 0 ) return( TRUE );
+	if( form->item != report->item ) return( form->item < report->item );
+	return( form->seq < report->seq );
+}
+
+/*
+ *	Report a failing form, once for each entry in the table,
+ *	having reduced it as far as possible.  The report is kept
+ *	(to be written once all the forms are done) unless one for
+ *	an earlier form of the entry is already held.
+ */
+static void report_form( rt_worker *w, rt_form *form, rt_result result, rt_failure *found ) {
+	rt_state	*state = w->state;
+	rt_report	*report;
+	rt_form		f,
+			trial;
+	rt_failure	fail;
+	char		*text;
+	size_t		len;
+	FILE		*to;
+	boolean		first;
+	int		a, how, i;
+
+	report = &( state->report[ form->op - opcodes ]);
+	pthread_mutex_lock( &( state->lock ));
+	first = earlier_form( report, form );
+	pthread_mutex_unlock( &( state->lock ));
+	if( !first ) return;
+	/*
+	 *	Reduce the form, keeping each change for which it
+	 *	still fails in the same way.
+	 */
+	f = *form;
+	for( i = 0; i < MAX_OPCODE_ARGS; i++ ) f.target[ i ] = 0;
+	if( try_form( w, &f, &fail ) == result ) {
+		*found = fail;
+		for( how = 0; how < 2; how++ ) {
+			for( a = 0; a < f.op->args; a++ ) {
+				trial = f;
+				if( simplify_form( &trial, a, how )&&( try_form( w, &trial, &fail ) == result )) {
+					f = trial;
+					*found = fail;
+				}
+			}
+		}
+	}
+	else {
+		f = *form;
+	}
+	/*
+	 *	Gather the report so it can be written in order.
+	 */
+	text = NIL( char );
+	len = 0;
+	if(( to = open_memstream( &text, &len )) == NIL( FILE )) return;
+	fprintf( to, "Round trip %s: ", ( result == rt_refused )? "refused": "mismatched" );
+	write_form( to, &f, 0, 0, 1 );
+	if( result == rt_mismatched ) {
+		fprintf( to, "\t;" );
+		for( i = 0; i < found->coded; i++ ) fprintf( to, " %02X", found->code[ i ]);
+		fprintf( to, " ->%s\n", ( found->text[ 0 ] != EOS )? found->text: " (not decoded)" );
+	}
+	fclose( to );
+	pthread_mutex_lock( &( state->lock ));
+	if( earlier_form( report, form )) {
+		if( report->text ) free( report->text );	/* From open_memstream() */
+		report->item = form->item;
+		report->seq = form->seq;
+		report->text = text;
+		report->len = len;
+		text = NIL( char );
+	}
+	pthread_mutex_unlock( &( state->lock ));
+	if( text ) free( text );		/* From open_memstream() */
+}
+
+/*
+ *	Assemble and check the forms lo to hi-1, splitting them
+ *	until those at fault are found if they do not assemble.
+ */
+static void run_forms( rt_worker *w, int lo, int hi ) {
+	word		posn[ ROUND_TRIP_BATCH ];
+	rt_failure	fail;
+	byte		*code;
+	int		size,
+			mid, n;
+
+	if(( code = assemble_forms( w, w->form, lo, hi, posn, &size )) == NIL( byte )) {
+		if( hi - lo == 1 ) {
+			w->refused++;
+			report_form( w, &( w->form[ lo ]), rt_refused, &fail );
+			return;
+		}
+		mid = ( lo + hi ) / 2;
+		run_forms( w, lo, mid );
+		run_forms( w, mid, hi );
+		return;
+	}
+	for( n = lo; n < hi; n++ ) {
+		if( check_form( w->form, n, lo, hi, posn, code, size, &fail ) == rt_verified ) {
+			w->verified++;
+		}
+		else {
+			w->mismatched++;
+			report_form( w, &( w->form[ n ]), rt_mismatched, &fail );
+		}
+	}
+	FREE( code );
+}
+
+/*
+ *	Add a form to the batch if the table encodes it, running
+ *	the batch once it is full.
+ */
+static void add_form( rt_worker *w, rt_form *f ) {
+	instruction	mc;
+	opcode		*found;
+	int		a, m;
+
+	/*
+	 *	A memory argument without a size leaves the size of
+	 *	an immediate argument undecided, which the assembler
+	 *	refuses before ever reaching the encoding.
+	 */
+	for( m = a = 0; a < f->op->args; a++ ) {
+		if( BOOL( f->arg[ a ].ea & ea_mem_mod_adrs )&&( f->arg[ a ].mod == no_modifier )) m |= 1;
+		if( BOOL( f->arg[ a ].ea & ea_immediate )) m |= 2;
+	}
+	if( m == 3 ) return;
+	f->item = w->item;
+	f->seq = w->seq++;
+	if(( found = find_opcode( f->op->mods, f->op->op, f->op->args, f->arg )) == NIL( opcode )) return;
+	if( !assemble_inst( found, no_prefix, f->arg, &mc )) return;
+	/*
+	 *	Values too large for the data size are for the
+	 *	assembler to refuse (which it is not checked for
+	 *	in the data verification pass).
+	 */
+	if( mc.byte_data && !( mc.word_data || mc.near_data || mc.far_data )) {
+		for( a = 0; a < f->op->args; a++ ) {
+			if( BOOL( f->arg[ a ].ea & ea_immediate ) && !f->address[ a ] && !BOOL( f->arg[ a ].immediate_arg.scope & scope_byte )) return;
+		}
+	}
+	w->form[ w->forms++ ] = *f;
+	if( w->forms == ROUND_TRIP_BATCH ) {
+		run_forms( w, 0, w->forms );
+		w->forms = 0;
+	}
+}
+
+/*
+ *	Generate the forms of an entry.
+ */
+static void generate_forms( rt_worker *w, opcode *op ) {
+	boolean		escape[ MAX_OPCODE_ARGS ];
+	ea_state	foreach_1,
+			foreach_2;
+	rt_form		f;
+
+	f.op = op;
+	classify_arguments( op, f.address, escape );
+	switch( op->args ) {
+		case 0: {
+			add_form( w, &f );
+			break;
+		}
+		case 1: {
+			if( init_ea_state( &foreach_1, op->arg[ 0 ])) {
+				while( next_ea_state( &foreach_1, &( f.arg[ 0 ]))) {
+					if( randomise_argument( w, &f, 0, escape[ 0 ])) add_form( w, &f );
+				}
+			}
+			break;
+		}
+		case 2: {
+			if( init_ea_state( &foreach_1, op->arg[ 0 ])) {
+				while( next_ea_state( &foreach_1, &( f.arg[ 0 ]))) {
+					if( !randomise_argument( w, &f, 0, escape[ 0 ])) continue;
+					if( init_ea_state( &foreach_2, op->arg[ 1 ])) {
+						while( next_ea_state( &foreach_2, &( f.arg[ 1 ]))) {
+							if( randomise_argument( w, &f, 1, escape[ 1 ])) add_form( w, &f );
+						}
+					}
+				}
+			}
+			break;
+		}
+		default: {
+			break;
+		}
+	}
+}
+
+/*
+ *	Take entries (for each round) until there are none left;
+ *	run on each thread in a context of its own.
+ */
+static void *round_trip_entries( void *data ) {
+	rt_worker		*w = (rt_worker *)data;
+	rt_state		*state = w->state;
+	assembler_context	*context,
+				*previous;
+	opcode			*op;
+	int			i;
+
+	context = new_context();
+	previous = select_context( context );
+	command_flags = state->flags;
+	assembler_parameters = state->parameters;
+	this_pass = data_verification;
+	set_error_stream( w->errors );
+	while(( i = atomic_fetch_add( &( state->next ), 1 )) < state->items ) {
+		op = &( opcodes[ i % state->entries ]);
+		if( !BOOL( op->flags & state->cpus )||( op->args > MAX_OPCODE_ARGS )) continue;
+		w->random = ( state->seed ^ ((dword)i * 0x9E3779B9 )) | 1;
+		w->item = i;
+		w->seq = 0;
+		generate_forms( w, op );
+		/*
+		 *	Keep the error stream from growing.
+		 */
+		fseek( w->errors, 0, SEEK_SET );
+	}
+	if( w->forms ) run_forms( w, 0, w->forms );
+	w->forms = 0;
+	delete_context( context );
+	(void)select_context( previous );
+	return( NIL( void ));
+}
+
+boolean verify_round_trip( int threads, int rounds, dword seed ) {
+	rt_state	state;
+	rt_worker	*worker;
+	pthread_t	*thread;
+	struct timespec	start,
+			end;
+	long		verified,
+			refused,
+			mismatched;
+	double		secs;
+	int		i, started;
+
+	if( threads < 1 ) threads = 1;
+	if( rounds < 1 ) rounds = 1;
+	/*
+	 *	Instructions first available on the target CPU
+	 *	and those before it.
+	 */
+	if( BOOL( command_flags & intel_80286 )) {
+		state.cpus = flag_086 | flag_186 | flag_286;
+	}
+	else if( BOOL( command_flags & intel_80186 )) {
+		state.cpus = flag_086 | flag_186;
+	}
+	else {
+		state.cpus = flag_086;
+	}
+	initialise_decoder( state.cpus );
+	segment_name[ REG_ES ] = reg_es;
+	segment_name[ REG_CS ] = reg_cs;
+	segment_name[ REG_SS ] = reg_ss;
+	segment_name[ REG_DS ] = reg_ds;
+
+	for( state.entries = 0; opcodes[ state.entries ].op != nothing; state.entries++ );
+	state.items = state.entries * rounds;
+	atomic_init( &( state.next ), 0 );
+	state.seed = seed;
+	state.flags = ( command_flags & cpu_selection_mask ) | allow_segment_access | allow_position_dependent;
+	state.parameters = ( assembler_parameters & ( flag_086 | flag_186 | flag_286 )) | flag_seg | flag_abs;
+	pthread_mutex_init( &( state.lock ), NULL );
+	state.report = NEW_ARRAY( rt_report, state.entries );
+	for( i = 0; i < state.entries; i++ ) {
+		state.report[ i ].item = -1;
+		state.report[ i ].text = NIL( char );
+		state.report[ i ].len = 0;
+	}
+
+	worker = NEW_ARRAY( rt_worker, threads );
+	for( i = 0; i < threads; i++ ) {
+		worker[ i ].state = &state;
+		worker[ i ].discard = NIL( char );
+		worker[ i ].discarded = 0;
+		worker[ i ].errors = open_memstream( &( worker[ i ].discard ), &( worker[ i ].discarded ));
+		worker[ i ].form = NEW_ARRAY( rt_form, ROUND_TRIP_BATCH );
+		worker[ i ].forms = 0;
+		worker[ i ].verified = 0;
+		worker[ i ].refused = 0;
+		worker[ i ].mismatched = 0;
+		if( worker[ i ].errors == NIL( FILE )) {
+			log_error( "Unable to create error buffer" );
+			return( FALSE );
+		}
+	}
+	/*
+	 *	The entries (for each round) are shared out between
+	 *	the threads as each becomes free.
+	 */
+	clock_gettime( CLOCK_MONOTONIC, &start );
+	thread = NEW_ARRAY( pthread_t, threads );
+	started = 0;
+	for( i = 1; i < threads; i++ ) {
+		if( pthread_create( &( thread[ i ]), NULL, round_trip_entries, &( worker[ i ])) != 0 ) break;
+		started++;
+	}
+	(void)round_trip_entries( &( worker[ 0 ]));
+	for( i = 1; i <= started; i++ ) (void)pthread_join( thread[ i ], NULL );
+	clock_gettime( CLOCK_MONOTONIC, &end );
+	FREE( thread );
+
+	verified = 0;
+	refused = 0;
+	mismatched = 0;
+	for( i = 0; i < threads; i++ ) {
+		verified += worker[ i ].verified;
+		refused += worker[ i ].refused;
+		mismatched += worker[ i ].mismatched;
+		fclose( worker[ i ].errors );
+		free( worker[ i ].discard );		/* From open_memstream() */
+		FREE( worker[ i ].form );
+	}
+	FREE( worker );
+	for( i = 0; i < state.entries; i++ ) {
+		if( state.report[ i ].text ) {
+			fwrite( state.report[ i ].text, 1, state.report[ i ].len, stdout );
+			free( state.report[ i ].text );		/* From open_memstream() */
+		}
+	}
+	FREE( state.report );
+	pthread_mutex_destroy( &( state.lock ));
+
+	secs = ( end.tv_sec - start.tv_sec ) + ( end.tv_nsec - start.tv_nsec ) / 1e9;
+	printf( "Round trip: %ld forms, %ld verified, %ld refused, %ld mismatched in %.3f seconds (%.0f forms/second)\n",
+		verified + refused + mismatched, verified, refused, mismatched, secs,
+		( secs > 0 )? ( verified + refused + mismatched ) / secs: 0.0 );
+	return(( refused == 0 )&&( mismatched == 0 ));
+}
+
+#endif
+
+/*
+ *	EOF
+ */
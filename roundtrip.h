@@ -0,0 +1,51 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	roundtrip
+ *	=========
+ *
+ *	Routines associated with the extended verification mode to
+ *	check that every form of every instruction survives being
+ *	assembled and then disassembled.
+ */
+
+#ifndef _ROUNDTRIP_H_
+#define _ROUNDTRIP_H_
+
+#ifdef VERIFICATION
+
+/*
+ *	Generate each form of each instruction (for the target CPU)
+ *	the given number of rounds, each round with fresh random
+ *	values seeded from the seed given.  The forms are assembled
+ *	as source text and the machine code decoded and compared
+ *	with the form, the work being shared between the number of
+ *	threads given.  Each failure is reported (reduced to a single
+ *	source line) once for each table entry.  Returns FALSE if
+ *	any form failed.
+ */
+extern boolean verify_round_trip( int threads, int rounds, dword seed );
+
+#endif
+
+#endif
+
+/*
+ *	EOF
+ */
@@ -26,15 +26,6 @@
 #include "os.h"
 #include "includes.h"
 
-/*
- *	Here are the lists of segment and groups.
- */
-segment_record *loose_segments = NIL( segment_record );
-segment_record **tail_loose_segments = &loose_segments;
-
-segment_group *all_groups = NIL( segment_group );
-segment_group **tail_all_groups = &all_groups;
-
 /*
  *	Define the routine which rationalises all the segments.
  *
@@ -69,6 +60,17 @@ boolean reset_segments( void ) {
 	return( TRUE );
 }
 
+/*
+ *	Forget all of the segments and groups.  The records themselves
+ *	are owned by (and released with) the identifiers naming them.
+ */
+void release_segments( void ) {
+	loose_segments = NIL( segment_record );
+	tail_loose_segments = &loose_segments;
+	all_groups = NIL( segment_group );
+	tail_all_groups = &all_groups;
+}
+
 /*
  *	Routines which are related to the definition and display of the
  *	set of flags which can be associated with a defined segment.
@@ -98,6 +98,7 @@ typedef struct _segment_record {
 	struct _segment_group	*group;
 	struct _segment_record	**link,
 				*next;
+	dword			number;		/* Its segment index */
 } segment_record;
 
 typedef struct _segment_group {
@@ -108,13 +109,20 @@ typedef struct _segment_group {
 } segment_group;
 
 /*
- *	Here are the lists of segment and groups.
+ *	Here are the lists of segment and groups, held in the
+ *	assembler context.
  */
-extern segment_record *loose_segments;
-extern segment_record **tail_loose_segments;
+typedef struct {
+	segment_record		*loose_segments,
+				**tail_loose_segments;
+	segment_group		*all_groups,
+				**tail_all_groups;
+} segments_context;
 
-extern segment_group *all_groups;
-extern segment_group **tail_all_groups;
+#define loose_segments		(this_context->segments.loose_segments)
+#define tail_loose_segments	(this_context->segments.tail_loose_segments)
+#define all_groups		(this_context->segments.all_groups)
+#define tail_all_groups		(this_context->segments.tail_all_groups)
 
 /*
  *	Define the routine which rationalises all the segments.
@@ -126,6 +134,11 @@ extern segment_group **tail_all_groups;
  */
 extern boolean reset_segments( void );
 
+/*
+ *	Forget all of the segments and groups.
+ */
+extern void release_segments( void );
+
 /*
  *	Convert a segment_access into a human readable buffer
  */
@@ -0,0 +1,430 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	server
+ *	======
+ *
+ *	A persistent assembler server, listening on a Unix domain
+ *	socket, and the matching client.
+ *
+ *	The server keeps every source file it has read memory mapped
+ *	between requests; a cached file is re-read only if its inode,
+ *	size or modification time have changed.  The tokens of the
+ *	files are kept too (see serve_request() in i8086.c), and all
+ *	output, bar the files written, is returned to the client.
+ *	The opcode, keyword and symbol tables are static and so are
+ *	always "warm".
+ *
+ *	Requests are handled one at a time (the server changes into
+ *	the client's working directory for each request, and back
+ *	again afterwards), though a request naming many files may
+ *	use worker threads.
+ *
+ *	The protocol is line based:
+ *
+ *	Client:	i8086 <version>
+ *		cwd <directory>
+ *		arg <argument>		(repeated)
+ *		end
+ *
+ *	Server:	text <length>		(only if there are diagnostics)
+ *		<length bytes of diagnostics>
+ *		status <exit status> <microseconds taken>
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	A file held in the cache.
+ */
+typedef struct _cached_file {
+	char			*name;
+	dev_t			device;
+	ino_t			inode;
+	off_t			size;
+	time_t			modified;
+	char			*text;
+	struct _cached_file	*next;
+} cached_file;
+
+/*
+ *	The cache of files, and the files replaced in the cache
+ *	which cannot be released until the current request is
+ *	complete.  The lock protects both as worker threads may
+ *	use the resolver at the same time.
+ */
+static cached_file	*file_cache = NIL( cached_file ),
+			*retired_files = NIL( cached_file );
+static pthread_mutex_t	file_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ *	The text returned for an empty file.
+ */
+static char empty_file[] = "";
+
+/*
+ *	Release the memory held by a cached file.
+ */
+static void release_file( cached_file *file ) {
+	if( file->size > 0 ) munmap( file->text, file->size );
+	FREE( file->name );
+	FREE( file );
+}
+
+/*
+ *	A source resolver which supplies files from the cache,
+ *	(re)mapping them as required.
+ */
+boolean server_resolver( char *name, void *data, char **text, int *len ) {
+	struct stat	st;
+	cached_file	**adrs,
+			*look;
+	int		fd;
+	void		*map;
+
+	(void)data;
+
+	if( stat( name, &st ) != 0 ) return( FALSE );
+	pthread_mutex_lock( &file_cache_lock );
+	for( adrs = &file_cache; ( look = *adrs ); adrs = &( look->next )) {
+		if(( look->device == st.st_dev )&&( look->inode == st.st_ino )) {
+			if(( look->size == st.st_size )&&( look->modified == st.st_mtime )) {
+				*text = look->text;
+				*len = look->size;
+				pthread_mutex_unlock( &file_cache_lock );
+				return( TRUE );
+			}
+			/*
+			 *	Changed, retire the old copy.
+			 */
+			*adrs = look->next;
+			look->next = retired_files;
+			retired_files = look;
+			break;
+		}
+	}
+	if(( fd = open( name, O_RDONLY )) < 0 ) {
+		pthread_mutex_unlock( &file_cache_lock );
+		return( FALSE );
+	}
+	if( fstat( fd, &st ) != 0 ) {
+		close( fd );
+		pthread_mutex_unlock( &file_cache_lock );
+		return( FALSE );
+	}
+	if( st.st_size > 0 ) {
+		if(( map = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 )) == MAP_FAILED ) {
+			close( fd );
+			pthread_mutex_unlock( &file_cache_lock );
+			return( FALSE );
+		}
+	}
+	else {
+		map = empty_file;
+	}
+	close( fd );
+	look = NEW( cached_file );
+	look->name = NEW_STRING( name );
+	look->device = st.st_dev;
+	look->inode = st.st_ino;
+	look->size = st.st_size;
+	look->modified = st.st_mtime;
+	look->text = (char *)map;
+	look->next = file_cache;
+	file_cache = look;
+	*text = look->text;
+	*len = look->size;
+	pthread_mutex_unlock( &file_cache_lock );
+	return( TRUE );
+}
+
+/*
+ *	Release the files retired from the cache.
+ */
+void release_retired_files( void ) {
+	cached_file	*look;
+
+	pthread_mutex_lock( &file_cache_lock );
+	while(( look = retired_files )) {
+		retired_files = look->next;
+		release_file( look );
+	}
+	pthread_mutex_unlock( &file_cache_lock );
+}
+
+/*
+ *	Return a monotonic time in microseconds.
+ */
+static long long microseconds( void ) {
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return(( (long long)now.tv_sec * 1000000 ) + ( now.tv_nsec / 1000 ));
+}
+
+/*
+ *	Read a line from a stream removing the trailing newline.
+ *	Returns FALSE at the end of the stream.
+ */
+static boolean read_line( FILE *from, char *buffer, int max ) {
+	int	l;
+
+	if( fgets( buffer, max, from ) == NIL( char )) return( FALSE );
+	if(( l = strlen( buffer )) && ( buffer[ l-1 ] == NL )) buffer[ l-1 ] = EOS;
+	return( TRUE );
+}
+
+/*
+ *	Return a copy of a file name which does not depend on the
+ *	current directory, or NIL if that cannot be found.
+ */
+char *absolute_path( char *name ) {
+	char	cwd[ PATH_MAX ],
+		*path;
+
+	if( *name == '/' ) return( NEW_STRING( name ));
+	if( getcwd( cwd, sizeof( cwd )) == NIL( char )) return( NIL( char ));
+	path = NEW_ARRAY( char, strlen( cwd )+strlen( name )+2 );
+	sprintf( path, "%s/%s", cwd, name );
+	return( path );
+}
+
+/*
+ *	Open a socket bound to the name supplied.
+ */
+static int open_socket( char *socket_name, struct sockaddr_un *addr ) {
+	int	fd;
+
+	if( strlen( socket_name ) >= sizeof( addr->sun_path )) {
+		log_error_s( "Socket name too long", socket_name );
+		return( ERROR );
+	}
+	memset( addr, 0, sizeof( struct sockaddr_un ));
+	addr->sun_family = AF_UNIX;
+	strcpy( addr->sun_path, socket_name );
+	if(( fd = socket( AF_UNIX, SOCK_STREAM, 0 )) < 0 ) {
+		log_error_s( "Unable to create socket", socket_name );
+		return( ERROR );
+	}
+	return( fd );
+}
+
+/*
+ *	Handle a single connection, returning FALSE if the server
+ *	has been asked to shut down.  The server returns to its
+ *	own directory (home) once the request is complete.
+ */
+static boolean serve_connection( int fd, int home, int count, server_request request ) {
+	char		line[ MAX_LINE_SIZE*4 ],
+			**args,
+			**argv,
+			*diagnostics;
+	size_t		size;
+	FILE		*from, *to, *errors;
+	int		argc, max, status;
+	long long	start, taken;
+	boolean		more;
+
+	if(( from = fdopen( fd, "r" )) == NIL( FILE )) {
+		close( fd );
+		return( TRUE );
+	}
+	if(( to = fdopen( dup( fd ), "w" )) == NIL( FILE )) {
+		fclose( from );
+		return( TRUE );
+	}
+	start = microseconds();
+	more = TRUE;
+	status = 1;
+	argc = 1;
+	max = MAX_ARG_COUNT;
+	args = NEW_ARRAY( char *, max+1 );
+	args[ 0 ] = "i8086";
+	diagnostics = NIL( char );
+	size = 0;
+	errors = open_memstream( &diagnostics, &size );
+	set_error_stream( errors );
+	/*
+	 *	Gather the request.
+	 */
+	if( !read_line( from, line, sizeof( line ))||( strcmp( line, "i8086 " PROGRAM_VERSION_NUMBER ) != 0 )) {
+		log_error( "Invalid request" );
+		argc = 0;
+	}
+	while( argc && read_line( from, line, sizeof( line ))&&( strcmp( line, "end" ) != 0 )) {
+		if( strncmp( line, "cwd ", 4 ) == 0 ) {
+			if( chdir( line+4 ) != 0 ) {
+				log_error_s( "Unable to change directory", line+4 );
+				argc = 0;
+			}
+		}
+		else if( strncmp( line, "arg ", 4 ) == 0 ) {
+			if( argc == max ) {
+				max *= 2;
+				args = RESIZE_ARRAY( args, char *, max+1 );
+			}
+			args[ argc++ ] = NEW_STRING( line+4 );
+		}
+	}
+	/*
+	 *	Run it.  The request is given a copy of the arguments
+	 *	as the options are removed from it as they are read,
+	 *	leaving the strings to be released from the original.
+	 */
+	if( argc ) {
+		args[ argc ] = NIL( char );
+		if(( argc == 2 )&&( strcmp( args[ 1 ], "--shutdown" ) == 0 )) {
+			more = FALSE;
+			status = 0;
+		}
+		else {
+			argv = NEW_ARRAY( char *, argc+1 );
+			memcpy( argv, args, ( argc+1 ) * sizeof( char * ));
+			status = FUNC( request )( argc, argv, errors );
+			FREE( argv );
+		}
+	}
+	while( argc > 1 ) FREE( args[ --argc ]);
+	FREE( args );
+	if( fchdir( home ) != 0 ) log_error( "Unable to return to server directory" );
+	release_retired_files();
+	set_error_stream( NIL( FILE ));
+	if( errors ) fclose( errors );
+	/*
+	 *	Reply.
+	 */
+	taken = microseconds() - start;
+	if( size ) {
+		fprintf( to, "text %ld\n", (long)size );
+		fwrite( diagnostics, 1, size, to );
+	}
+	fprintf( to, "status %d %lld\n", status, taken );
+	if( diagnostics ) free( diagnostics );	/* From open_memstream() */
+	fclose( to );
+	fclose( from );
+	printf( "Request %d: status %d, %.3f ms.\n", count, status, (double)taken / 1000.0 );
+	fflush( stdout );
+	return( more );
+}
+
+/*
+ *	Run the server.
+ */
+int run_server( char *socket_name, server_request request ) {
+	struct sockaddr_un	addr;
+	int			fd, home, conn, count;
+	cached_file		*look;
+
+	/*
+	 *	The socket is named independently of the directory
+	 *	of any request, so it can be removed at the end.
+	 */
+	if(( socket_name = absolute_path( socket_name )) == NIL( char )) {
+		log_error( "Unable to find current directory" );
+		return( 1 );
+	}
+	if(( home = open( ".", O_RDONLY )) < 0 ) {
+		log_error( "Unable to open current directory" );
+		FREE( socket_name );
+		return( 1 );
+	}
+	if(( fd = open_socket( socket_name, &addr )) == ERROR ) {
+		close( home );
+		FREE( socket_name );
+		return( 1 );
+	}
+	(void)unlink( socket_name );
+	if(( bind( fd, (struct sockaddr *)&addr, sizeof( addr )) != 0 )||( listen( fd, SOMAXCONN ) != 0 )) {
+		log_error_s( "Unable to listen on socket", socket_name );
+		close( fd );
+		close( home );
+		FREE( socket_name );
+		return( 1 );
+	}
+	signal( SIGPIPE, SIG_IGN );
+	printf( "Serving on %s.\n", socket_name );
+	fflush( stdout );
+	count = 0;
+	while(( conn = accept( fd, NULL, NULL )) >= 0 ) {
+		if( !serve_connection( conn, home, ++count, request )) break;
+	}
+	close( fd );
+	close( home );
+	(void)unlink( socket_name );
+	FREE( socket_name );
+	while(( look = file_cache )) {
+		file_cache = look->next;
+		release_file( look );
+	}
+	return( 0 );
+}
+
+/*
+ *	Send a request to the server.
+ */
+int run_client( char *socket_name, int argc, char *argv[] ) {
+	struct sockaddr_un	addr;
+	char			line[ MAX_LINE_SIZE ],
+				cwd[ PATH_MAX ];
+	FILE			*from, *to;
+	long			len;
+	long long		start, taken;
+	int			fd, i, status;
+
+	start = microseconds();
+	if(( fd = open_socket( socket_name, &addr )) == ERROR ) return( 1 );
+	if( connect( fd, (struct sockaddr *)&addr, sizeof( addr )) != 0 ) {
+		log_error_s( "Unable to connect to server", socket_name );
+		close( fd );
+		return( 1 );
+	}
+	if( getcwd( cwd, sizeof( cwd )) == NIL( char )) {
+		log_error( "Unable to find current directory" );
+		close( fd );
+		return( 1 );
+	}
+	from = fdopen( fd, "r" );
+	to = fdopen( dup( fd ), "w" );
+	fprintf( to, "i8086 " PROGRAM_VERSION_NUMBER "\ncwd %s\n", cwd );
+	for( i = 0; i < argc; i++ ) fprintf( to, "arg %s\n", argv[ i ]);
+	fprintf( to, "end\n" );
+	fclose( to );
+	status = 1;
+	taken = 0;
+	while( read_line( from, line, sizeof( line ))) {
+		if( sscanf( line, "text %ld", &len ) == 1 ) {
+			while( len-- > 0 ) {
+				if(( i = fgetc( from )) == EOF ) break;
+				fputc( i, stderr );
+			}
+		}
+		else if( sscanf( line, "status %d %lld", &status, &taken ) == 2 ) {
+			break;
+		}
+	}
+	fclose( from );
+	printf( "Request completed in %.3f ms (server %.3f ms).\n", (double)( microseconds() - start ) / 1000.0, (double)taken / 1000.0 );
+	return( status );
+}
+
+
+/*
+ *	EOF
+ */
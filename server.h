@@ -0,0 +1,76 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	server
+ *	======
+ *
+ *	A persistent assembler server, listening on a Unix domain
+ *	socket, and the matching client.
+ */
+ 
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+/*
+ *	The routine which runs a single request.  The arguments
+ *	are those of a command line (argv[ 0 ] is a place holder
+ *	and argv[ argc ] is NIL) and the routine returns the exit
+ *	status.  Errors are to be written to the stream supplied.
+ */
+typedef int FUNC( server_request )( int argc, char *argv[], FILE *errors );
+
+/*
+ *	Run the server on the socket named until a client asks
+ *	it to shut down.  Returns the exit status for the server.
+ */
+extern int run_server( char *socket_name, server_request request );
+
+/*
+ *	Return a (newly allocated) copy of a file name which does
+ *	not depend on the current directory, or NIL on failure.
+ */
+extern char *absolute_path( char *name );
+
+/*
+ *	Send a request (the arguments supplied) to the server on
+ *	the socket named, copy its diagnostics to stderr and return
+ *	its exit status.  An argument list of just "--shutdown"
+ *	stops the server.
+ */
+extern int run_client( char *socket_name, int argc, char *argv[] );
+
+/*
+ *	A source resolver (see source.h) which supplies files from
+ *	the server's cache of memory mapped files.
+ */
+extern boolean server_resolver( char *name, void *data, char **text, int *len );
+
+/*
+ *	Release the copies of changed files replaced in the cache
+ *	once nothing can be using them.
+ */
+extern void release_retired_files( void );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */
@@ -23,26 +23,86 @@
  *	Simplified, nesting, source line input mechanism.
  */
 
+#define MEMORY_TAG	memory_source
+
 #include "os.h"
 #include "includes.h"
 
 /*
- *	Provide a stream like system to access nested file
- *	includes.
- *
- *	Define data structures used to track this.
+ *	The source state is held in the assembler context
+ *	(see source.h).
+ */
+#define file_io			(this_context->source.file_io)
+#define nested_files		(this_context->source.nested_files)
+#define source_text		(this_context->source.source_text)
+#define source_name		(this_context->source.source_name)
+#define source_line		(this_context->source.source_line)
+#define resolver		(this_context->source.resolver)
+#define resolver_data		(this_context->source.resolver_data)
+#define dependencies		(this_context->source.dependencies)
+#define tail_dependencies	(this_context->source.tail_dependencies)
+
+/*
+ *	Record that the assembled output depends on the named
+ *	file.  Each file is recorded only once no matter how many
+ *	times (or passes) it is opened.
+ */
+void note_dependency( char *name ) {
+	dependency_record	*look;
+
+	ASSERT( name != NIL( char ));
+
+	for( look = dependencies; look; look = look->next ) if( strcmp( look->fname, name ) == 0 ) return;
+	look = NEW( dependency_record );
+	look->fname = save_string( name );
+	look->next = NIL( dependency_record );
+	*tail_dependencies = look;
+	tail_dependencies = &( look->next );
+}
+
+/*
+ *	Write out the names of all the files recorded, separated
+ *	by spaces, escaping those characters which are special
+ *	to make.
  */
-typedef struct {
-	char		*fname;
-	int		line;
-	FILE		*fd;
-} file_record;
+boolean write_dependencies( FILE *to ) {
+	dependency_record	*look;
+	char			*s;
+
+	ASSERT( to != NIL( FILE ));
+
+	for( look = dependencies; look; look = look->next ) {
+		fputc( SPACE, to );
+		for( s = look->fname; *s; s++ ) {
+			switch( *s ) {
+				case SPACE:
+				case '#': {
+					fputc( '\\', to );
+					break;
+				}
+				case '$': {
+					fputc( '$', to );
+					break;
+				}
+				default: {
+					break;
+				}
+			}
+			fputc( *s, to );
+		}
+	}
+	return( !ferror( to ));
+}
 
 /*
- *	The 'stack' of opened source files.
+ *	Call the routine supplied with the name of each file
+ *	recorded, in the order they were recorded.
  */
-static file_record file_io[ MAX_FILE_NESTING ];
-static int nested_files = 0;
+void visit_dependencies( void FUNC( visit )( char *name, void *data ), void *data ) {
+	dependency_record	*look;
+
+	for( look = dependencies; look; look = look->next ) FUNC( visit )( look->fname, data );
+}
 
 /*
  *	Declare a routine called to insert a new file into the stream.
@@ -57,16 +117,102 @@ boolean include_file( char *name ) {
 		return( FALSE );
 	}
 	fr = &( file_io[ nested_files ]);
-	if(( fr->fd = fopen( name, "r" )) == NIL( FILE )) {
+	if( resolver ) {
+		char	*text;
+		int	len;
+
+		if( !FUNC( resolver )( name, resolver_data, &text, &len )) {
+			log_error_s( "Unable to read file", name );
+			return( FALSE );
+		}
+		if(( fr->fd = fmemopen( text, len, "r" )) == NIL( FILE )) {
+			log_error_s( "Unable to read file from memory", name );
+			return( FALSE );
+		}
+	}
+	else if(( fr->fd = fopen( name, "r" )) == NIL( FILE )) {
 		log_error_s( "Unable to read file", name );
 		return( FALSE );
 	}
 	fr->fname = save_string( name );
 	fr->line = 0;
+	fr->reader = BOOL( command_flags & pipeline_stages )? start_reader( fr->fd ): NIL( source_reader );
 	nested_files++;
+	note_dependency( name );
 	return( TRUE );
 }
 
+/*
+ *	Close a file, stopping any thread reading it.
+ */
+static void close_source( file_record *fr ) {
+	if( fr->reader ) stop_reader( fr->reader );
+	fr->reader = NIL( source_reader );
+	fclose( fr->fd );
+}
+
+/*
+ *	Set (or clear with NIL) the routine used to find the text
+ *	of the files being assembled.
+ */
+void set_source_resolver( source_resolver func, void *data ) {
+	resolver = func;
+	resolver_data = data;
+}
+
+source_resolver get_source_resolver( void **data ) {
+	*data = resolver_data;
+	return( resolver );
+}
+
+/*
+ *	Return a copy of the whole text of a file.
+ */
+char *load_file( char *name, int *len ) {
+	char	*text,
+		*copy;
+	FILE	*fd;
+	long	size;
+
+	if( resolver ) {
+		if( !FUNC( resolver )( name, resolver_data, &text, len )) return( NIL( char ));
+		copy = NEW_ARRAY( char, *len+1 );
+		memcpy( copy, text, *len );
+		copy[ *len ] = EOS;
+		return( copy );
+	}
+	if(( fd = fopen( name, "r" )) == NIL( FILE )) return( NIL( char ));
+	if(( fseek( fd, 0, SEEK_END ) != 0 )||(( size = ftell( fd )) < 0 )||( fseek( fd, 0, SEEK_SET ) != 0 )) {
+		fclose( fd );
+		return( NIL( char ));
+	}
+	copy = NEW_ARRAY( char, size+1 );
+	*len = fread( copy, 1, size, fd );
+	copy[ *len ] = EOS;
+	fclose( fd );
+	return( copy );
+}
+
+/*
+ *	Close any files left open and forget all recorded
+ *	dependencies, returning the source system to its
+ *	initial state.
+ */
+void release_source( void ) {
+	dependency_record	*look;
+
+	while( nested_files ) close_source( &( file_io[ --nested_files ]));
+	while(( look = dependencies )) {
+		dependencies = look->next;
+		FREE( look );
+	}
+	tail_dependencies = &dependencies;
+	source_name = NIL( char );
+	source_line = 0;
+	resolver = (source_resolver)NULL;
+	resolver_data = NIL( void );
+}
+
 /*
  *	Pull off the next line for the input stream.
  */
@@ -75,12 +221,15 @@ boolean next_line( char *buffer, int len ) {
 		file_record	*fr;
 
 		fr = &( file_io[ nested_files-1 ]);
-		if(( fgets( buffer, len, fr->fd )) != NIL( char )) {
+		if( fr->reader? read_piped_line( fr->reader, buffer, len ): ( fgets( buffer, len, fr->fd ) != NIL( char ))) {
 			buffer[ len-1 ] = EOS;
 			fr->line += 1;
+			strcpy( source_text, buffer );
+			source_name = fr->fname;
+			source_line = fr->line;
 			return( TRUE );
 		}
-		fclose( fr->fd );
+		close_source( fr );
 		nested_files--;
 	}
 	return( FALSE );
@@ -94,12 +243,37 @@ boolean next_line( char *buffer, int len ) {
  */
 boolean skip_to_end( void ) {
 	if( nested_files ) {
-		fclose( file_io[ --nested_files ].fd );
+		close_source( &( file_io[ --nested_files ]));
 		return( TRUE );
 	}
 	return( FALSE );
 }
 
+/*
+ *	Return the text of the line most recently returned by
+ *	next_line() and (optionally) the file name and line number
+ *	it was read from.
+ */
+char *current_line( char **name, int *line ) {
+	if( name ) *name = source_name;
+	if( line ) *line = source_line;
+	return( source_text );
+}
+
+/*
+ *	Return the tokens (with labels unbound) of the line most
+ *	recently returned by next_line() if they were prepared by a
+ *	pipeline reader, otherwise NIL.
+ */
+token_record *current_tokens( void ) {
+	file_record	*fr;
+
+	if( nested_files == 0 ) return( NIL( token_record ));
+	fr = &( file_io[ nested_files-1 ]);
+	if( fr->reader == NIL( source_reader )) return( NIL( token_record ));
+	return( piped_tokens( fr->reader ));
+}
+
 /*
  *	Send a description of where we are to a FILE.
  *
@@ -109,6 +283,8 @@ boolean skip_to_end( void ) {
 void error_is_at( FILE *to ) {
 	int	i;
 
+	if( this_context == NIL( assembler_context )) return;
+
 	for( i = nested_files; i; i-- ) {
 		file_record	*fr;
 
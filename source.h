@@ -26,11 +26,102 @@
 #ifndef _SOURCE_H_
 #define _SOURCE_H_
 
+/*
+ *	A routine which, given the name of a file, supplies its
+ *	content from memory.  Returns FALSE if the file is unknown.
+ */
+typedef boolean FUNC( source_resolver )( char *name, void *data, char **text, int *len );
+
+/*
+ *	Provide a stream like system to access nested file
+ *	includes.
+ *
+ *	Define data structures used to track this.
+ */
+typedef struct {
+	char			*fname;
+	int			line;
+	FILE			*fd;
+	struct _source_reader	*reader;	/* See pipeline.h */
+} file_record;
+
+/*
+ *	Every file opened while assembling the source, in the order
+ *	they were first opened, for the dependency file.
+ */
+typedef struct _dependency_record {
+	char				*fname;
+	struct _dependency_record	*next;
+} dependency_record;
+
+/*
+ *	The source state held in the assembler context.
+ */
+typedef struct {
+	file_record		file_io[ MAX_FILE_NESTING ];	/* The 'stack' of opened source files */
+	int			nested_files;
+	/*
+	 *	A copy of the most recent line returned by next_line(),
+	 *	unmolested by the tokeniser, and where it came from.  This
+	 *	is used by the listing output.
+	 */
+	char			source_text[ MAX_LINE_SIZE+1 ];
+	char			*source_name;
+	int			source_line;
+	/*
+	 *	An optional routine which supplies the text of files from
+	 *	memory rather than having them read from the file system.
+	 */
+	source_resolver		resolver;
+	void			*resolver_data;
+	/*
+	 *	The files opened.
+	 */
+	dependency_record	*dependencies,
+				**tail_dependencies;
+} source_context;
+
 extern boolean include_file( char *name );
 extern boolean next_line( char *buffer, int len );
 extern boolean skip_to_end( void );
+extern char *current_line( char **name, int *line );
+extern struct _token_record *current_tokens( void );
 extern void error_is_at( FILE *to );
 
+/*
+ *	Record a file the output depends upon (every file opened
+ *	by include_file() is recorded automatically), and write the
+ *	recorded names out in make syntax or pass them to a
+ *	routine supplied.
+ */
+extern void note_dependency( char *name );
+extern boolean write_dependencies( FILE *to );
+extern void visit_dependencies( void FUNC( visit )( char *name, void *data ), void *data );
+
+/*
+ *	Route all file access through the resolver supplied (NIL
+ *	restores use of the file system).
+ */
+extern void set_source_resolver( source_resolver func, void *data );
+
+/*
+ *	Return the resolver in use (NIL if none), along with its
+ *	data, so that it can be given to another context.
+ */
+extern source_resolver get_source_resolver( void **data );
+
+/*
+ *	Return a copy (to be released with FREE) of the whole text
+ *	of a file as include_file() would read it, or NIL if it
+ *	cannot be read.
+ */
+extern char *load_file( char *name, int *len );
+
+/*
+ *	Return the source system to its initial state.
+ */
+extern void release_source( void );
+
 #endif
 
 /*
@@ -30,28 +30,19 @@
 #include "includes.h"
 
 /*
- *	The following variables are used to track the
- *	"state" of the assembly process as it passes through
- *	the source file multiple times.
- */
-segment_record		*this_segment = NIL( segment_record );
-
-/*
- *		Track number of times we jiggle labels etc. and also
- *		remember the previous value (for comparison purposes).
- */
-int			this_jiggle = 0,
-			prev_jiggle = 0;
-/*
- *	State variables used during the code generation phase.
- */
-segment_group		*codegen_group = NIL( segment_group );
-segment_record		*codegen_segment = NIL( segment_record );
-
-/*
- *	What phase of the assembler processing are we in.
+ *	The variables used to track the "state" of the assembly
+ *	process as it passes through the source file multiple
+ *	times are held in the assembler context (see state.h).
+ *
+ *	The jiggle counts track the number of times we jiggle
+ *	labels etc. and also remember the previous value (for
+ *	comparison purposes).
+ *
+ *	The expansion counts do the same for the short branches
+ *	rewritten to reach distant targets.  A pass which expands
+ *	more branches than the last is still settling, whatever
+ *	the label movements look like.
  */
-assembler_phase this_pass = no_pass;
 
 /*
  *	The "reset_state" call is made before each pass through the
@@ -103,6 +94,7 @@ boolean reset_state( void ) {
 			this_pass = pass_label_gathering;
 			prev_jiggle = 0;
 			this_jiggle = 0;
+			prev_expanded = 0;
 			break;
 		}
 		case pass_label_gathering: {
@@ -130,7 +122,8 @@ boolean reset_state( void ) {
 			 *
 			 *	If the jiggle count is not zero then we need
 			 *	to repeat Phase 2.  If, however, the jiggle
-			 *	count is the same as the previous cycle then
+			 *	count is the same as the previous cycle (and
+			 *	no further branches have been expanded) then
 			 *	we abort the assembler.
 			 *
 			 * 	If the Jiggle count is zero, we roll into
@@ -166,26 +159,27 @@ boolean reset_state( void ) {
 
 					ASSERT( codegen_segment != NIL( segment_record ));
 
-					if( BOOL( command_flags & be_verbose )) printf( "Codegen: Group %s, Segment %s\n", codegen_group->name, codegen_segment->name );
+					if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Codegen: Group %s, Segment %s\n", codegen_group->name, codegen_segment->name );
 				}
 				else {
 					codegen_segment = loose_segments;
 
 					ASSERT( codegen_segment != NIL( segment_record ));
 
-					if( BOOL( command_flags & be_verbose )) printf( "Codegen: Segment %s\n", codegen_segment->name );
+					if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Codegen: Segment %s\n", codegen_segment->name );
 				}
 				this_pass = pass_code_generation;
 				prev_jiggle = this_jiggle;
 				this_jiggle = 0;
 			}
 			else {
-				if( this_jiggle == prev_jiggle ) {
+				if(( this_jiggle == prev_jiggle )&&( this_expanded <= prev_expanded )) {
 					log_error( "Unstable Label values in source" );
 					return( FALSE );
 				}
 				prev_jiggle = this_jiggle;
 				this_jiggle = 0;
+				prev_expanded = this_expanded;
 			}
 			break;
 		}
@@ -208,10 +202,10 @@ boolean reset_state( void ) {
 			 */
 			if(( codegen_segment = codegen_segment->next )) {
 				if( codegen_group ) {
-					if( BOOL( command_flags & be_verbose )) printf( "Codegen: Group %s, Segment %s\n", codegen_group->name, codegen_segment->name );
+					if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Codegen: Group %s, Segment %s\n", codegen_group->name, codegen_segment->name );
 				}
 				else {
-					if( BOOL( command_flags & be_verbose )) printf( "Codegen: Segment %s\n", codegen_segment->name );
+					if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Codegen: Segment %s\n", codegen_segment->name );
 				}
 			}
 			else {
@@ -221,11 +215,11 @@ boolean reset_state( void ) {
 
 						ASSERT( codegen_segment != NIL( segment_record ));
 
-						if( BOOL( command_flags & be_verbose )) printf( "Codegen: Group %s, Segment %s\n", codegen_group->name, codegen_segment->name );
+						if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Codegen: Group %s, Segment %s\n", codegen_group->name, codegen_segment->name );
 					}
 					else {
 						if(( codegen_segment = loose_segments )) {
-							if( BOOL( command_flags & be_verbose )) printf( "Codegen: Segment %s\n", codegen_segment->name );
+							if( BOOL( command_flags & be_verbose )) fprintf( report_stream(), "Codegen: Segment %s\n", codegen_segment->name );
 						}
 						else {
 							/*
@@ -253,10 +247,26 @@ boolean reset_state( void ) {
 		}
 	}
 	this_jiggle = 0;
+	this_expanded = 0;
 
 	return( this_pass != no_pass );
 }
 
+/*
+ *	Return the state to that at the start of the program,
+ *	abandoning any assembly in progress.
+ */
+void release_state( void ) {
+	this_segment = NIL( segment_record );
+	this_jiggle = 0;
+	prev_jiggle = 0;
+	this_expanded = 0;
+	prev_expanded = 0;
+	codegen_group = NIL( segment_group );
+	codegen_segment = NIL( segment_record );
+	this_pass = no_pass;
+}
+
 
 /*
  *	EOF
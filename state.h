@@ -49,22 +49,34 @@ typedef enum {
 /*
  *	The following variables are used to track the
  *	"state" of the assembly process as it passes through
- *	the source file multiple times.
+ *	the source file multiple times.  They are held in the
+ *	assembler context.
  */
-extern segment_record		*this_segment;
-extern int			this_jiggle,		/* Track number of times we jiggle labels etc. */
-				prev_jiggle;		/* Jiggle count of previous pass */
+typedef struct {
+	segment_record		*this_segment;
+	int			this_jiggle,		/* Track number of times we jiggle labels etc. */
+				prev_jiggle,		/* Jiggle count of previous pass */
+				this_expanded,		/* Short branches expanded in this pass */
+				prev_expanded;		/* Expansions in the previous pass */
+	/*
+	 *	State variables used during the code generation phase.
+	 */
+	segment_group		*codegen_group;
+	segment_record		*codegen_segment;
+	/*
+	 *	What phase of the assembler processing are we in.
+	 */
+	assembler_phase		this_pass;
+} state_context;
 
-/*
- *	State variables used during the code generation phase.
- */
-extern segment_group		*codegen_group;
-extern segment_record		*codegen_segment;
-
-/*
- *	What phase of the assembler processing are we in.
- */
-extern assembler_phase		this_pass;
+#define this_segment		(this_context->state.this_segment)
+#define this_jiggle		(this_context->state.this_jiggle)
+#define prev_jiggle		(this_context->state.prev_jiggle)
+#define this_expanded		(this_context->state.this_expanded)
+#define prev_expanded		(this_context->state.prev_expanded)
+#define codegen_group		(this_context->state.codegen_group)
+#define codegen_segment		(this_context->state.codegen_segment)
+#define this_pass		(this_context->state.this_pass)
 
 /*
  *	The "reset_state" call is made before each pass through the
@@ -92,6 +104,12 @@ extern assembler_phase		this_pass;
 extern boolean reset_state( void );
 
 
+/*
+ *	Return the state to that at the start of the program,
+ *	abandoning any assembly in progress.
+ */
+extern void release_state( void );
+
 #endif
 
 /*
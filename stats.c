@@ -0,0 +1,211 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	stats
+ *	=====
+ *
+ *	Counters and timings gathered for each pass through the
+ *	source, reported by the "--stats" option.
+ *
+ *	The counters are simply incremented (through pass_stats)
+ *	wherever the work is done; this module collects them into
+ *	a record per pass.
+ */
+
+#define MEMORY_TAG	memory_reports
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The statistics are held in the assembler context.
+ */
+#define all_passes		(this_context->stats.passes)
+#define pass_count		(this_context->stats.count)
+#define pass_size		(this_context->stats.size)
+#define pass_started		(this_context->stats.started)
+
+/*
+ *	The reporting format.
+ */
+char *stats_format = NIL( char );
+
+/*
+ *	Return a monotonic time in microseconds.
+ */
+static long long stats_clock( void ) {
+	struct timespec	now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return(( (long long)now.tv_sec * 1000000 ) + ( now.tv_nsec / 1000 ));
+}
+
+/*
+ *	Return the name of a phase.
+ */
+static char *phase_name( assembler_phase phase ) {
+	switch( phase ) {
+		case pass_label_gathering:	return( "label_gathering" );
+		case pass_value_confirmation:	return( "value_confirmation" );
+		case pass_code_generation:	return( "code_generation" );
+		default:			break;
+	}
+	return( "none" );
+}
+
+/*
+ *	Write a string as a JSON string.
+ */
+static void json_string( FILE *to, char *s ) {
+	fputc( '"', to );
+	for( ; *s != EOS; s++ ) {
+		if(( *s == '"' )||( *s == '\\' )) {
+			fprintf( to, "\\%c", *s );
+		}
+		else if( (unsigned char)*s < ' ' ) {
+			fprintf( to, "\\u%04x", (unsigned char)*s );
+		}
+		else {
+			fputc( *s, to );
+		}
+	}
+	fputc( '"', to );
+}
+
+/*
+ *	Start a new pass.
+ */
+void start_pass_statistics( void ) {
+	memset( &pass_stats, 0, sizeof( pass_statistics ));
+	pass_stats.phase = this_pass;
+	pass_started = stats_clock();
+}
+
+/*
+ *	Finish the current pass, saving its figures.
+ */
+void end_pass_statistics( void ) {
+	pass_stats.usec = stats_clock() - pass_started;
+	pass_stats.jiggle = this_jiggle;
+	if( pass_count == pass_size ) {
+		pass_size = pass_size? pass_size * 2: MAX_ARG_COUNT;
+		all_passes = RESIZE_ARRAY( all_passes, pass_statistics, pass_size );
+	}
+	all_passes[ pass_count++ ] = pass_stats;
+}
+
+/*
+ *	Return the number of passes recorded.
+ */
+int total_passes( void ) {
+	return( pass_count );
+}
+
+/*
+ *	Write out the statistics.
+ */
+void write_statistics( FILE *to, char *name, boolean json ) {
+	pass_statistics	*p;
+	int		i, codegen;
+
+	codegen = 0;
+	for( i = 0; i < pass_count; i++ ) if( all_passes[ i ].phase == pass_code_generation ) codegen++;
+	/*
+	 *	Keep the output of concurrent assemblies apart.
+	 */
+	flockfile( to );
+	if( json ) {
+		fprintf( to, "{\"file\":" );
+		json_string( to, name );
+		fprintf( to, ",\"passes\":[" );
+		for( i = 0; i < pass_count; i++ ) {
+			p = &( all_passes[ i ]);
+			fprintf( to, "%s{\"pass\":%d,\"phase\":\"%s\",\"usec\":%lld,\"lines\":%ld,\"tokens\":%ld,"
+					"\"find_label\":%ld,\"find_opcode\":%ld,\"opcode_candidates\":%ld,"
+					"\"evaluate\":%ld,\"bytes\":%ld,\"saved\":%ld,\"expanded\":%ld,\"jiggle\":%d}",
+					( i? ",": "" ), i+1, phase_name( p->phase ), p->usec, p->lines, p->tokens,
+					p->labels, p->opcodes, p->candidates, p->evaluations, p->bytes, p->saved, p->expanded, p->jiggle );
+		}
+		fprintf( to, "],\"total_passes\":%d,\"segment_passes\":%d}\n", pass_count, ( codegen > 1 )? codegen-1: 0 );
+	}
+	else {
+		fprintf( to, "Statistics for %s:-\n", name );
+		fprintf( to, "%5s %-19s %10s %8s %8s %8s %8s %10s %8s %8s %6s\n",
+				"Pass", "Phase", "Time(ms)", "Lines", "Tokens", "Labels",
+				"Opcodes", "Scanned", "Evals", "Bytes", "Jiggle" );
+		for( i = 0; i < pass_count; i++ ) {
+			p = &( all_passes[ i ]);
+			fprintf( to, "%5d %-19s %10.3f %8ld %8ld %8ld %8ld %10ld %8ld %8ld %6d\n",
+					i+1, phase_name( p->phase ), (double)p->usec / 1000.0, p->lines, p->tokens,
+					p->labels, p->opcodes, p->candidates, p->evaluations, p->bytes, p->jiggle );
+		}
+		fprintf( to, "Total passes %d, of which %d code generation (%d for additional segments).\n",
+				pass_count, codegen, ( codegen > 1 )? codegen-1: 0 );
+	}
+	funlockfile( to );
+}
+
+/*
+ *	Write out the savings made in the code generation passes
+ *	(one for each group or loose segment).
+ */
+void write_size_savings( FILE *to, char *name ) {
+	long	shortened,
+		saved;
+	int	i;
+
+	shortened = saved = 0;
+	for( i = 0; i < pass_count; i++ ) {
+		if( all_passes[ i ].phase == pass_code_generation ) {
+			shortened += all_passes[ i ].shortened;
+			saved += all_passes[ i ].saved;
+		}
+	}
+	fprintf( to, "%s: %ld bytes saved by shorter forms of %ld instructions.\n", name, saved, shortened );
+}
+
+/*
+ *	Write out the branches expanded in the code generation
+ *	passes (each segment is generated by its own pass).
+ */
+void write_branch_expansions( FILE *to, char *name ) {
+	long	expanded;
+	int	i;
+
+	expanded = 0;
+	for( i = 0; i < pass_count; i++ ) {
+		if( all_passes[ i ].phase == pass_code_generation ) expanded += all_passes[ i ].expanded;
+	}
+	fprintf( to, "%s: %ld short branches expanded to reach their targets.\n", name, expanded );
+}
+
+/*
+ *	Forget all of the statistics.
+ */
+void release_statistics( void ) {
+	if( all_passes ) FREE( all_passes );
+	all_passes = NIL( pass_statistics );
+	pass_count = 0;
+	pass_size = 0;
+}
+
+
+/*
+ *	EOF
+ */
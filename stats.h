@@ -0,0 +1,110 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	stats
+ *	=====
+ *
+ *	Counters and timings gathered for each pass through the
+ *	source, reported by the "--stats" option.
+ */
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+/*
+ *	The figures gathered for a single pass.
+ */
+typedef struct {
+	assembler_phase		phase;
+	long long		usec;		/* Wall clock time taken */
+	long			lines,		/* Source lines processed */
+				tokens,		/* Tokens handed to the assembler */
+				labels,		/* find_label() lookups */
+				opcodes,	/* find_opcode() calls */
+				candidates,	/* Opcode table entries scanned */
+				evaluations,	/* evaluate() calls */
+				bytes,		/* Bytes of output generated */
+				shortened,	/* Instructions given a shorter form */
+				saved,		/* Bytes saved by the shorter forms */
+				expanded;	/* Short branches expanded to reach */
+	int			jiggle;		/* this_jiggle at the end of the pass */
+} pass_statistics;
+
+/*
+ *	The statistics held in the assembler context.
+ */
+typedef struct {
+	pass_statistics		current,
+				*passes;
+	int			count,
+				size;
+	long long		started;
+} stats_context;
+
+/*
+ *	The figures for the pass in progress.
+ */
+#define pass_stats		(this_context->stats.current)
+
+/*
+ *	How the statistics should be reported, "text" or "json"
+ *	(given as text by the command line).
+ */
+extern char *stats_format;
+
+/*
+ *	Mark the start and end of each pass.
+ */
+extern void start_pass_statistics( void );
+extern void end_pass_statistics( void );
+
+/*
+ *	Write out the statistics gathered for the named source
+ *	file, as JSON or as a table.
+ */
+extern void write_statistics( FILE *to, char *name, boolean json );
+
+/*
+ *	Write out the instructions shortened, and bytes saved, by
+ *	the "--optimize-size" option for the named source file.
+ */
+extern void write_size_savings( FILE *to, char *name );
+
+/*
+ *	Write out the number of short branches expanded by the
+ *	"--expand-branches" option for the named source file.
+ */
+extern void write_branch_expansions( FILE *to, char *name );
+
+/*
+ *	Return the number of passes recorded.
+ */
+extern int total_passes( void );
+
+/*
+ *	Forget all of the statistics gathered.
+ */
+extern void release_statistics( void );
+
+
+#endif
+
+/*
+ *	EOF
+ */
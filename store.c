@@ -24,23 +24,16 @@
  *	optimise overall memory utilisation.
  */
 
+#define MEMORY_TAG	memory_store
+
 #include "os.h"
 #include "includes.h"
 
 /*
- *	Memory management used to consolidate blocks
- *	to reduce storage (hopefully).
+ *	The head of the stored data is held in the
+ *	assembler context.
  */
-typedef struct _block_record {
-	byte			*blk;
-	int			len;
-	struct _block_record	*next;
-} block_record;
-
-/*
- *	The head of the stored adta.
- */
-static block_record *saved_blocks = NIL( block_record );
+#define saved_blocks		(this_context->store.saved_blocks)
 
 /*
  *	Add/Extract a block from the saved blocks.  Should probably
@@ -69,6 +62,20 @@ char *save_string( char *string ) {
 	return( (char *)save_block( (byte *)string, strlen( string )+1 ));
 }
 
+/*
+ *	Release all of the saved blocks.  Any pointers previously
+ *	returned become invalid.
+ */
+void release_store( void ) {
+	block_record	*look;
+
+	while(( look = saved_blocks )) {
+		saved_blocks = look->next;
+		FREE( look->blk );
+		FREE( look );
+	}
+}
+
 /*
  *	EOF
  */
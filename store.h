@@ -27,11 +27,30 @@
 #ifndef _STORE_H_
 #define _STORE_H_
 
+/*
+ *	Memory management used to consolidate blocks
+ *	to reduce storage (hopefully).
+ */
+typedef struct _block_record {
+	byte			*blk;
+	int			len;
+	struct _block_record	*next;
+} block_record;
+
+/*
+ *	The stored data held in the assembler context.
+ */
+typedef struct {
+	block_record		*saved_blocks;
+} store_context;
+
 
 extern byte *save_block( byte *block, int len );
 
 extern char *save_string( char *string );
 
+extern void release_store( void );
+
 #endif
 
 /*
@@ -0,0 +1,309 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	timing
+ *	======
+ *
+ *	Static estimation of instruction clocks.  The base figures
+ *	come from the opcode table with the following added here:
+ *
+ *	o	On the 8086/88 the effective address calculation,
+ *		which depends on the registers and displacement used
+ *		(the later CPUs include this in their figures, bar
+ *		the extra clock the 80286 takes for base, index and
+ *		displacement together).
+ *
+ *	o	Segment override and lock prefixes.
+ *
+ *	o	On the 8088 and 80188 four clocks for each word moved
+ *		over the byte wide bus.
+ *
+ *	o	Repeated string instructions, shifts and word multiply
+ *		and divide which the table does not capture directly.
+ *
+ *	o	The jumps added to branches expanded to reach distant
+ *		targets.
+ *
+ *	The same figures give the cost of the filler used to pad code
+ *	to an alignment and the clocks such an alignment gains.
+ *
+ *	Instruction fetch and the prefetch queue are not modelled.
+ */
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	Clocks taken on each of the timed CPUs by a repeat prefix,
+ *	by each bit of a shift or rotate and (added to the byte
+ *	figures in the table) by word multiply and divide.
+ */
+static const byte repeat_clocks[ TIMED_CPUS ] = { 9, 6, 5 };
+static const byte shift_clocks[ TIMED_CPUS ] = { 4, 1, 1 };
+static const byte wide_multiply_clocks[ TIMED_CPUS ] = { 56, 9, 8 };
+static const byte wide_divide_clocks[ TIMED_CPUS ] = { 72, 9, 8 };
+static const byte override_clocks[ TIMED_CPUS ] = { 2, 2, 0 };
+
+/*
+ *	Clocks taken by the direct (short or near) jumps added to
+ *	an expanded branch.
+ */
+static const byte jump_clocks[ TIMED_CPUS ] = { 15, 14, 7 };
+
+/*
+ *	Clocks taken by the filler instructions (nop and a register
+ *	to register mov) and those lost by each word transferred to
+ *	or from an odd address over a 16-bit bus.
+ */
+static const byte nop_clocks[ TIMED_CPUS ] = { 3, 3, 3 };
+static const byte move_clocks[ TIMED_CPUS ] = { 2, 2, 2 };
+static const byte odd_word_clocks[ TIMED_CPUS ] = { 4, 4, 2 };
+
+/*
+ *	Clocks taken by each word transfer over an 8-bit bus.
+ */
+#define BYTE_BUS_CLOCKS		4
+
+/*
+ *	Which of the timed CPUs is the target?
+ */
+static int timed_cpu( void ) {
+	if( BOOL( command_flags & intel_80286 )) return( TIMING_80286 );
+	if( BOOL( command_flags & intel_80186 )) return( TIMING_80186 );
+	return( TIMING_8086 );
+}
+
+/*
+ *	Is the argument a memory reference?
+ */
+static boolean in_memory( effective_address ea ) {
+	return( BOOL( ea & ( ea_mem_mod_adrs | ea_far_mod_reg_adrs )));
+}
+
+/*
+ *	The 8086 effective address calculation:
+ *
+ *		Displacement only			6
+ *		Base or index only			5
+ *		Base or index with displacement		9
+ *		BP+DI or BX+SI				7
+ *		BP+SI or BX+DI				8
+ *		Either pair with displacement		+4
+ *
+ *	As [BP] can only be encoded with a displacement it is
+ *	always costed with one.
+ */
+static int ea_clocks( ea_breakdown *arg ) {
+	boolean	disp;
+	int	c;
+
+	if( BOOL( arg->ea & ( ea_indirect | ea_far_indirect ))) return( 6 );
+	/*
+	 *	Only the displacement forms carry a value; it
+	 *	is otherwise left undefined.
+	 */
+	disp = BOOL( arg->ea & ( ea_base_disp | ea_index_disp | ea_base_index_disp |
+				ea_far_base_disp | ea_far_index_disp | ea_far_base_index_disp ))
+		&&( arg->immediate_arg.value != 0 );
+	if( arg->registers == 1 ) {
+		if( arg->reg[ 0 ]->reg_no == REG_BP ) disp = TRUE;
+		return( disp? 9: 5 );
+	}
+	c = ((( arg->reg[ 0 ]->reg_no == REG_BP )&&( arg->reg[ 1 ]->reg_no == REG_DI ))||
+		(( arg->reg[ 0 ]->reg_no == REG_BX )&&( arg->reg[ 1 ]->reg_no == REG_SI ))||
+		(( arg->reg[ 0 ]->reg_no == REG_DI )&&( arg->reg[ 1 ]->reg_no == REG_BP ))||
+		(( arg->reg[ 0 ]->reg_no == REG_SI )&&( arg->reg[ 1 ]->reg_no == REG_BX )))? 7: 8;
+	return( disp? c+4: c );
+}
+
+boolean estimate_clocks( opcode *inst, ea_breakdown *arg, instruction *mc, clock_estimate *est ) {
+	opcode_timing	*t;
+	ea_breakdown	*mem;
+	boolean		choice,
+			wide;
+	int		cpu,
+			transfers,
+			a;
+
+	ASSERT( inst != NIL( opcode ));
+	ASSERT( arg != NIL( ea_breakdown ));
+	ASSERT( mc != NIL( instruction ));
+	ASSERT( est != NIL( clock_estimate ));
+
+	t = &( inst->clocks );
+	cpu = timed_cpu();
+	/*
+	 *	Find any memory argument, and whether the form could
+	 *	have had one.
+	 */
+	mem = NIL( ea_breakdown );
+	choice = FALSE;
+	for( a = 0; a < inst->args; a++ ) {
+		if( in_memory( inst->arg[ a ])) choice = TRUE;
+		if( in_memory( arg[ a ].ea )) mem = &( arg[ a ]);
+	}
+	wide = mc->word_data || mc->far_data || BOOL( inst->mods & word_modifier );
+	est->alternative = ERROR;
+	est->per_count = FALSE;
+	if(( est->clocks = ( mem? t->mem[ cpu ]: t->reg[ cpu ])) == 0 ) return( FALSE );
+	/*
+	 *	Effective address and prefixes.
+	 */
+	if( mem ) {
+		if( cpu == TIMING_8086 ) {
+			est->clocks += ea_clocks( mem );
+		}
+		else if(( cpu == TIMING_80286 )&&( mem->registers == 2 )&&( mem->immediate_arg.value != 0 )) {
+			est->clocks += 1;
+		}
+	}
+	if( BOOL( mc->prefixes & segment_prefixes )) est->clocks += override_clocks[ cpu ];
+	if( BOOL( mc->prefixes & lock_prefix )) est->clocks += override_clocks[ cpu ];
+	/*
+	 *	Word transfers over a byte wide bus.
+	 */
+	transfers = 0;
+	if( BOOL( command_flags & eight_bit_bus )&&( cpu != TIMING_80286 )) {
+		transfers = t->fixed;
+		if( wide &&( mem || !choice )) transfers += t->operand;
+	}
+	/*
+	 *	Instructions whose timing depends on more than their
+	 *	form.
+	 */
+	switch( inst->op ) {
+		case op_movs:
+		case op_cmps:
+		case op_scas:
+		case op_lods:
+		case op_stos:
+		case op_ins:
+		case op_outs: {
+			if( BOOL( mc->prefixes & ( rep_prefix | rep_test_prefix ))) {
+				est->clocks = repeat_clocks[ cpu ];
+				est->alternative = t->mem[ cpu ] + transfers * BYTE_BUS_CLOCKS;
+				est->per_count = TRUE;
+				return( TRUE );
+			}
+			break;
+		}
+		case op_rcl:
+		case op_rcr:
+		case op_rol:
+		case op_ror:
+		case op_sal:
+		case op_shl:
+		case op_sar:
+		case op_shr: {
+			if( inst->args < 2 ) break;
+			if( inst->arg[ 1 ] == ea_immediate ) {
+				a = (int)arg[ 1 ].immediate_arg.value & 0xFF;
+				if( cpu != TIMING_8086 ) a &= 0x1F;
+				est->clocks += a * shift_clocks[ cpu ];
+				break;
+			}
+			est->alternative = shift_clocks[ cpu ];
+			est->per_count = TRUE;
+			break;
+		}
+		case op_mul:
+		case op_imul: {
+			if( wide ) est->clocks += wide_multiply_clocks[ cpu ];
+			break;
+		}
+		case op_div:
+		case op_idiv: {
+			if( wide ) est->clocks += wide_divide_clocks[ cpu ];
+			break;
+		}
+		case op_into:
+		case op_jcxz:
+		case op_loop:
+		case op_looppe:
+		case op_looppz:
+		case op_loopne:
+		case op_loopnz: {
+			est->alternative = t->mem[ cpu ];
+			break;
+		}
+		default: {
+			/*
+			 *	The conditional jumps lie together amongst
+			 *	the components (jcxz and jmp being handled
+			 *	elsewhere).
+			 */
+			if(( inst->op >= op_ja )&&( inst->op <= op_jz )&&( inst->op != op_jmp )) est->alternative = t->mem[ cpu ];
+			break;
+		}
+	}
+	/*
+	 *	An expanded conditional jump is taken by falling
+	 *	through its inverse onto the near jump, and not taken
+	 *	by taking the inverse.  The loop and jcxz family take
+	 *	a jump either way.
+	 */
+	if( mc->expanded &&( est->alternative != ERROR )) {
+		a = est->clocks;
+		if(( mc->code[ 0 ] & 0xF0 ) == 0x70 ) {
+			est->clocks = est->alternative + jump_clocks[ cpu ];
+			est->alternative = a;
+		}
+		else {
+			est->clocks += jump_clocks[ cpu ];
+			est->alternative += jump_clocks[ cpu ];
+		}
+	}
+	est->clocks += transfers * BYTE_BUS_CLOCKS;
+	return( TRUE );
+}
+
+int misaligned_clocks( void ) {
+	int	cpu;
+
+	cpu = timed_cpu();
+	if( BOOL( command_flags & eight_bit_bus )&&( cpu != TIMING_80286 )) return( 0 );
+	return( odd_word_clocks[ cpu ]);
+}
+
+int filler_clocks( int count, boolean *jump ) {
+	int	cpu,
+		c;
+
+	ASSERT( count >= 0 );
+	ASSERT( jump != NIL( boolean ));
+
+	cpu = timed_cpu();
+	c = ( count / 2 ) * move_clocks[ cpu ] + ( count % 2 ) * nop_clocks[ cpu ];
+	if(( *jump = (( count > 2 )&&( jump_clocks[ cpu ] < c )))) return( jump_clocks[ cpu ]);
+	return( c );
+}
+
+int format_clocks( clock_estimate *est, char *buffer, int max ) {
+
+	ASSERT( est != NIL( clock_estimate ));
+	ASSERT( buffer != NIL( char ));
+
+	if( est->alternative == ERROR ) return( snprintf( buffer, max, "%d", est->clocks ));
+	if( est->per_count ) return( snprintf( buffer, max, "%d+%dn", est->clocks, est->alternative ));
+	return( snprintf( buffer, max, "%d/%d", est->clocks, est->alternative ));
+}
+
+/*
+ *	EOF
+ */
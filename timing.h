@@ -0,0 +1,77 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	timing
+ *	======
+ *
+ *	Static estimation of the clocks an assembled instruction
+ *	takes on the target CPU, from the timings held with each
+ *	form in the opcode table and a model of the effective
+ *	address calculation and bus width.
+ */
+
+#ifndef _TIMING_H_
+#define _TIMING_H_
+
+/*
+ *	An estimate for a single instruction.  Conditional transfers
+ *	give the clocks when taken with the clocks when not taken as
+ *	the alternative.  Repeated string instructions and shifts by
+ *	CL give a fixed part with the alternative being the clocks
+ *	added for each repetition (or bit shifted).
+ */
+typedef struct {
+	int		clocks,
+			alternative;		/* ERROR if there is none */
+	boolean		per_count;		/* Alternative is per repetition */
+} clock_estimate;
+
+/*
+ *	Estimate the clocks taken by the instruction assembled from
+ *	the opcode table entry, prefixes and arguments given.  Returns
+ *	FALSE if the form has no timing for the target CPU.
+ */
+extern boolean estimate_clocks( opcode *inst, ea_breakdown *arg, instruction *mc, clock_estimate *est );
+
+/*
+ *	Write an estimate as text ("16", "16/4" or "9+17n") into the
+ *	buffer given (of at most max characters including the EOS)
+ *	returning the length of the text.
+ */
+extern int format_clocks( clock_estimate *est, char *buffer, int max );
+
+/*
+ *	Return the clocks lost on the target CPU by each word moved
+ *	to or from an odd address: none over a byte wide bus, where
+ *	every word takes two transfers wherever it lies.
+ */
+extern int misaligned_clocks( void );
+
+/*
+ *	Return the clocks taken to run through count bytes of filler,
+ *	setting jump if a short jump over the bytes is quicker than
+ *	filling them with 'mov ax,ax' (and a final 'nop').
+ */
+extern int filler_clocks( int count, boolean *jump );
+
+#endif
+
+/*
+ *	EOF
+ */
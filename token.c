@@ -23,6 +23,8 @@
  *	module relating to token capture and handling.
  */
 
+#define MEMORY_TAG	memory_tokens
+
 #include "os.h"
 #include "includes.h"
 
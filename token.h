@@ -43,6 +43,7 @@ typedef struct _token_record {
 	component		id;
 	union {
 		id_record		*label;
+		char			*name;		/* Unbound label, see tokenise.h */
 		constant_value		constant;
 		constant_block		block;
 	} var;
@@ -0,0 +1,739 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	tokenise
+ *	========
+ *
+ *	Conversion of source lines into token lists, either one
+ *	line at a time as the source is read, or for a whole file
+ *	in advance on a number of threads.
+ *
+ *	Apart from the binding of labels to identifier records
+ *	(which depends on the order labels are seen) each line is
+ *	tokenised independently of all the others.  So a file can be
+ *	split into chunks of lines, each tokenised on its own thread
+ *	with label names saved in an arena for the chunk.  As each
+ *	line is then read (on every pass) a copy of its token list
+ *	is made with the labels bound in source order.
+ *
+ *	Any file named by an INCLUDE line is tokenised in advance
+ *	by the thread which finds the line, as soon as it is found,
+ *	so the included files are read and tokenised alongside the
+ *	rest of the file including them.
+ *
+ *	The labels are still bound (through find_label()) each time
+ *	a line is read, on every pass, as the binding of local labels
+ *	depends upon the labels defined before them.
+ */
+
+#define MEMORY_TAG	memory_tokens
+
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The files tokenised in advance are held in the assembler
+ *	context.
+ */
+#define lexed_files		(this_context->tokenise.files)
+#define last_lexed		(this_context->tokenise.last)
+
+/*
+ *	Number of threads used to tokenise in advance.
+ */
+char *tokenise_threads = NIL( char );
+
+/*
+ *	Allocate space in an arena.
+ */
+static byte *arena_space( token_arena *arena, int len ) {
+	arena_block_record	*look;
+	byte			*ptr;
+
+	/*
+	 *	Keep everything aligned for the name records.
+	 */
+	len = ( len + sizeof( void * ) - 1 ) & ~( sizeof( void * ) - 1 );
+	if((( look = arena->blocks ) == NIL( arena_block_record ))||( look->used + len > look->size )) {
+		look = NEW( arena_block_record );
+		look->size = ( len > TOKENISE_ARENA_SIZE )? len: TOKENISE_ARENA_SIZE;
+		look->data = NEW_ARRAY( byte, look->size );
+		look->used = 0;
+		look->next = arena->blocks;
+		arena->blocks = look;
+	}
+	ptr = look->data + look->used;
+	look->used += len;
+	return( ptr );
+}
+
+/*
+ *	Save a label name in an arena.
+ */
+char *arena_name( token_arena *arena, char *name ) {
+	arena_name_record	*look;
+	unsigned int		hash;
+	char			*c;
+
+	hash = 0;
+	for( c = name; *c != EOS; c++ ) hash = ( hash * 31 ) + (unsigned char)*c;
+	hash %= TOKENISE_NAME_HASH;
+	for( look = arena->names[ hash ]; look; look = look->next ) {
+		if( strcmp( look->name, name ) == 0 ) return( look->name );
+	}
+	look = (arena_name_record *)arena_space( arena, sizeof( arena_name_record ));
+	look->name = (char *)arena_block( arena, (byte *)name, strlen( name )+1 );
+	look->next = arena->names[ hash ];
+	arena->names[ hash ] = look;
+	return( look->name );
+}
+
+/*
+ *	Save a block of data in an arena.
+ */
+byte *arena_block( token_arena *arena, byte *block, int len ) {
+	byte	*ptr;
+
+	ptr = arena_space( arena, len );
+	memcpy( ptr, block, len );
+	return( ptr );
+}
+
+/*
+ *	Release everything held in an arena.
+ */
+static void release_arena( token_arena *arena ) {
+	arena_block_record	*look;
+
+	while(( look = arena->blocks )) {
+		arena->blocks = look->next;
+		FREE( look->data );
+		FREE( look );
+	}
+}
+
+/*
+ *	Handle the source code on a "per line" basis.  Labels are
+ *	bound to their identifier records unless an arena is supplied
+ *	in which case their names (and any string constants) are
+ *	kept in the arena for binding later.
+ */
+boolean tokenise_line( char *ptr, token_record **tokens, token_arena *arena ) {
+	char		token[ MAX_TOKEN_SIZE+1 ];
+	int		l, t;
+	integer		value;
+	component	tok;
+	token_record	*head,
+			**tail,
+			*rec;
+	boolean		errors,
+			first;
+
+	/*
+	 *	We loop along the input line taking off tokens
+	 *	one by one.
+	 */
+	*tokens = NIL( token_record );
+	errors = FALSE;
+	head = NIL( token_record );
+	tail = &head;
+	first = TRUE;
+	while( *ptr != EOS ) {
+		/*
+		 *	Drop any leading space characters
+		 */
+		while( isspace( *ptr )) ptr++;
+		/*
+		 *	Now we step through the generic classes of token
+		 *	to find what we have to deal with.
+		 */
+		if(( l = string_constant( QUOTE, ptr, token, MAX_TOKEN_SIZE, &t, &errors ))) {
+			/*
+			 *	A character constant, error if not just a single character.
+			 *
+			 *	Remember l is the number of source characters used; t is
+			 *	the actual number of data bytes place in the token area.
+			 *
+			 *	errors will be TRUE if errors were detected in the parsed
+			 *	string value.
+			 */
+			if( errors ) return( FALSE );
+			if( t != 1 ) {
+				log_error( "Invalid character constant size" );
+				return( FALSE );
+			}
+			/*
+			 *	Create record.
+			 */
+			rec = NEW( token_record );
+			rec->id = tok_immediate;
+			rec->var.constant.value = token[ 0 ];
+			rec->var.constant.scope = scope_ubyte;
+			rec->var.constant.segment = NIL( segment_record );
+			rec->next = NIL( token_record );
+			*tail = rec;
+			tail = &( rec->next );
+			/*
+			 *	Skip character token representation
+			 */
+			ptr += l;
+			first = FALSE;
+		}
+		else if(( l = string_constant( QUOTES, ptr, token, MAX_TOKEN_SIZE, &t, &errors ))) {
+			/*
+			 *	A string constant.  The length of the string
+			 *	(once parsed) is in t, and will be shorter than
+			 *	the return value l.
+			 */
+			if( errors ) return( FALSE );
+			rec = NEW( token_record );
+			rec->id = tok_string;
+			rec->var.block.len = t;
+			rec->var.block.ptr = arena? arena_block( arena, (byte *)token, t ): save_block( (byte *)token, t );
+			rec->next = NIL( token_record );
+			*tail = rec;
+			tail = &( rec->next );
+			/*
+			 *	Skip string token representation
+			 */
+			ptr += l;
+			first = FALSE;
+		}
+		else if(( l = match_constant( ptr, &value, &errors ))) {
+			/*
+			 *	A numeric constant
+			 */
+			rec = NEW( token_record );
+			rec->id = tok_immediate;
+			rec->var.constant.value = value;
+			rec->var.constant.scope = get_scope( value );
+			rec->var.constant.segment = NIL( segment_record );
+			rec->next = NIL( token_record );
+			*tail = rec;
+			tail = &( rec->next );
+			/*
+			 *	Skip numeric token representation
+			 */
+			ptr += l;
+			first = FALSE;
+		}
+		else if(( l = match_identifier( ptr ))) {
+			/*
+			 *	An identifier but possibly a keyword
+			 */
+			t = find_best_keyword( ptr, &tok );
+			if( t == l ) {
+				/*
+				 *	Definitely a keyword of some sort.
+				 */
+				rec = NEW( token_record );
+				rec->id = tok;
+			}
+			else {
+				/*
+				 *	Just a label of some sort.
+				 */
+				if( l > MAX_TOKEN_SIZE ) {
+					strncpy( token, ptr, MAX_TOKEN_SIZE );
+					token[ MAX_TOKEN_SIZE ] = EOS;
+					log_error_s( "Identifier truncated to", token );
+					errors = TRUE;
+				}
+				else {
+					strncpy( token, ptr, l );
+					token[ l ] = EOS;
+				}
+				rec = NEW( token_record );
+				rec->id = tok_label;
+				if( arena ) {
+					rec->var.name = arena_name( arena, token );
+				}
+				else {
+					rec->var.label = find_label( token, first );
+				}
+			}
+			rec->next = NIL( token_record );
+			*tail = rec;
+			tail = &( rec->next );
+			/*
+			 *	Skip numeric token representation
+			 */
+			ptr += l;
+			first = FALSE;
+		}
+		else if(( l = find_best_symbol( ptr, &tok ))) {
+			/*
+			 *	Definitely a symbol
+			 */
+			if( tok == tok_semicolon ) {
+				/*
+				 *	This is the start of a comment,
+				 *	so we artifically truncate the
+				 *	line here to force the logic to
+				 *	unroll normally.
+				 */
+				*ptr = EOS;
+			}
+			else {
+				/*
+				 *	Save the symbol as a token
+				 */
+				rec = NEW( token_record );
+				rec->id = tok;
+				rec->next = NIL( token_record );
+				*tail = rec;
+				tail = &( rec->next );
+				/*
+				 *	Skip numeric token representation
+				 */
+				ptr += l;
+				first = FALSE;
+			}
+		}
+		else if( *ptr != EOS ) {
+			/*
+			 *	Unrecognised token in data stream.
+			 */
+			log_error_c( "Unrecognised symbol", *ptr++ );
+			errors = TRUE;
+			first = FALSE;
+		}
+	}
+	/*
+	 *	Explicitly mark end of line.
+	 */
+	rec = NEW( token_record );
+	rec->id = end_of_line;
+	rec->next = NIL( token_record );
+	*tail = rec;
+	/*
+	 *	Return tokens and error condition (TRUE if line content
+	 *	parsed all correct).
+	 */
+	*tokens = head;
+	return( !errors );
+}
+
+/*
+ *	The files tokenised in advance for a context, shared by the
+ *	threads tokenising them (and so locked), with the resolver
+ *	their text is read through.
+ */
+typedef struct {
+	pthread_mutex_t		lock;
+	lexed_file		**files;
+	source_resolver		resolver;
+	void			*resolver_data;
+} lexed_set;
+
+/*
+ *	The details of a chunk of lines tokenised on a thread.
+ */
+typedef struct {
+	lexed_set		*set;
+	lexed_file		*file;
+	int			first,
+				last;
+	token_arena		*arena;
+	command_flag		flags;
+	mnemonic_flags		parameters;
+} lexed_chunk;
+
+/*
+ *	Split the text of a file into the lines next_line() would
+ *	return, returning the number of lines.  The line array is
+ *	only filled in if supplied.
+ */
+static int split_lines( char *text, int len, lexed_line *line ) {
+	int	count, l;
+
+	count = 0;
+	while( len > 0 ) {
+		/*
+		 *	As fgets(), stop after a newline or when the
+		 *	buffer is full.
+		 */
+		l = 0;
+		while(( l < len )&&( l < MAX_LINE_SIZE-1 )) {
+			if( text[ l++ ] == NL ) break;
+		}
+		if( line ) {
+			line[ count ].text = text;
+			line[ count ].len = l;
+			line[ count ].ok = FALSE;
+			line[ count ].tokens = NIL( token_record );
+		}
+		count++;
+		text += l;
+		len -= l;
+	}
+	return( count );
+}
+
+/*
+ *	Find a file tokenised in advance.
+ */
+static lexed_file *find_lexed( char *name ) {
+	lexed_file	*look;
+
+	if( last_lexed &&( strcmp( last_lexed->name, name ) == 0 )) return( last_lexed );
+	for( look = lexed_files; look; look = look->next ) {
+		if( strcmp( look->name, name ) == 0 ) return( last_lexed = look );
+	}
+	return( NIL( lexed_file ));
+}
+
+/*
+ *	Start a new (empty) record for a file tokenised in advance
+ *	adding it to the list given.
+ */
+static lexed_file *new_lexed( lexed_file **list, char *name ) {
+	lexed_file	*file;
+
+	file = NEW( lexed_file );
+	file->name = NEW_STRING( name );
+	file->text = NIL( char );
+	file->size = 0;
+	file->lines = 0;
+	file->chunks = 0;
+	file->line = NIL( lexed_line );
+	file->arena = NIL( token_arena );
+	file->next = *list;
+	*list = file;
+	return( file );
+}
+
+/*
+ *	Read the text of a file and split it into lines, returning
+ *	FALSE if it cannot be read.  Such a file is left with no
+ *	lines; the error is reported when the file is included.
+ */
+static boolean load_lexed( lexed_file *file ) {
+	int	len;
+
+	if(( file->text = load_file( file->name, &len )) == NIL( char )) return( FALSE );
+	file->size = len;
+	file->lines = split_lines( file->text, len, NIL( lexed_line ));
+	file->line = NEW_ARRAY( lexed_line, file->lines );
+	(void)split_lines( file->text, len, file->line );
+	return( TRUE );
+}
+
+/*
+ *	Return the name of the file an INCLUDE line names (in the
+ *	buffer supplied) or NIL if the line is not an INCLUDE.
+ */
+static char *include_named( token_record *look, char *name, int max ) {
+	if( look == NIL( token_record )) return( NIL( char ));
+	if( look->id == tok_label ) look = look->next;
+	if( look->id == tok_colon ) look = look->next;
+	if( look->id != asm_include ) return( NIL( char ));
+	look = look->next;
+	if(( look->id != tok_string )||( look->next->id != end_of_line )||( look->var.block.len >= max )) return( NIL( char ));
+	memcpy( name, look->var.block.ptr, look->var.block.len );
+	name[ look->var.block.len ] = EOS;
+	return( name );
+}
+
+static void tokenise_lines( lexed_set *set, lexed_file *file, int first, int last, token_arena *arena );
+
+/*
+ *	Tokenise the file named by an INCLUDE line, unless it has
+ *	been (or is being) tokenised already, on the thread that
+ *	found the line.
+ */
+static void prefetch_include( lexed_set *set, token_record *tokens ) {
+	char		name[ MAX_LINE_SIZE+1 ];
+	lexed_file	*file;
+
+	if( include_named( tokens, name, MAX_LINE_SIZE+1 ) == NIL( char )) return;
+	pthread_mutex_lock( &( set->lock ));
+	for( file = *( set->files ); file; file = file->next ) {
+		if( strcmp( file->name, name ) == 0 ) {
+			pthread_mutex_unlock( &( set->lock ));
+			return;
+		}
+	}
+	file = new_lexed( set->files, name );
+	pthread_mutex_unlock( &( set->lock ));
+	/*
+	 *	Only this thread touches the record until all of
+	 *	the threads have finished.
+	 */
+	if( !load_lexed( file )) return;
+	file->chunks = 1;
+	file->arena = NEW( token_arena );
+	memset( file->arena, 0, sizeof( token_arena ));
+	tokenise_lines( set, file, 0, file->lines, file->arena );
+}
+
+/*
+ *	Tokenise lines of a file, tokenising any files included
+ *	as they are found.
+ */
+static void tokenise_lines( lexed_set *set, lexed_file *file, int first, int last, token_arena *arena ) {
+	char		buffer[ MAX_LINE_SIZE+1 ];
+	lexed_line	*line;
+	int		i;
+
+	for( i = first; i < last; i++ ) {
+		line = &( file->line[ i ]);
+		memcpy( buffer, line->text, line->len );
+		buffer[ line->len ] = EOS;
+		if( !( line->ok = tokenise_line( buffer, &( line->tokens ), arena ))) {
+			delete_tokens( line->tokens );
+			line->tokens = NIL( token_record );
+			continue;
+		}
+		prefetch_include( set, line->tokens );
+	}
+}
+
+/*
+ *	Tokenise a chunk of lines in a context of its own.  Any
+ *	errors are discarded as the lines will be tokenised again
+ *	when they are read.
+ */
+static void *tokenise_chunk( void *data ) {
+	lexed_chunk		*chunk = (lexed_chunk *)data;
+	assembler_context	*context,
+				*previous;
+	char			*discard;
+	size_t			size;
+	FILE			*errors;
+
+	context = new_context();
+	previous = select_context( context );
+	command_flags = chunk->flags;
+	assembler_parameters = chunk->parameters;
+	set_source_resolver( chunk->set->resolver, chunk->set->resolver_data );
+	discard = NIL( char );
+	size = 0;
+	if(( errors = open_memstream( &discard, &size ))) set_error_stream( errors );
+	tokenise_lines( chunk->set, chunk->file, chunk->first, chunk->last, chunk->arena );
+	delete_context( context );
+	(void)select_context( previous );
+	if( errors ) fclose( errors );
+	if( discard ) free( discard );	/* From open_memstream() */
+	return( NIL( void ));
+}
+
+/*
+ *	Tokenise a file (and the files it includes) in advance.
+ */
+static lexed_file *prepare_file( char *name ) {
+	lexed_set	set;
+	lexed_file	*file;
+	lexed_chunk	*chunk;
+	pthread_t	*thread;
+	int		threads, started, i;
+
+	file = new_lexed( &lexed_files, name );
+	if( !load_lexed( file )) return( file );
+	/*
+	 *	Decide how many chunks to split the file into.
+	 */
+	if(( threads = atoi( tokenise_threads )) < 1 ) threads = 1;
+	if( threads > file->lines / TOKENISE_CHUNK_LINES ) threads = file->lines / TOKENISE_CHUNK_LINES;
+	if( threads < 1 ) threads = 1;
+	file->chunks = threads;
+	file->arena = NEW_ARRAY( token_arena, threads );
+	memset( file->arena, 0, sizeof( token_arena ) * threads );
+	pthread_mutex_init( &( set.lock ), NULL );
+	set.files = &lexed_files;
+	set.resolver = get_source_resolver( &( set.resolver_data ));
+	chunk = NEW_ARRAY( lexed_chunk, threads );
+	for( i = 0; i < threads; i++ ) {
+		chunk[ i ].set = &set;
+		chunk[ i ].file = file;
+		chunk[ i ].first = ( file->lines * i ) / threads;
+		chunk[ i ].last = ( file->lines * ( i+1 )) / threads;
+		chunk[ i ].arena = &( file->arena[ i ]);
+		chunk[ i ].flags = command_flags;
+		chunk[ i ].parameters = assembler_parameters;
+	}
+	/*
+	 *	The first chunk is done on this thread, any chunk
+	 *	without a thread is done here too.
+	 */
+	thread = NEW_ARRAY( pthread_t, threads );
+	for( started = 1; started < threads; started++ ) {
+		if( pthread_create( &( thread[ started ]), NULL, tokenise_chunk, &( chunk[ started ])) != 0 ) break;
+	}
+	for( i = started; i < threads; i++ ) (void)tokenise_chunk( &( chunk[ i ]));
+	(void)tokenise_chunk( &( chunk[ 0 ]));
+	for( i = 1; i < started; i++ ) pthread_join( thread[ i ], NULL );
+	FREE( thread );
+	FREE( chunk );
+	pthread_mutex_destroy( &( set.lock ));
+	return( file );
+}
+
+/*
+ *	Copy a list of tokens binding the labels and saving the
+ *	string constants as tokenise_line() does.
+ */
+static token_record *bind_tokens( token_record *list ) {
+	token_record	*look,
+			*head,
+			**tail,
+			*rec;
+
+	head = NIL( token_record );
+	tail = &head;
+	for( look = list; look; look = look->next ) {
+		rec = NEW( token_record );
+		*rec = *look;
+		if( rec->id == tok_label ) {
+			rec->var.label = find_label( look->var.name, ( look == list ));
+		}
+		else if( rec->id == tok_string ) {
+			rec->var.block.ptr = save_block( look->var.block.ptr, look->var.block.len );
+		}
+		rec->next = NIL( token_record );
+		*tail = rec;
+		tail = &( rec->next );
+	}
+	return( head );
+}
+
+/*
+ *	Return the bound tokens of the current line.
+ */
+boolean prepared_line( char *buffer, token_record **tokens ) {
+	lexed_file	*file;
+	lexed_line	*line;
+	token_record	*look;
+	char		*name;
+	int		number;
+
+	if(( look = current_tokens())) {
+		*tokens = bind_tokens( look );
+		return( TRUE );
+	}
+	if( tokenise_threads == NIL( char )) return( FALSE );
+	(void)current_line( &name, &number );
+	if( name == NIL( char )) return( FALSE );
+	if(( file = find_lexed( name )) == NIL( lexed_file )) file = prepare_file( name );
+	if(( number < 1 )||( number > file->lines )) return( FALSE );
+	line = &( file->line[ number-1 ]);
+	/*
+	 *	The text read must be the text tokenised.
+	 */
+	if( !line->ok ||( strlen( buffer ) != (size_t)line->len )||( memcmp( buffer, line->text, line->len ) != 0 )) return( FALSE );
+	*tokens = bind_tokens( line->tokens );
+	return( TRUE );
+}
+
+/*
+ *	Release a single file tokenised in advance.
+ */
+static void release_lexed( lexed_file *look ) {
+	int	i;
+
+	for( i = 0; i < look->lines; i++ ) delete_tokens( look->line[ i ].tokens );
+	for( i = 0; i < look->chunks; i++ ) release_arena( &( look->arena[ i ]));
+	if( look->line ) FREE( look->line );
+	if( look->arena ) FREE( look->arena );
+	if( look->text ) FREE( look->text );
+	FREE( look->name );
+	FREE( look );
+}
+
+/*
+ *	Hand the files tokenised in advance from one context to
+ *	another.
+ */
+lexed_file *detach_tokenise( void ) {
+	lexed_file	*files;
+
+	files = lexed_files;
+	lexed_files = NIL( lexed_file );
+	last_lexed = NIL( lexed_file );
+	return( files );
+}
+
+void attach_tokenise( lexed_file *files ) {
+
+	ASSERT( lexed_files == NIL( lexed_file ));
+
+	lexed_files = files;
+	last_lexed = NIL( lexed_file );
+}
+
+/*
+ *	Drop the file named from a list of files tokenised in
+ *	advance, returning what is left of the list.
+ */
+lexed_file *drop_lexed( lexed_file *files, char *name ) {
+	lexed_file	**adrs,
+			*look;
+
+	for( adrs = &files; ( look = *adrs ); adrs = &( look->next )) {
+		if( strcmp( look->name, name ) == 0 ) {
+			*adrs = look->next;
+			release_lexed( look );
+			break;
+		}
+	}
+	return( files );
+}
+
+/*
+ *	Drop any file which has changed (or could not be read)
+ *	since it was tokenised.
+ */
+lexed_file *check_lexed( lexed_file *files ) {
+	lexed_file	**adrs,
+			*look;
+	char		*text;
+	int		len;
+
+	adrs = &files;
+	while(( look = *adrs )) {
+		text = ( look->text != NIL( char ))? load_file( look->name, &len ): NIL( char );
+		if(( text == NIL( char ))||( len != look->size )||( memcmp( text, look->text, len ) != 0 )) {
+			*adrs = look->next;
+			release_lexed( look );
+		}
+		else {
+			adrs = &( look->next );
+		}
+		if( text ) FREE( text );
+	}
+	return( files );
+}
+
+/*
+ *	Release all of the files tokenised in advance.
+ */
+void release_tokenise( void ) {
+	lexed_file	*look;
+
+	while(( look = lexed_files )) {
+		lexed_files = look->next;
+		release_lexed( look );
+	}
+	last_lexed = NIL( lexed_file );
+}
+
+
+/*
+ *	EOF
+ */
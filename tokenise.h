@@ -0,0 +1,148 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	tokenise
+ *	========
+ *
+ *	Conversion of source lines into token lists, either one
+ *	line at a time as the source is read, or for a whole file
+ *	in advance on a number of threads.
+ */
+
+#ifndef _TOKENISE_H_
+#define _TOKENISE_H_
+
+/*
+ *	An arena holding the names of unbound labels and the data
+ *	of string constants for the token lists of one chunk of a
+ *	file.  Names are held only once in each arena.
+ */
+typedef struct _arena_block {
+	byte			*data;
+	int			used,
+				size;
+	struct _arena_block	*next;
+} arena_block_record;
+
+typedef struct _arena_name {
+	char			*name;
+	struct _arena_name	*next;
+} arena_name_record;
+
+typedef struct {
+	arena_block_record	*blocks;
+	arena_name_record	*names[ TOKENISE_NAME_HASH ];
+} token_arena;
+
+/*
+ *	A line of a file tokenised in advance.  The tokens are only
+ *	kept for lines which were tokenised without error, all other
+ *	lines are tokenised again as they are read (so that any
+ *	errors are reported in the right place).
+ */
+typedef struct {
+	char			*text;
+	int			len;
+	boolean			ok;
+	token_record		*tokens;
+} lexed_line;
+
+/*
+ *	A file tokenised in advance.
+ */
+typedef struct _lexed_file {
+	char			*name,
+				*text;
+	int			size,
+				lines,
+				chunks;
+	lexed_line		*line;
+	token_arena		*arena;
+	struct _lexed_file	*next;
+} lexed_file;
+
+/*
+ *	The tokeniser state held in the assembler context.
+ */
+typedef struct {
+	lexed_file		*files,
+				*last;
+} tokenise_context;
+
+/*
+ *	The number of threads used to tokenise each file in advance
+ *	(given as text by the command line); NIL if files are to be
+ *	tokenised a line at a time.
+ */
+extern char *tokenise_threads;
+
+/*
+ *	Save a label name or a block of data in an arena, returning
+ *	the arena copy.
+ */
+extern char *arena_name( token_arena *arena, char *name );
+extern byte *arena_block( token_arena *arena, byte *block, int len );
+
+/*
+ *	Convert a line of source into a token list, returning FALSE
+ *	if errors were found (these are reported).  With an arena
+ *	labels are left unbound in the list (see above).
+ */
+extern boolean tokenise_line( char *ptr, token_record **tokens, token_arena *arena );
+
+/*
+ *	Return (with the labels bound) the tokens of the line most
+ *	recently returned by next_line(), either as prepared by the
+ *	pipeline reader or by tokenising the file it came from (and
+ *	any files it includes) in advance if necessary.
+ *	Returns FALSE if the line must be tokenised as it stands.
+ */
+extern boolean prepared_line( char *buffer, token_record **tokens );
+
+/*
+ *	Take the files tokenised in advance out of the current
+ *	context, and give them to another, so that they can be
+ *	used again without being tokenised again.
+ */
+extern lexed_file *detach_tokenise( void );
+extern void attach_tokenise( lexed_file *files );
+
+/*
+ *	Drop the file named (once changed) from a list of files
+ *	tokenised in advance, returning what is left of the list.
+ */
+extern lexed_file *drop_lexed( lexed_file *files, char *name );
+
+/*
+ *	Drop any file whose text (as read now) is not the text it
+ *	was tokenised from, returning what is left of the list.
+ */
+extern lexed_file *check_lexed( lexed_file *files );
+
+/*
+ *	Release all of the files tokenised in advance.
+ */
+extern void release_tokenise( void );
+
+
+#endif
+
+/*
+ *	EOF
+ */
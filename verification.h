@@ -42,6 +42,14 @@
  */
 /* #define VERIFICATION */
 
+/*
+ *	Define EXECUTION here (or on the GCC compiler
+ *	command line) to include the '--run' and '--execute'
+ *	options which run the '.COM' files produced in a
+ *	built in interpreter.
+ */
+/* #define EXECUTION */
+
 /*
  *	Some basic code assurance elements
  */
@@ -0,0 +1,242 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	watch
+ *	=====
+ *
+ *	Reassemble source files as they (or the files they
+ *	include) are changed.
+ *
+ *	Files are read through the memory mapped file cache of the
+ *	server (see server.c) so that only those files which have
+ *	changed are read again.  Each source file keeps the token
+ *	lists of the files it reached (see tokenise.c) from one
+ *	assembly to the next, so only the files which have changed
+ *	are tokenised again.  The labels are gathered afresh each
+ *	time, as an edit may remove or redefine any of them.
+ */
+ 
+#include "os.h"
+#include "includes.h"
+
+/*
+ *	The events which cause a watched file to be examined.
+ */
+#define WATCH_EVENTS	(IN_CLOSE_WRITE|IN_ATTRIB|IN_MOVE_SELF|IN_DELETE_SELF)
+
+/*
+ *	How long (in milliseconds) to wait for a burst of changes
+ *	to settle before reassembling.
+ */
+#define WATCH_SETTLE	20
+
+/*
+ *	A watched file.
+ */
+typedef struct _watched_file {
+	int			wd;
+	char			*name;
+	struct _watched_file	*next;
+} watched_file;
+
+/*
+ *	A source file being assembled, the files it reached on
+ *	its last assembly and their token lists.
+ */
+typedef struct {
+	char			*name;
+	char			**reached;
+	int			count,
+				size;
+	lexed_file		*lexed;
+	boolean			changed;
+} watched_source;
+
+/*
+ *	The state of the watch.
+ */
+typedef struct {
+	int			fd;
+	watched_file		*watching;
+	watched_source		*source;
+} watch_state;
+
+/*
+ *	Start (or confirm) the watch on a file, recording it as
+ *	reached by the source file.
+ */
+static void watch_file( char *name, void *data ) {
+	watch_state	*state = (watch_state *)data;
+	watched_source	*source = state->source;
+	watched_file	*look;
+	int		wd;
+
+	if( source->count == source->size ) {
+		source->size = source->size? source->size * 2: MAX_ARG_COUNT;
+		source->reached = RESIZE_ARRAY( source->reached, char *, source->size );
+	}
+	source->reached[ source->count++ ] = NEW_STRING( name );
+	if(( wd = inotify_add_watch( state->fd, name, WATCH_EVENTS )) < 0 ) {
+		log_error_s( "Unable to watch file", name );
+		return;
+	}
+	for( look = state->watching; look; look = look->next ) {
+		if( look->wd == wd ) {
+			if( strcmp( look->name, name ) != 0 ) {
+				FREE( look->name );
+				look->name = NEW_STRING( name );
+			}
+			return;
+		}
+	}
+	look = NEW( watched_file );
+	look->wd = wd;
+	look->name = NEW_STRING( name );
+	look->next = state->watching;
+	state->watching = look;
+}
+
+/*
+ *	Assemble a single source file in a new context, with the
+ *	token lists kept from the last time, then watch the files
+ *	it reached.
+ */
+static void reassemble( watch_state *state, watched_source *source, batch_assembler assemble ) {
+	assembler_context	*context,
+				*previous;
+	struct timespec		start,
+				end;
+	int			status;
+
+	while( source->count ) FREE( source->reached[ --source->count ]);
+	clock_gettime( CLOCK_MONOTONIC, &start );
+	context = new_context();
+	previous = select_context( context );
+	command_flags = previous->flags;
+	assembler_parameters = previous->parameters;
+	set_source_resolver( server_resolver, NIL( void ));
+	attach_tokenise( source->lexed );
+	status = FUNC( assemble )( source->name );
+	source->lexed = detach_tokenise();
+	clock_gettime( CLOCK_MONOTONIC, &end );
+	/*
+	 *	Watch the source file even if it could not be opened.
+	 */
+	state->source = source;
+	watch_file( source->name, state );
+	visit_dependencies( watch_file, state );
+	delete_context( context );
+	(void)select_context( previous );
+	release_retired_files();
+	source->changed = FALSE;
+	printf( "%s: %s in %.3f ms.\n", source->name, status? "failed": "updated",
+		(double)(( end.tv_sec - start.tv_sec ) * 1000000000LL + ( end.tv_nsec - start.tv_nsec )) / 1000000.0 );
+	fflush( stdout );
+}
+
+/*
+ *	Read the events waiting, marking the sources which reached
+ *	any of the files changed and dropping the token lists of
+ *	those files.  A file deleted or moved (as an editor saving
+ *	a file may well do) is no longer watched; the watch starts
+ *	again on the file found by that name once reassembled.
+ *	Returns FALSE if the events cannot be read.
+ */
+static boolean read_events( watch_state *state, watched_source *source, int files ) {
+	char			buffer[ 4096 ]
+				__attribute__(( aligned( __alignof__( struct inotify_event ))));
+	struct inotify_event	*event;
+	watched_file		**adrs,
+				*look;
+	ssize_t			len;
+	char			*at;
+	int			i, j;
+
+	if(( len = read( state->fd, buffer, sizeof( buffer ))) <= 0 ) return( FALSE );
+	for( at = buffer; at < buffer + len; at += sizeof( struct inotify_event ) + event->len ) {
+		event = (struct inotify_event *)at;
+		for( adrs = &( state->watching ); ( look = *adrs ); adrs = &( look->next )) if( look->wd == event->wd ) break;
+		if( look == NIL( watched_file )) continue;
+		for( i = 0; i < files; i++ ) {
+			for( j = 0; j < source[ i ].count; j++ ) {
+				if( strcmp( source[ i ].reached[ j ], look->name ) == 0 ) {
+					source[ i ].changed = TRUE;
+					source[ i ].lexed = drop_lexed( source[ i ].lexed, look->name );
+					break;
+				}
+			}
+		}
+		if( BOOL( event->mask & ( IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED ))) {
+			if( BOOL( event->mask & IN_MOVE_SELF )) (void)inotify_rm_watch( state->fd, look->wd );
+			*adrs = look->next;
+			FREE( look->name );
+			FREE( look );
+		}
+	}
+	return( TRUE );
+}
+
+/*
+ *	Assemble and watch.
+ */
+int watch_sources( int files, char *name[], batch_assembler assemble ) {
+	watch_state	state;
+	watched_source	*source;
+	struct pollfd	poller;
+	int		i;
+
+	if(( state.fd = inotify_init1( IN_CLOEXEC )) < 0 ) {
+		log_error( "Unable to watch files" );
+		return( 1 );
+	}
+	state.watching = NIL( watched_file );
+	/*
+	 *	Token lists are only kept for files tokenised in
+	 *	advance.
+	 */
+	if( tokenise_threads == NIL( char )) tokenise_threads = "1";
+	source = NEW_ARRAY( watched_source, files );
+	for( i = 0; i < files; i++ ) {
+		source[ i ].name = name[ i ];
+		source[ i ].reached = NIL( char * );
+		source[ i ].count = 0;
+		source[ i ].size = 0;
+		source[ i ].lexed = NIL( lexed_file );
+		reassemble( &state, &( source[ i ]), assemble );
+	}
+	poller.fd = state.fd;
+	poller.events = POLLIN;
+	while( read_events( &state, source, files )) {
+		/*
+		 *	Let a burst of changes (an editor saving a
+		 *	file, say) settle.
+		 */
+		while( poll( &poller, 1, WATCH_SETTLE ) > 0 ) {
+			if( !read_events( &state, source, files )) break;
+		}
+		for( i = 0; i < files; i++ ) if( source[ i ].changed ) reassemble( &state, &( source[ i ]), assemble );
+	}
+	log_error( "Unable to read file changes" );
+	return( 1 );
+}
+
+
+/*
+ *	EOF
+ */
@@ -0,0 +1,45 @@
+/**
+ **	"i8086" An assembler for the 16-bit Intel x86 CPUs
+ **
+ **	Copyright (C) 2024  Jeff Penfold (jeff.penfold@googlemail.com)
+ **
+ **	This program is free software: you can redistribute it and/or modify
+ **	it under the terms of the GNU General Public License as published by
+ **	the Free Software Foundation, either version 3 of the License, or
+ **	(at your option) any later version.
+ **
+ **	This program is distributed in the hope that it will be useful,
+ **	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **	GNU General Public License for more details.
+ **
+ **	You should have received a copy of the GNU General Public License
+ **	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ **/
+/*
+ *	watch
+ *	=====
+ *
+ *	Reassemble source files as they (or the files they
+ *	include) are changed.
+ */
+ 
+#ifndef _WATCH_H_
+#define _WATCH_H_
+
+/*
+ *	Assemble each of the source files, then watch every file
+ *	each one reached and reassemble those affected whenever
+ *	a file changes.  Each assembly is done in a fresh context
+ *	using the flags of the current context.  Only returns if
+ *	the files cannot be watched.
+ */
+extern int watch_sources( int files, char *name[], batch_assembler assemble );
+
+
+#endif
+
+
+/*
+ *	EOF
+ */